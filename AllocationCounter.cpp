@@ -0,0 +1,74 @@
+/**
+ * @file AllocationCounter.cpp
+ * @brief Заміна глобальних operator new / operator delete з підрахунком виділень.
+ */
+
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    /** @brief Чи йде вимір. */
+    std::atomic<bool> counting{false};
+
+    /** @brief Виділень від Start. */
+    std::atomic<uint64_t> allocations{0};
+
+    /** @brief Запитаних байтів від Start. */
+    std::atomic<uint64_t> allocatedBytes{0};
+}
+
+/**
+ * @brief Обнуляє лічильники перед увімкненням, щоб вимір не підхопив старі значення.
+ */
+void AllocationCounter::Start() {
+    allocations.store(0, std::memory_order_relaxed);
+    allocatedBytes.store(0, std::memory_order_relaxed);
+    counting.store(true, std::memory_order_release);
+}
+
+/**
+ * @brief Вимикає підрахунок і повертає накопичене.
+ */
+AllocationCounter::Totals AllocationCounter::Stop() {
+    counting.store(false, std::memory_order_release);
+    Totals totals;
+    totals.count = allocations.load(std::memory_order_relaxed);
+    totals.bytes = allocatedBytes.load(std::memory_order_relaxed);
+    return totals;
+}
+
+/**
+ * @brief malloc з обробником нестачі пам'яті, як у стандартного operator new.
+ *
+ * Масивні та nothrow-форми стандартної бібліотеки викликають саме цю функцію.
+ */
+void *operator new(std::size_t size) {
+    if (counting.load(std::memory_order_relaxed)) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    if (size == 0) size = 1;
+    while (true) {
+        if (void *memory = std::malloc(size)) return memory;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+/**
+ * @brief Пара до operator new.
+ */
+void operator delete(void *memory) noexcept {
+    std::free(memory);
+}
+
+/**
+ * @brief Пара до operator new (з розміром).
+ */
+void operator delete(void *memory, std::size_t) noexcept {
+    std::free(memory);
+}
@@ -0,0 +1,44 @@
+/**
+ * @file AllocationCounter.h
+ * @brief Оголошення лічильника виділень пам'яті для вимірів.
+ */
+
+#ifndef KURSOVA_ALLOCATIONCOUNTER_H
+#define KURSOVA_ALLOCATIONCOUNTER_H
+
+#include <cstdint>
+
+/**
+ * @namespace AllocationCounter
+ * @brief Рахує виклики operator new між Start і Stop (для KursovaBench).
+ *
+ * Глобальні operator new / operator delete замінено в AllocationCounter.cpp,
+ * який входить лише в KursovaBench: поза виміром вони коштують одного
+ * зчитування прапорця понад malloc/free.
+ * Рахуються виділення всіх потоків, тож вимір охоплює й паралельний запис.
+ */
+namespace AllocationCounter {
+
+    /**
+     * @brief Підсумок виміру.
+     */
+    struct Totals {
+        /** @brief Кількість викликів operator new. */
+        uint64_t count = 0;
+        /** @brief Сумарний запитаний розмір, байтів. */
+        uint64_t bytes = 0;
+    };
+
+    /**
+     * @brief Скидає лічильники і починає рахувати.
+     */
+    void Start();
+
+    /**
+     * @brief Припиняє рахувати.
+     * @return Виділення від останнього Start.
+     */
+    Totals Stop();
+}
+
+#endif //KURSOVA_ALLOCATIONCOUNTER_H
@@ -0,0 +1,484 @@
+/**
+ * @file AtomicFile.cpp
+ * @brief Реалізація атомарного запису файлу.
+ */
+
+#include "AtomicFile.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#ifdef __linux__
+#include <climits>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <vector>
+#endif
+
+/**
+ * @brief Поточний час у мілісекундах (монотонний годинник).
+ */
+static double NowMs() {
+    return std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// -------------------------------------------------------------
+//                     STATS
+// -------------------------------------------------------------
+
+/**
+ * @brief Байти, поділені на час запису.
+ */
+double AtomicFile::Stats::Throughput() const {
+    return writeMs > 0 ? static_cast<double>(bytes) / 1e6 / (writeMs / 1000.0) : 0;
+}
+
+/**
+ * @brief Формує рядок звіту.
+ */
+std::string AtomicFile::Stats::Describe() const {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(1)
+         << static_cast<double>(bytes) / 1e6 << " МБ за " << writeMs << " мс ("
+         << Throughput() << " МБ/с), fsync " << fileSyncMs << " мс, rename "
+         << renameMs << " мс";
+    if (files > 1) text << ", файлів " << files;
+    return text.str();
+}
+
+// -------------------------------------------------------------
+//                     CONSTRUCTOR / DESTRUCTOR
+// -------------------------------------------------------------
+
+#ifdef __linux__
+
+/**
+ * @brief Створює "<path>.tmp" з правами цільового файлу (або 0666 з урахуванням umask).
+ *
+ * Для IoBackend::Uring створюється кільце і kWriteDepth буферів; якщо
+ * кільце недоступне, лишається один буфер і синхронний pwrite.
+ */
+AtomicFile::AtomicFile(std::string path, IoBackend backend)
+        : path(std::move(path)), tempPath(this->path + ".tmp"), startMs(NowMs()) {
+    if (backend == IoBackend::Uring) {
+        auto candidate = std::make_unique<IoRing>(static_cast<unsigned>(kWriteDepth));
+        if (candidate->IsOpen()) ring = std::move(candidate);
+    }
+    buffers.resize(ring ? kWriteDepth : 1);
+    for (auto &b : buffers) b.data.reset(new char[kBufferSize]);
+
+    struct stat existing {};
+    bool hasTarget = ::stat(this->path.c_str(), &existing) == 0;
+
+    fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (fd < 0) {
+        Fail("open");
+        return;
+    }
+    if (hasTarget && ::fchmod(fd, existing.st_mode & 07777) != 0) Fail("fchmod");
+}
+
+#else
+
+/**
+ * @brief Створює "<path>.tmp" (io_uring на цій платформі немає).
+ */
+AtomicFile::AtomicFile(std::string path, IoBackend)
+        : path(std::move(path)), tempPath(this->path + ".tmp"), startMs(NowMs()) {
+    buffers.resize(1);
+    buffers[0].data.reset(new char[kBufferSize]);
+    file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) Fail("fopen");
+}
+
+#endif
+
+/**
+ * @brief Прибирає незавершений тимчасовий файл.
+ *
+ * Буфери не можна звільняти, поки ядро з них пише, тому спершу Drain().
+ */
+AtomicFile::~AtomicFile() {
+    Drain();
+    if (!committed) Discard();
+}
+
+/**
+ * @brief Фактичний спосіб запису.
+ */
+IoBackend AtomicFile::GetBackend() const {
+    return ring ? IoBackend::Uring : IoBackend::Posix;
+}
+
+// -------------------------------------------------------------
+//                     WRITE
+// -------------------------------------------------------------
+
+/**
+ * @brief Файл відкрито і помилок не було.
+ */
+bool AtomicFile::IsOpen() const {
+#ifdef __linux__
+    return fd >= 0 && error.empty();
+#else
+    return file && error.empty();
+#endif
+}
+
+/**
+ * @brief Копіює дані в буфер; великі шматки пише напряму.
+ */
+bool AtomicFile::Write(const char *data, size_t size) {
+    if (!IsOpen()) return false;
+    stats.bytes += size;
+
+    if (buffers[current].used + size > kBufferSize) {
+        if (!FlushBuffer()) return false;
+        if (size >= kBufferSize) return WriteRaw(data, size);
+    }
+    Buffer &b = buffers[current];
+    std::memcpy(b.data.get() + b.used, data, size);
+    b.used += size;
+    return true;
+}
+
+/**
+ * @brief Дописує рядок.
+ */
+bool AtomicFile::Write(const std::string &text) {
+    return Write(text.data(), text.size());
+}
+
+#ifdef __linux__
+
+/**
+ * @brief pwritev по IOV_MAX буферів; частковий запис продовжується з місця зупинки.
+ */
+bool AtomicFile::WriteBuffers(const std::string *buffers, size_t count) {
+    if (!IsOpen() || !FlushBuffer()) return false;
+
+    std::vector<iovec> vectors;
+    vectors.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (buffers[i].empty()) continue;
+        vectors.push_back({const_cast<char *>(buffers[i].data()), buffers[i].size()});
+        stats.bytes += buffers[i].size();
+    }
+
+    size_t first = 0;
+    while (first < vectors.size()) {
+        int batch = static_cast<int>(std::min<size_t>(vectors.size() - first, IOV_MAX));
+        ssize_t n = ::pwritev(fd, vectors.data() + first, batch, static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return Fail("pwritev");
+        }
+        offset += static_cast<uint64_t>(n);
+
+        // Пропускаємо повністю записані буфери, у частково записаному зсуваємо початок
+        auto left = static_cast<size_t>(n);
+        while (first < vectors.size() && left >= vectors[first].iov_len) {
+            left -= vectors[first].iov_len;
+            first++;
+        }
+        if (left > 0) {
+            vectors[first].iov_base = static_cast<char *>(vectors[first].iov_base) + left;
+            vectors[first].iov_len -= left;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Віддає заповнений буфер.
+ *
+ * POSIX: синхронний pwrite. io_uring: запис ставиться в кільце за поточним
+ * зміщенням, а заповнюватися далі буде наступний буфер; якщо він ще
+ * пишеться, чекаємо його завершення.
+ */
+bool AtomicFile::FlushBuffer() {
+    Buffer &b = buffers[current];
+    if (b.used == 0) return true;
+
+    if (!ring) {
+        bool ok = WriteRaw(b.data.get(), b.used);
+        b.used = 0;
+        return ok;
+    }
+
+    b.offset = offset;
+    b.pending = ring->Write(fd, b.data.get(), static_cast<uint32_t>(b.used), offset, current);
+    if (!b.pending || !ring->Submit()) {
+        b.pending = false;
+        errno = EIO;
+        return Fail("io_uring write");
+    }
+    offset += b.used;
+
+    current = (current + 1) % buffers.size();
+    while (buffers[current].pending) {
+        if (!Reap()) return false;
+    }
+    buffers[current].used = 0;
+    return IsOpen();
+}
+
+/**
+ * @brief pwrite у циклі: частковий запис і EINTR продовжуються.
+ */
+bool AtomicFile::WriteRaw(const char *data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return Fail("pwrite");
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+        offset += static_cast<uint64_t>(n);
+    }
+    return true;
+}
+
+/**
+ * @brief Забирає одне завершення запису.
+ *
+ * Неповний запис (рідкість для звичайних файлів) дописується синхронно
+ * за своїм зміщенням, щоб не змішувати його з наступними буферами.
+ */
+bool AtomicFile::Reap() {
+    uint64_t tag;
+    int32_t result;
+    if (!ring->WaitOne(tag, result)) return Fail("io_uring_enter");
+    if (tag >= buffers.size()) return true;
+
+    Buffer &b = buffers[tag];
+    b.pending = false;
+    if (result < 0) {
+        errno = -result;
+        return Fail("io_uring write");
+    }
+
+    auto done = static_cast<size_t>(result);
+    while (done < b.used) {
+        if (fd < 0) return false;
+        ssize_t n = ::pwrite(fd, b.data.get() + done, b.used - done, static_cast<off_t>(b.offset + done));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return Fail("pwrite");
+        }
+        done += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * @brief Чекає всі записи в польоті (навіть після помилки — буфери мають звільнитися).
+ */
+bool AtomicFile::Drain() {
+    auto pending = [this] {
+        return std::count_if(buffers.begin(), buffers.end(), [](const Buffer &b) { return b.pending; });
+    };
+    bool ok = true;
+    while (ring && pending() > 0) {
+        auto before = pending();
+        if (!Reap()) {
+            ok = false;
+            if (pending() == before) break;  // саме очікування не вдалося
+        }
+    }
+    return ok && error.empty();
+}
+
+#else
+
+/**
+ * @brief Записує буфери по одному.
+ */
+bool AtomicFile::WriteBuffers(const std::string *buffers, size_t count) {
+    if (!IsOpen() || !FlushBuffer()) return false;
+    for (size_t i = 0; i < count; ++i) {
+        stats.bytes += buffers[i].size();
+        if (!WriteRaw(buffers[i].data(), buffers[i].size())) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Записує накопичений буфер.
+ */
+bool AtomicFile::FlushBuffer() {
+    Buffer &b = buffers[current];
+    if (b.used == 0) return true;
+    bool ok = WriteRaw(b.data.get(), b.used);
+    b.used = 0;
+    return ok;
+}
+
+/**
+ * @brief fwrite усього шматка.
+ */
+bool AtomicFile::WriteRaw(const char *data, size_t size) {
+    if (std::fwrite(data, 1, size, file) != size) return Fail("fwrite");
+    return true;
+}
+
+/**
+ * @brief Асинхронних записів тут не буває.
+ */
+bool AtomicFile::Reap() {
+    return true;
+}
+
+/**
+ * @brief Асинхронних записів тут не буває.
+ */
+bool AtomicFile::Drain() {
+    return true;
+}
+
+#endif
+
+// -------------------------------------------------------------
+//                     COMMIT
+// -------------------------------------------------------------
+
+#ifdef __linux__
+
+/**
+ * @brief write -> fdatasync -> close -> rename -> fsync каталогу.
+ *
+ * Без fdatasync перед rename після збою можна отримати вже перейменований,
+ * але ще порожній файл. fsync каталогу фіксує сам rename. Записи io_uring
+ * мають завершитися до fdatasync, інакше він їх не покриває.
+ */
+bool AtomicFile::Commit() {
+    if (!IsOpen() || !FlushBuffer() || !Drain()) return false;
+    double written = NowMs();
+    stats.writeMs = written - startMs;
+
+    if (::fdatasync(fd) != 0) return Fail("fdatasync");
+    double synced = NowMs();
+    stats.fileSyncMs = synced - written;
+
+    int closing = fd;
+    fd = -1;
+    if (::close(closing) != 0) return Fail("close");
+    if (::rename(tempPath.c_str(), path.c_str()) != 0) return Fail("rename");
+    committed = true;
+
+    size_t slash = path.rfind('/');
+    std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+    int dirFd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0) return Fail("open dir");
+    bool ok = ::fsync(dirFd) == 0 || errno == EINVAL;  // деякі ФС не синхронізують каталоги
+    if (!ok) Fail("fsync dir");
+    ::close(dirFd);
+
+    stats.renameMs = NowMs() - synced;
+    return ok;
+}
+
+/**
+ * @brief Закриває дескриптор і видаляє тимчасовий файл.
+ */
+void AtomicFile::Discard() {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    ::unlink(tempPath.c_str());
+}
+
+/**
+ * @brief Запам'ятовує першу помилку разом з errno.
+ *
+ * Дескриптор закривається; записи io_uring, що ще в польоті, тримають
+ * власне посилання на файл і завершаться (Drain у деструкторі).
+ */
+bool AtomicFile::Fail(const char *operation) {
+    if (error.empty()) error = std::string(operation) + " " + tempPath + ": " + std::strerror(errno);
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    return false;
+}
+
+#else
+
+/**
+ * @brief fflush -> fclose -> rename (без гарантій fsync на цій платформі).
+ */
+bool AtomicFile::Commit() {
+    if (!IsOpen() || !FlushBuffer()) return false;
+    double written = NowMs();
+    stats.writeMs = written - startMs;
+
+    std::FILE *closing = file;
+    file = nullptr;
+    if (std::fclose(closing) != 0) return Fail("fclose");
+    std::remove(path.c_str());
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) return Fail("rename");
+    committed = true;
+    stats.renameMs = NowMs() - written;
+    return true;
+}
+
+/**
+ * @brief Закриває і видаляє тимчасовий файл.
+ */
+void AtomicFile::Discard() {
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+    std::remove(tempPath.c_str());
+}
+
+/**
+ * @brief Запам'ятовує першу помилку разом з errno.
+ */
+bool AtomicFile::Fail(const char *operation) {
+    if (error.empty()) error = std::string(operation) + " " + tempPath + ": " + std::strerror(errno);
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+    return false;
+}
+
+#endif
+
+/**
+ * @brief Опис першої помилки.
+ */
+const std::string &AtomicFile::Error() const {
+    return error;
+}
+
+/**
+ * @brief Виміри останнього Commit().
+ */
+const AtomicFile::Stats &AtomicFile::GetStats() const {
+    return stats;
+}
+
+/**
+ * @brief Відкриває, записує і фіксує файл за один виклик.
+ */
+bool AtomicFile::WriteAll(const std::string &path, const std::string &data, std::string &error) {
+    AtomicFile file(path);
+    if (!file.Write(data) || !file.Commit()) {
+        error = file.Error();
+        return false;
+    }
+    return true;
+}
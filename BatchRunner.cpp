@@ -0,0 +1,208 @@
+/**
+ * @file BatchRunner.cpp
+ * @brief Реалізація пакетного режиму.
+ */
+
+#include "BatchRunner.h"
+#include "Term.h"
+#include "PrimitiveTerm.h"
+#include "RoleManager.h"
+#include "Utils.h"
+
+#include <iostream>
+
+// -------------------------------------------------------------
+//                     CONSTRUCTOR
+// -------------------------------------------------------------
+
+/**
+ * @brief Конструктор.
+ * @param termManager Завантажена база термінів.
+ * @param userManager Менеджер користувачів.
+ */
+BatchRunner::BatchRunner(TermManager &termManager, UserManager &userManager)
+        : termManager(termManager), userManager(userManager), queries(termManager) {}
+
+// -------------------------------------------------------------
+//                     HELPERS
+// -------------------------------------------------------------
+
+/**
+ * @brief Перевіряє права за токеном сесії.
+ * @param required Потрібні права.
+ * @return true, якщо сесія дійсна і має всі права.
+ */
+bool BatchRunner::Allowed(uint32_t required) const {
+    if (token.empty()) return false;
+    Session session;
+    if (!userManager.ValidateSession(token, session)) return false;
+    return (session.permissions & required) == required;
+}
+
+/**
+ * @brief Зберігає базу, якщо після попереднього збереження були зміни.
+ *
+ * Які зміни ще не у файлі, відстежує TermManager (див. TermManager::Flush).
+ */
+bool BatchRunner::Checkpoint() {
+    return termManager.Flush();
+}
+
+/**
+ * @brief Відкриває сесію до виконання скрипта.
+ */
+bool BatchRunner::Login(const std::string &login, const std::string &password) {
+    token = userManager.OpenSession(login, password);
+    return !token.empty();
+}
+
+// -------------------------------------------------------------
+//                     RUN
+// -------------------------------------------------------------
+
+/**
+ * @brief Виконує скрипт рядок за рядком і зберігає зміни наприкінці.
+ *
+ * Невдале збереження наприкінці має номер рядка 0: воно не належить жодній команді.
+ * @param in Скрипт.
+ * @param out Потік результатів.
+ * @return Кількість помилок.
+ */
+size_t BatchRunner::Run(std::istream &in, std::ostream &out) {
+    std::string line;
+    size_t lineNo = 0;
+    while (std::getline(in, line)) {
+        lineNo++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        Execute(lineNo, Utils::Split(line, ';'), out);
+    }
+
+    if (!Checkpoint()) {
+        buffer.clear();
+        QueryHandler::AppendError(buffer, 0, "checkpoint", "save_failed");
+        out << buffer;
+        failures++;
+    }
+    if (!token.empty()) userManager.CloseSession(token);
+    out.flush();
+    return failures;
+}
+
+// -------------------------------------------------------------
+//                     COMMANDS
+// -------------------------------------------------------------
+
+/**
+ * @brief Виконує одну команду і пише її результат.
+ *
+ * Відповідь збирається у буфер і виводиться одним записом.
+ * @param lineNo Номер рядка.
+ * @param fields Поля команди (з екрануванням, як у файлі).
+ * @param out Потік результатів.
+ */
+void BatchRunner::Execute(size_t lineNo, const std::vector<std::string> &fields, std::ostream &out) {
+    buffer.clear();
+    if (!Dispatch(lineNo, fields)) failures++;
+    out << buffer;
+}
+
+/**
+ * @brief Розбирає команду, перевіряє права і виконує її.
+ *
+ * Запити на читання делегуються QueryHandler, зміни виконуються тут.
+ * @param lineNo Номер рядка.
+ * @param fields Поля команди.
+ * @return false, якщо відповідь — ERR.
+ */
+bool BatchRunner::Dispatch(size_t lineNo, const std::vector<std::string> &fields) {
+    const std::string command = Utils::Trim(fields[0]);
+
+    auto arg = [&](size_t i) {
+        return i < fields.size() ? Utils::Trim(Utils::Unescape(fields[i])) : std::string();
+    };
+    auto ok = [&](const std::string &value) {
+        QueryHandler::AppendHead(buffer, lineNo, "OK", command);
+        if (!value.empty()) QueryHandler::AppendField(buffer, value);
+        buffer.push_back('\n');
+        return true;
+    };
+    auto fail = [&](const char *code) {
+        QueryHandler::AppendError(buffer, lineNo, command, code);
+        return false;
+    };
+
+    // Кожна команда оголошує потрібне право
+    bool query = QueryHandler::IsQuery(command);
+    uint32_t required = 0;
+    if (query || command == "export") required = PermViewTerms;
+    else if (command == "add") required = PermAddTerm;
+    else if (command == "edit") required = PermEditTerm;
+    else if (command == "remove") required = PermRemoveTerm;
+    else if (command != "login" && command != "checkpoint") return fail("unknown_command");
+
+    if (required != 0 && !Allowed(required)) return fail("forbidden");
+
+    if (query) {
+        return queries.Execute(lineNo, fields, buffer);
+    }
+
+    if (command == "login") {
+        if (fields.size() < 3) return fail("bad_arguments");
+        if (!token.empty()) userManager.CloseSession(token);
+        if (!Login(arg(1), Utils::Unescape(fields[2]))) return fail("auth_failed");
+        return ok(arg(1));
+    }
+
+    if (command == "checkpoint") {
+        if (!Checkpoint()) return fail("save_failed");
+        return ok("");
+    }
+
+    if (command == "add") {
+        std::string type = arg(1);
+        std::string name = arg(2);
+        std::string definition = arg(3);
+        if (name.empty() || definition.empty()) return fail("bad_arguments");
+        if (termManager.FindByName(name)) return fail("exists");
+
+        if (type == "PRIM") {
+            termManager.AddTerm(std::make_shared<PrimitiveTerm>(name, definition));
+        } else if (type == "TERM") {
+            std::vector<std::string> refs;
+            if (fields.size() > 4) {
+                for (auto &r : Utils::Split(fields[4], ',')) {
+                    auto trimmed = Utils::Trim(Utils::Unescape(r));
+                    if (!trimmed.empty()) refs.push_back(trimmed);
+                }
+            }
+            termManager.AddTerm(std::make_shared<Term>(name, definition, refs));
+        } else {
+            return fail("bad_type");
+        }
+        return ok(name);
+    }
+
+    if (command == "edit") {
+        std::string name = arg(1);
+        std::string definition = arg(2);
+        if (name.empty() || definition.empty()) return fail("bad_arguments");
+        if (!termManager.EditDefinition(name, definition)) return fail("not_found");
+        return ok(name);
+    }
+
+    if (command == "remove") {
+        std::string name = arg(1);
+        // Перевіряємо заздалегідь, щоб RemoveTerm не друкував повідомлення в консоль
+        if (termManager.IsReferenced(name)) return fail("referenced");
+        if (!termManager.RemoveTerm(name)) return fail("not_found");
+        return ok(name);
+    }
+
+    // export
+    std::string path = arg(1);
+    if (path.empty()) return fail("bad_arguments");
+    if (!termManager.Export(path)) return fail("io_error");
+    return ok(path);
+}
@@ -0,0 +1,124 @@
+/**
+ * @file BatchRunner.h
+ * @brief Оголошення пакетного (неінтерактивного) режиму.
+ */
+
+#ifndef KURSOVA_BATCHRUNNER_H
+#define KURSOVA_BATCHRUNNER_H
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "TermManager.h"
+#include "UserManager.h"
+#include "QueryHandler.h"
+
+/**
+ * @class BatchRunner
+ * @brief Виконує команди зі скрипта над однією завантаженою базою.
+ *
+ * Формат скрипта — одна команда на рядок, поля через ';' (з тим самим
+ * екрануванням, що й у terms.csv). Порожні рядки та рядки з '#' пропускаються:
+ *
+ *     login;логін;пароль
+ *     find;Назва
+ *     complete;префікс[;кількість]
+ *     suggest;назва[;кількість]
+ *     search;фрагмент
+ *     query;запит
+ *     add;PRIM;Назва;Визначення
+ *     add;TERM;Назва;Визначення;Посилання1,Посилання2
+ *     edit;Назва;Нове визначення
+ *     remove;Назва
+ *     chain;Назва
+ *     stats
+ *     export;шлях
+ *     checkpoint
+ *
+ * Вхід виконується через сесію (UserManager::OpenSession), далі права
+ * перевіряються лише за токеном. Зміни не зберігаються після кожної команди:
+ * файл перезаписується на checkpoint і один раз наприкінці. Якщо запис не
+ * вдався, checkpoint відповідає ERR save_failed, а невдале збереження
+ * наприкінці виводиться як "0 ERR checkpoint save_failed" і рахується
+ * помилкою, тож скрипт не завершується успішно зі втраченими змінами.
+ *
+ * Результати мають формат QueryHandler, де номер запиту — номер рядка скрипта.
+ */
+class BatchRunner {
+private:
+    TermManager &termManager;
+    UserManager &userManager;
+
+    /**
+     * @brief Виконавець запитів на читання.
+     */
+    QueryHandler queries;
+
+    /**
+     * @brief Буфер відповіді на поточну команду (перевикористовується).
+     */
+    std::string buffer;
+
+    /**
+     * @brief Токен поточної сесії (порожній — вхід не виконано).
+     */
+    std::string token;
+
+    /**
+     * @brief Кількість команд, що завершились помилкою.
+     */
+    size_t failures = 0;
+
+    /**
+     * @brief Перевіряє права поточної сесії.
+     * @param required Потрібні права.
+     */
+    bool Allowed(uint32_t required) const;
+
+    /**
+     * @brief Виконує одну команду.
+     * @param lineNo Номер рядка скрипта.
+     * @param fields Поля команди (як у скрипті, з екрануванням).
+     * @param out Потік результатів.
+     */
+    void Execute(size_t lineNo, const std::vector<std::string> &fields, std::ostream &out);
+
+    /**
+     * @brief Виконує команду і дописує відповідь у buffer.
+     * @return false, якщо відповідь — ERR.
+     */
+    bool Dispatch(size_t lineNo, const std::vector<std::string> &fields);
+
+    /**
+     * @brief Зберігає базу, якщо є зміни.
+     * @return false, якщо зміни не вдалося записати.
+     */
+    bool Checkpoint();
+
+public:
+    /**
+     * @brief Конструктор.
+     * @param termManager Завантажена база термінів.
+     * @param userManager Менеджер користувачів (для входу).
+     */
+    BatchRunner(TermManager &termManager, UserManager &userManager);
+
+    /**
+     * @brief Відкриває сесію до початку скрипта (наприклад, з облікових даних у змінних середовища).
+     * @return true, якщо вхід успішний.
+     */
+    bool Login(const std::string &login, const std::string &password);
+
+    /**
+     * @brief Виконує всі команди з потоку.
+     * @param in Скрипт.
+     * @param out Потік результатів.
+     * @return Кількість команд з помилкою плюс невдале збереження наприкінці (0 — все виконано).
+     */
+    size_t Run(std::istream &in, std::ostream &out);
+};
+
+#endif //KURSOVA_BATCHRUNNER_H
@@ -0,0 +1,212 @@
+/**
+ * @file BkTree.cpp
+ * @brief Реалізація BK-дерева для нечіткого пошуку назв.
+ */
+
+#include "BkTree.h"
+#include "Utils.h"
+
+#include <algorithm>
+
+/**
+ * @brief Вузол дерева: слово і нащадки, відсортовані за відстанню.
+ */
+struct BkTree::Node {
+    std::string word;
+    std::u32string codePoints;
+    std::vector<std::pair<uint32_t, std::shared_ptr<Node>>> children;
+};
+
+// -------------------------------------------------------------
+//                     DISTANCE
+// -------------------------------------------------------------
+
+/**
+ * @brief Слово з бітовими масками позицій кожного символу (для алгоритму Маєрса).
+ */
+struct BkTree::Pattern {
+    std::u32string text;
+    /** @brief Символ -> біти позицій, де він стоїть у text (лише для text.size() <= 64). */
+    std::vector<std::pair<char32_t, uint64_t>> masks;
+
+    /**
+     * @brief Будує маски для слова.
+     */
+    explicit Pattern(std::u32string word) : text(std::move(word)) {
+        if (text.size() > 64) return;
+        for (size_t i = 0; i < text.size(); ++i) {
+            auto it = std::find_if(masks.begin(), masks.end(),
+                                   [&](const auto &m) { return m.first == text[i]; });
+            if (it == masks.end()) it = masks.insert(masks.end(), {text[i], 0});
+            it->second |= uint64_t{1} << i;
+        }
+    }
+
+    /**
+     * @brief Маска позицій символу c.
+     */
+    uint64_t Mask(char32_t c) const {
+        for (const auto &m : masks) {
+            if (m.first == c) return m.second;
+        }
+        return 0;
+    }
+};
+
+/**
+ * @brief Відстань Левенштейна (вставка, видалення, заміна — вартість 1).
+ *
+ * Рахується двома рядками таблиці, O(|a|·|b|) часу і O(|b|) пам'яті.
+ * Назви короткі, тож для них це дешевше за будь-яку складнішу схему.
+ */
+uint32_t BkTree::Distance(const std::u32string &a, const std::u32string &b) {
+    std::vector<uint32_t> row(b.size() + 1);
+    for (size_t j = 0; j <= b.size(); ++j) row[j] = static_cast<uint32_t>(j);
+
+    for (size_t i = 1; i <= a.size(); ++i) {
+        uint32_t diagonal = row[0];
+        row[0] = static_cast<uint32_t>(i);
+        for (size_t j = 1; j <= b.size(); ++j) {
+            uint32_t above = row[j];
+            uint32_t substitution = diagonal + (a[i - 1] == b[j - 1] ? 0 : 1);
+            row[j] = std::min({above + 1, row[j - 1] + 1, substitution});
+            diagonal = above;
+        }
+    }
+    return row[b.size()];
+}
+
+/**
+ * @brief Відстань Левенштейна алгоритмом Маєрса (варіант Хюрьо).
+ *
+ * Стовпчик таблиці відстаней кодується різницями сусідніх клітинок у двох
+ * 64-бітних словах, тож символ тексту обробляється кількома бітовими
+ * операціями замість проходу по всьому стовпчику. Довші слова рахуються
+ * звичайною таблицею.
+ */
+uint32_t BkTree::Distance(const Pattern &pattern, const std::u32string &text) {
+    size_t m = pattern.text.size();
+    if (m == 0) return static_cast<uint32_t>(text.size());
+    if (m > 64) return Distance(pattern.text, text);
+
+    uint64_t positive = ~uint64_t{0};
+    uint64_t negative = 0;
+    uint64_t last = uint64_t{1} << (m - 1);
+    auto score = static_cast<uint32_t>(m);
+
+    for (char32_t c : text) {
+        uint64_t equal = pattern.Mask(c);
+        uint64_t xv = equal | negative;
+        uint64_t xh = (((equal & positive) + positive) ^ positive) | equal;
+        uint64_t ph = negative | ~(xh | positive);
+        uint64_t mh = positive & xh;
+
+        if (ph & last) score++;
+        else if (mh & last) score--;
+
+        // Перший рядок таблиці — 0, 1, 2, ...: зсув вносить +1 (глобальна відстань)
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        positive = mh | ~(xv | ph);
+        negative = ph & xv;
+    }
+    return score;
+}
+
+// -------------------------------------------------------------
+//                     WRITE ACCESS
+// -------------------------------------------------------------
+
+/**
+ * @brief Повертає вузол для зміни.
+ *
+ * Вузол, спільний з іншою копією дерева (use_count > 1), спершу копіюється;
+ * нащадки копії залишаються спільними.
+ */
+BkTree::Node &BkTree::MutableNode(std::shared_ptr<Node> &node) {
+    if (node.use_count() > 1) {
+        node = std::make_shared<Node>(*node);
+    }
+    return *node;
+}
+
+/**
+ * @brief Спускається від кореня за відстанями до вільного ключа і додає лист.
+ * @param word Рядок UTF-8.
+ * @return false, якщо слово вже є в дереві.
+ */
+bool BkTree::Insert(const std::string &word) {
+    Pattern pattern(Utils::DecodeUTF8(word));
+    auto leaf = [&] {
+        auto node = std::make_shared<Node>();
+        node->word = word;
+        node->codePoints = pattern.text;
+        return node;
+    };
+
+    if (!root) {
+        root = leaf();
+        count = 1;
+        return true;
+    }
+
+    std::shared_ptr<Node> *slot = &root;
+    while (true) {
+        uint32_t distance = Distance(pattern, (*slot)->codePoints);
+        if (distance == 0) return false;
+
+        auto &children = MutableNode(*slot).children;
+        auto it = std::lower_bound(children.begin(), children.end(), distance,
+                                   [](const auto &child, uint32_t key) { return child.first < key; });
+        if (it == children.end() || it->first != distance) {
+            children.emplace(it, distance, leaf());
+            count++;
+            return true;
+        }
+        slot = &it->second;
+    }
+}
+
+// -------------------------------------------------------------
+//                     READ ACCESS
+// -------------------------------------------------------------
+
+/**
+ * @brief Обхід з відсіканням за нерівністю трикутника.
+ * @param word Запит (UTF-8).
+ * @param maxDistance Радіус.
+ * @param visited Кількість обчислених відстаней (для діагностики).
+ * @return Слова на відстані не більше maxDistance.
+ */
+std::vector<BkTree::Match> BkTree::Search(const std::string &word, uint32_t maxDistance, size_t *visited) const {
+    std::vector<Match> out;
+    if (visited) *visited = 0;
+    if (!root) return out;
+
+    Pattern pattern(Utils::DecodeUTF8(word));
+    std::vector<const Node *> stack{root.get()};
+    while (!stack.empty()) {
+        const Node *node = stack.back();
+        stack.pop_back();
+
+        uint32_t distance = Distance(pattern, node->codePoints);
+        if (visited) (*visited)++;
+        if (distance <= maxDistance) out.push_back({node->word, distance});
+
+        uint32_t low = distance > maxDistance ? distance - maxDistance : 0;
+        uint32_t high = distance + maxDistance;
+        auto it = std::lower_bound(node->children.begin(), node->children.end(), low,
+                                   [](const auto &child, uint32_t key) { return child.first < key; });
+        for (; it != node->children.end() && it->first <= high; ++it) {
+            stack.push_back(it->second.get());
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Кількість слів у дереві.
+ */
+size_t BkTree::Size() const {
+    return count;
+}
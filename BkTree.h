@@ -0,0 +1,81 @@
+/**
+ * @file BkTree.h
+ * @brief Оголошення BK-дерева для нечіткого пошуку назв.
+ */
+
+#ifndef KURSOVA_BKTREE_H
+#define KURSOVA_BKTREE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @class BkTree
+ * @brief BK-дерево рядків за відстанню Левенштейна між кодовими точками.
+ *
+ * Кожен нащадок вузла зберігається під ключем — відстанню від слова вузла.
+ * Пошук у радіусі k з відстанню d до вузла спускається лише в нащадків
+ * з ключами в [d - k, d + k] (нерівність трикутника), тому відстань
+ * рахується лише для малої частини слів.
+ *
+ * Вузли мають спільне володіння: копія дерева копіює лише корінь, а вставка
+ * копіює вузли на шляху до нового листа, якщо вони спільні з іншою копією
+ * (як сегменти індексів TermSnapshot). Видалення не підтримується —
+ * застарілі слова відсіює власник дерева.
+ */
+class BkTree {
+public:
+    /** @brief Знайдене слово і його відстань до запиту. */
+    struct Match {
+        std::string word;
+        uint32_t distance;
+    };
+
+    /**
+     * @brief Додає слово.
+     * @param word Рядок UTF-8 (зазвичай назва у нижньому регістрі).
+     * @return false, якщо таке слово вже є.
+     */
+    bool Insert(const std::string &word);
+
+    /**
+     * @brief Знаходить усі слова на відстані не більше maxDistance.
+     * @param word Запит (UTF-8).
+     * @param maxDistance Радіус пошуку.
+     * @param visited Якщо не nullptr — сюди записується кількість обчислених відстаней.
+     * @return Збіги в порядку обходу.
+     */
+    std::vector<Match> Search(const std::string &word, uint32_t maxDistance, size_t *visited = nullptr) const;
+
+    /**
+     * @brief Кількість слів у дереві.
+     */
+    size_t Size() const;
+
+    /**
+     * @brief Відстань Левенштейна між послідовностями кодових точок.
+     */
+    static uint32_t Distance(const std::u32string &a, const std::u32string &b);
+
+private:
+    struct Node;
+    struct Pattern;
+
+    /**
+     * @brief Відстань від скомпільованого слова до іншого (бітово-паралельно).
+     */
+    static uint32_t Distance(const Pattern &pattern, const std::u32string &text);
+
+    /**
+     * @brief Повертає вузол для зміни (копіює спільний вузол).
+     */
+    static Node &MutableNode(std::shared_ptr<Node> &node);
+
+    std::shared_ptr<Node> root;
+    size_t count = 0;
+};
+
+#endif //KURSOVA_BKTREE_H
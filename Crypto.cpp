@@ -0,0 +1,308 @@
+/**
+ * @file Crypto.cpp
+ * @brief Реалізація SHA-256, HMAC та PBKDF2.
+ */
+
+#include "Crypto.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+namespace Crypto {
+
+    namespace {
+
+        /** @brief Константи раундів SHA-256 (FIPS 180-4, розділ 4.2.2). */
+        const uint32_t kRoundConstants[64] = {
+                0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+                0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+                0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+                0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+                0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+                0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+                0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+                0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+        };
+
+        inline uint32_t Rotr(uint32_t x, int n) {
+            return (x >> n) | (x << (32 - n));
+        }
+
+        /**
+         * @brief Попередньо оброблені ключі HMAC (ipad/opad).
+         *
+         * PBKDF2 викликає HMAC тисячі разів з одним ключем, тому стани після
+         * поглинання ipad- та opad-блоків обчислюються один раз і копіюються.
+         */
+        struct HmacKey {
+            Sha256 inner;
+            Sha256 outer;
+        };
+
+        HmacKey PrepareKey(const std::string &key) {
+            std::array<uint8_t, 64> block{};
+            if (key.size() > block.size()) {
+                Sha256 h;
+                h.Update(key);
+                Digest d = h.Finish();
+                std::memcpy(block.data(), d.data(), d.size());
+            } else {
+                std::memcpy(block.data(), key.data(), key.size());
+            }
+
+            std::array<uint8_t, 64> ipad{};
+            std::array<uint8_t, 64> opad{};
+            for (size_t i = 0; i < block.size(); ++i) {
+                ipad[i] = block[i] ^ 0x36;
+                opad[i] = block[i] ^ 0x5c;
+            }
+
+            HmacKey prepared;
+            prepared.inner.Update(ipad.data(), ipad.size());
+            prepared.outer.Update(opad.data(), opad.size());
+            return prepared;
+        }
+
+        Digest Hmac(const HmacKey &key, const uint8_t *data, size_t length) {
+            Sha256 inner = key.inner;
+            inner.Update(data, length);
+            Digest innerDigest = inner.Finish();
+
+            Sha256 outer = key.outer;
+            outer.Update(innerDigest.data(), innerDigest.size());
+            return outer.Finish();
+        }
+
+    }
+
+    // -----------------------------------------------------------
+    //  SHA-256
+    // -----------------------------------------------------------
+
+    /**
+     * @brief Ініціалізує початкові значення хешу (FIPS 180-4, 5.3.3).
+     */
+    Sha256::Sha256()
+            : state{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19},
+              buffer{} {}
+
+    /**
+     * @brief Стискає один блок даних.
+     */
+    void Sha256::Transform(const uint8_t *block) {
+        uint32_t w[64];
+        for (int i = 0; i < 16; ++i) {
+            w[i] = (uint32_t(block[i * 4]) << 24) | (uint32_t(block[i * 4 + 1]) << 16) |
+                   (uint32_t(block[i * 4 + 2]) << 8) | uint32_t(block[i * 4 + 3]);
+        }
+        for (int i = 16; i < 64; ++i) {
+            uint32_t s0 = Rotr(w[i - 15], 7) ^ Rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = Rotr(w[i - 2], 17) ^ Rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (int i = 0; i < 64; ++i) {
+            uint32_t s1 = Rotr(e, 6) ^ Rotr(e, 11) ^ Rotr(e, 25);
+            uint32_t ch = (e & f) ^ (~e & g);
+            uint32_t t1 = h + s1 + ch + kRoundConstants[i] + w[i];
+            uint32_t s0 = Rotr(a, 2) ^ Rotr(a, 13) ^ Rotr(a, 22);
+            uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            uint32_t t2 = s0 + maj;
+
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+
+    /**
+     * @brief Додає дані, обробляючи повні блоки одразу.
+     */
+    void Sha256::Update(const uint8_t *data, size_t length) {
+        totalLength += length;
+
+        if (bufferLength > 0) {
+            size_t take = std::min(length, buffer.size() - bufferLength);
+            std::memcpy(buffer.data() + bufferLength, data, take);
+            bufferLength += take;
+            data += take;
+            length -= take;
+            if (bufferLength < buffer.size()) return;
+            Transform(buffer.data());
+            bufferLength = 0;
+        }
+
+        while (length >= 64) {
+            Transform(data);
+            data += 64;
+            length -= 64;
+        }
+
+        std::memcpy(buffer.data(), data, length);
+        bufferLength = length;
+    }
+
+    /**
+     * @brief Додає рядок до хешу.
+     */
+    void Sha256::Update(const std::string &data) {
+        Update(reinterpret_cast<const uint8_t *>(data.data()), data.size());
+    }
+
+    /**
+     * @brief Доповнює повідомлення і повертає хеш.
+     */
+    Digest Sha256::Finish() {
+        uint64_t bitLength = totalLength * 8;
+
+        uint8_t pad = 0x80;
+        Update(&pad, 1);
+        uint8_t zero = 0;
+        while (bufferLength != 56) {
+            Update(&zero, 1);
+        }
+
+        uint8_t lengthBytes[8];
+        for (int i = 0; i < 8; ++i) {
+            lengthBytes[i] = static_cast<uint8_t>(bitLength >> (56 - 8 * i));
+        }
+        Update(lengthBytes, 8);
+
+        Digest out{};
+        for (int i = 0; i < 8; ++i) {
+            out[i * 4] = static_cast<uint8_t>(state[i] >> 24);
+            out[i * 4 + 1] = static_cast<uint8_t>(state[i] >> 16);
+            out[i * 4 + 2] = static_cast<uint8_t>(state[i] >> 8);
+            out[i * 4 + 3] = static_cast<uint8_t>(state[i]);
+        }
+        return out;
+    }
+
+    // -----------------------------------------------------------
+    //  HMAC та PBKDF2
+    // -----------------------------------------------------------
+
+    /**
+     * @brief HMAC-SHA256 (RFC 2104).
+     */
+    Digest HmacSha256(const std::string &key, const std::string &message) {
+        HmacKey prepared = PrepareKey(key);
+        return Hmac(prepared, reinterpret_cast<const uint8_t *>(message.data()), message.size());
+    }
+
+    /**
+     * @brief PBKDF2-HMAC-SHA256 (RFC 8018) для одного блоку виходу.
+     *
+     * Вартість лінійно залежить від iterations: кожна ітерація — два
+     * стискання SHA-256 завдяки попередньо обробленому ключу.
+     */
+    Digest Pbkdf2Sha256(const std::string &password, const std::string &salt, uint32_t iterations) {
+        HmacKey prepared = PrepareKey(password);
+
+        std::string first = salt;
+        first.push_back('\0');
+        first.push_back('\0');
+        first.push_back('\0');
+        first.push_back('\1');
+
+        Digest u = Hmac(prepared, reinterpret_cast<const uint8_t *>(first.data()), first.size());
+        Digest result = u;
+
+        for (uint32_t i = 1; i < iterations; ++i) {
+            u = Hmac(prepared, u.data(), u.size());
+            for (size_t j = 0; j < result.size(); ++j) {
+                result[j] ^= u[j];
+            }
+        }
+        return result;
+    }
+
+    // -----------------------------------------------------------
+    //  Допоміжні функції
+    // -----------------------------------------------------------
+
+    /**
+     * @brief Випадкові байти з системного джерела ентропії.
+     */
+    std::string RandomBytes(size_t length) {
+        std::random_device rd;
+        std::string out;
+        out.reserve(length);
+        while (out.size() < length) {
+            uint32_t value = rd();
+            for (int i = 0; i < 4 && out.size() < length; ++i) {
+                out.push_back(static_cast<char>(value >> (8 * i)));
+            }
+        }
+        return out;
+    }
+
+    /**
+     * @brief Кодує байти у hex (нижній регістр).
+     */
+    std::string ToHex(const uint8_t *data, size_t length) {
+        static const char digits[] = "0123456789abcdef";
+        std::string out;
+        out.reserve(length * 2);
+        for (size_t i = 0; i < length; ++i) {
+            out.push_back(digits[data[i] >> 4]);
+            out.push_back(digits[data[i] & 0x0f]);
+        }
+        return out;
+    }
+
+    /**
+     * @brief Декодує hex-рядок.
+     */
+    bool FromHex(const std::string &hex, std::string &out) {
+        if (hex.size() % 2 != 0) return false;
+
+        auto value = [](char c) -> int {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        };
+
+        out.clear();
+        out.reserve(hex.size() / 2);
+        for (size_t i = 0; i < hex.size(); i += 2) {
+            int hi = value(hex[i]);
+            int lo = value(hex[i + 1]);
+            if (hi < 0 || lo < 0) return false;
+            out.push_back(static_cast<char>((hi << 4) | lo));
+        }
+        return true;
+    }
+
+    /**
+     * @brief Порівняння без раннього виходу.
+     */
+    bool ConstantTimeEquals(const uint8_t *a, const uint8_t *b, size_t length) {
+        uint8_t diff = 0;
+        for (size_t i = 0; i < length; ++i) {
+            diff |= a[i] ^ b[i];
+        }
+        return diff == 0;
+    }
+
+}
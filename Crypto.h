@@ -0,0 +1,111 @@
+/**
+ * @file Crypto.h
+ * @brief Оголошення криптографічних примітивів для зберігання паролів.
+ */
+
+#ifndef KURSOVA_CRYPTO_H
+#define KURSOVA_CRYPTO_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @namespace Crypto
+ * @brief Власна реалізація SHA-256, HMAC-SHA256 та PBKDF2-HMAC-SHA256.
+ *
+ * Проєкт не використовує зовнішніх бібліотек, тому потрібні алгоритми
+ * реалізовано тут за стандартами FIPS 180-4, RFC 2104 та RFC 8018.
+ */
+namespace Crypto {
+
+    /** @brief Результат SHA-256 (32 байти). */
+    using Digest = std::array<uint8_t, 32>;
+
+    /**
+     * @class Sha256
+     * @brief Потокове обчислення SHA-256.
+     */
+    class Sha256 {
+    public:
+        /**
+         * @brief Створює об'єкт у початковому стані.
+         */
+        Sha256();
+
+        /**
+         * @brief Додає дані до хешу.
+         * @param data Вказівник на дані.
+         * @param length Довжина в байтах.
+         */
+        void Update(const uint8_t *data, size_t length);
+
+        /**
+         * @brief Додає рядок до хешу.
+         * @param data Рядок.
+         */
+        void Update(const std::string &data);
+
+        /**
+         * @brief Завершує обчислення.
+         * @return Значення хешу.
+         */
+        Digest Finish();
+
+    private:
+        /**
+         * @brief Обробляє один 64-байтовий блок.
+         */
+        void Transform(const uint8_t *block);
+
+        std::array<uint32_t, 8> state;
+        std::array<uint8_t, 64> buffer;
+        size_t bufferLength = 0;
+        uint64_t totalLength = 0;
+    };
+
+    /**
+     * @brief Обчислює HMAC-SHA256.
+     * @param key Ключ.
+     * @param message Повідомлення.
+     * @return Код автентичності.
+     */
+    Digest HmacSha256(const std::string &key, const std::string &message);
+
+    /**
+     * @brief Виводить ключ із пароля за алгоритмом PBKDF2-HMAC-SHA256 (32 байти).
+     * @param password Пароль.
+     * @param salt Сіль.
+     * @param iterations Кількість ітерацій (вартість).
+     * @return Виведений ключ.
+     */
+    Digest Pbkdf2Sha256(const std::string &password, const std::string &salt, uint32_t iterations);
+
+    /**
+     * @brief Повертає криптографічно випадкові байти (std::random_device).
+     * @param length Кількість байтів.
+     */
+    std::string RandomBytes(size_t length);
+
+    /**
+     * @brief Кодує байти у шістнадцятковий рядок.
+     */
+    std::string ToHex(const uint8_t *data, size_t length);
+
+    /**
+     * @brief Декодує шістнадцятковий рядок.
+     * @param hex Вхідний рядок.
+     * @param out Результат.
+     * @return false, якщо рядок некоректний.
+     */
+    bool FromHex(const std::string &hex, std::string &out);
+
+    /**
+     * @brief Порівнює дві послідовності за сталий час (захист від атак за часом).
+     */
+    bool ConstantTimeEquals(const uint8_t *a, const uint8_t *b, size_t length);
+
+}
+
+#endif //KURSOVA_CRYPTO_H
@@ -0,0 +1,198 @@
+/**
+ * @file DefinitionCache.cpp
+ * @brief Реалізація кешу прочитаних визначень з витісненням CLOCK.
+ */
+
+#include "DefinitionCache.h"
+#include "TermBase.h"
+
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    /** @brief Позначка "терміна немає в колі" для TermBase::cacheSlot. */
+    constexpr size_t kNoSlot = static_cast<size_t>(-1);
+}
+
+// -------------------------------------------------------------
+//                     STATS
+// -------------------------------------------------------------
+
+/**
+ * @brief hits / (hits + misses).
+ */
+double DefinitionCache::Stats::HitRate() const {
+    uint64_t total = hits + misses;
+    return total == 0 ? 0.0 : 100.0 * static_cast<double>(hits) / static_cast<double>(total);
+}
+
+/**
+ * @brief Форматує стан кешу одним рядком.
+ */
+std::string DefinitionCache::Stats::Describe() const {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(1) << static_cast<double>(residentBytes) / 1e6 << " МБ";
+    if (budget > 0) text << " з " << static_cast<double>(budget) / 1e6 << " МБ";
+    text << ", визначень " << residentTerms << ", влучань " << HitRate() << "% (" << hits << "/"
+         << hits + misses << "), витіснень " << evictions;
+    return text.str();
+}
+
+// -------------------------------------------------------------
+//                     CONSTRUCTOR
+// -------------------------------------------------------------
+
+/**
+ * @brief Створює кеш з порожнім кладовищем.
+ */
+DefinitionCache::DefinitionCache(size_t budget)
+        : budget(budget), graveyard(std::make_shared<Graveyard>()) {}
+
+// -------------------------------------------------------------
+//                     BUDGET
+// -------------------------------------------------------------
+
+/**
+ * @brief Запам'ятовує бюджет і одразу приводить до нього розмір кешу.
+ */
+void DefinitionCache::SetBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    budget.store(bytes);
+    EvictLocked(nullptr);
+}
+
+/**
+ * @brief Поточний бюджет.
+ */
+size_t DefinitionCache::GetBudget() const {
+    return budget.load();
+}
+
+/**
+ * @brief Рядки визначення разом з накладними витратами на об'єкт.
+ */
+size_t DefinitionCache::Footprint(const CachedDefinition &definition) {
+    return sizeof(CachedDefinition) + definition.text.capacity() + definition.folded.capacity();
+}
+
+// -------------------------------------------------------------
+//                     CLOCK
+// -------------------------------------------------------------
+
+/**
+ * @brief Додає термін у коло перед стрілкою і витісняє зайве.
+ *
+ * Новий термін уже має біт звернення, тож стрілка пропустить його
+ * хоча б один раз.
+ */
+void DefinitionCache::Admit(const TermBase *term) {
+    std::lock_guard<std::mutex> lock(mutex);
+    term->cacheSlot = ring.size();
+    ring.push_back(term);
+    residentBytes += Footprint(*term->cached.load(std::memory_order_acquire));
+    misses++;
+    EvictLocked(&TermBase::DefinitionLock(term));
+}
+
+/**
+ * @brief Прибирає термін з кола, якщо він там є.
+ */
+void DefinitionCache::Forget(const TermBase *term) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (term->cacheSlot == kNoSlot) return;
+    residentBytes -= Footprint(*term->cached.load(std::memory_order_acquire));
+    RemoveLocked(term);
+}
+
+/**
+ * @brief Переносить останній елемент кола на місце терміна.
+ */
+void DefinitionCache::RemoveLocked(const TermBase *term) {
+    size_t slot = term->cacheSlot;
+    ring[slot] = ring.back();
+    ring[slot]->cacheSlot = slot;
+    ring.pop_back();
+    term->cacheSlot = kNoSlot;
+}
+
+/**
+ * @brief Обходить коло: термін зі скинутим бітом витісняється, іншим біт скидається.
+ *
+ * Термін, чий м'ютекс зайнятий, зараз читають — стрілка його минає. Обхід
+ * обмежено двома колами, щоб не крутитися, коли всі кандидати зайняті;
+ * тоді бюджет тимчасово перевищено до наступного Admit. Визначення, видане
+ * назовні, йде на поточне кладовище; коли там набирається kGraveyardBatch,
+ * починається нове, і старе звільниться, щойно його відпустять читачі.
+ */
+void DefinitionCache::EvictLocked(const std::mutex *held) {
+    const size_t limit = budget.load();
+    if (limit == 0) return;
+
+    for (size_t steps = 2 * ring.size() + 1; residentBytes > limit && !ring.empty() && steps > 0; --steps) {
+        if (hand >= ring.size()) hand = 0;
+        const TermBase *term = ring[hand];
+        if (term->recentlyUsed.exchange(false, std::memory_order_relaxed)) {
+            hand++;
+            continue;
+        }
+        std::mutex &lock = TermBase::DefinitionLock(term);
+        if (&lock == held || !lock.try_lock()) {
+            hand++;
+            continue;
+        }
+
+        const CachedDefinition *definition = term->cached.exchange(nullptr, std::memory_order_relaxed);
+        residentBytes -= Footprint(*definition);
+        if (definition->exposed) {
+            graveyard->items.emplace_back(definition);
+        } else {
+            delete definition;
+        }
+        lock.unlock();
+        RemoveLocked(term);
+        evictions++;
+    }
+
+    if (graveyard->items.size() >= kGraveyardBatch) {
+        auto fresh = std::make_shared<Graveyard>();
+        graveyard->next = fresh;
+        std::atomic_store(&graveyard, fresh);
+    }
+}
+
+// -------------------------------------------------------------
+//                     READERS
+// -------------------------------------------------------------
+
+/**
+ * @brief Збільшує одну зі смуг лічильника (смуга закріплена за потоком).
+ */
+void DefinitionCache::CountHit() {
+    static std::atomic<size_t> nextStripe{0};
+    thread_local const size_t stripe = nextStripe.fetch_add(1) % kHitStripes;
+    hits[stripe].value.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Поточне кладовище.
+ */
+std::shared_ptr<const void> DefinitionCache::Pin() const {
+    return std::atomic_load(&graveyard);
+}
+
+/**
+ * @brief Знімає показники під м'ютексом (влучання — без нього).
+ */
+DefinitionCache::Stats DefinitionCache::GetStats() const {
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.budget = budget.load();
+        stats.residentBytes = residentBytes;
+        stats.residentTerms = ring.size();
+        stats.misses = misses;
+        stats.evictions = evictions;
+    }
+    for (const auto &stripe : hits) stats.hits += stripe.value.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,202 @@
+/**
+ * @file DefinitionCache.h
+ * @brief Оголошення кешу прочитаних визначень з обмеженням пам'яті.
+ */
+
+#ifndef KURSOVA_DEFINITIONCACHE_H
+#define KURSOVA_DEFINITIONCACHE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class TermBase;
+
+/**
+ * @struct CachedDefinition
+ * @brief Прочитане з файлу визначення разом з тіньовою копією для пошуку.
+ */
+struct CachedDefinition {
+    std::string text;
+    /** @brief Визначення у нижньому регістрі (порожнє, якщо збігається з text). */
+    std::string folded;
+    /**
+     * @brief Посилання на text віддавалося назовні (TermBase::GetDefinition).
+     *
+     * Таке визначення після витіснення чекає на кладовищі; решту звертань
+     * кеш бачить під м'ютексом терміна і звільняє визначення одразу.
+     */
+    mutable bool exposed = false;
+};
+
+/**
+ * @class DefinitionCache
+ * @brief Облік відкладених визначень, прочитаних у пам'ять, і їх витіснення.
+ *
+ * Відкладене визначення (TermBase::SetLazyDefinition) після першого читання
+ * реєструється тут. Якщо сумарний розмір перевищує бюджет, алгоритм CLOCK
+ * витісняє визначення, до яких давно не зверталися: термін повертається у
+ * відкладений стан, а текст за потреби знову читається з відображеного
+ * файлу бази. Так само обліковуються розкодовані копії стиснених
+ * визначень (TermBase::CompressDefinition). Назви, посилання та індекси
+ * завжди лишаються в пам'яті.
+ *
+ * Звертання всередині TermBase (пошук, збереження, копіювання) тримають
+ * м'ютекс терміна, а витіснення бере його через try_lock і пропускає
+ * зайняті терміни, тож таке визначення звільняється одразу. Посилання з
+ * GetDefinition живе поза блокуванням, тому визначення, яке його віддавало,
+ * йде на "кладовище". Кожен читач закріплює (Pin) поточне кладовище на час
+ * роботи зі знімком; кладовища утворюють ланцюжок від старих до нових,
+ * тому закріплене тримає і всі наступні. Коли останній читач відпускає
+ * кладовище, його визначення звільняються.
+ */
+class DefinitionCache {
+public:
+    /**
+     * @brief Стан кешу для звітів.
+     */
+    struct Stats {
+        /** @brief Бюджет у байтах (0 — без обмеження). */
+        size_t budget = 0;
+        /** @brief Байтів у прочитаних визначеннях. */
+        size_t residentBytes = 0;
+        /** @brief Прочитаних визначень у пам'яті. */
+        size_t residentTerms = 0;
+        /** @brief Звернень до визначень, що вже були в пам'яті. */
+        uint64_t hits = 0;
+        /** @brief Читань визначень з файлу. */
+        uint64_t misses = 0;
+        /** @brief Витіснених визначень. */
+        uint64_t evictions = 0;
+
+        /**
+         * @brief Частка влучань у відсотках.
+         */
+        double HitRate() const;
+
+        /**
+         * @brief Опис для звітів, наприклад "1.2 МБ з 4.0 МБ, 310 визначень, влучань 97.5%, витіснень 12".
+         */
+        std::string Describe() const;
+    };
+
+    /**
+     * @brief Створює кеш.
+     * @param budget Бюджет у байтах (0 — без обмеження).
+     */
+    explicit DefinitionCache(size_t budget = 0);
+
+    DefinitionCache(const DefinitionCache &) = delete;
+    DefinitionCache &operator=(const DefinitionCache &) = delete;
+
+    /**
+     * @brief Змінює бюджет; зайве витісняється одразу.
+     * @param bytes Бюджет у байтах (0 — без обмеження).
+     */
+    void SetBudget(size_t bytes);
+
+    /**
+     * @brief Поточний бюджет у байтах.
+     */
+    size_t GetBudget() const;
+
+    /**
+     * @brief Реєструє щойно прочитане визначення і за потреби витісняє інші.
+     *
+     * Викликається з TermBase під DefinitionLock(term); терміни з цим
+     * м'ютексом не витісняються.
+     */
+    void Admit(const TermBase *term);
+
+    /**
+     * @brief Прибирає термін з обліку (деструктор або заміна визначення).
+     *
+     * Після повернення кеш більше не торкається терміна; прочитане
+     * визначення, якщо воно ще є, звільняє сам термін.
+     */
+    void Forget(const TermBase *term);
+
+    /**
+     * @brief Рахує звернення до визначення, що вже в пам'яті.
+     */
+    void CountHit();
+
+    /**
+     * @brief Закріплює поточне кладовище на час читання.
+     * @return Власник кладовища; витіснені після цього визначення живуть, доки він існує.
+     */
+    std::shared_ptr<const void> Pin() const;
+
+    /**
+     * @brief Поточний стан кешу.
+     */
+    Stats GetStats() const;
+
+private:
+    /**
+     * @brief Витіснені визначення, які ще можуть читати.
+     */
+    struct Graveyard {
+        std::vector<std::unique_ptr<const CachedDefinition>> items;
+        /** @brief Наступне кладовище: закріплене старе тримає всі новіші. */
+        std::shared_ptr<Graveyard> next;
+    };
+
+    /**
+     * @brief Скільки визначень збирає кладовище, перш ніж почнеться нове.
+     *
+     * Ланцюжок звільняється рекурсивно, тож кладовища не дрібняться
+     * на кожне витіснення.
+     */
+    static constexpr size_t kGraveyardBatch = 64;
+
+    /**
+     * @brief Лічильник в окремому рядку кешу процесора.
+     */
+    struct alignas(64) Counter {
+        std::atomic<uint64_t> value{0};
+    };
+
+    /** @brief Кількість смуг лічильника влучань. */
+    static constexpr size_t kHitStripes = 16;
+
+    /**
+     * @brief Скільки пам'яті займає прочитане визначення.
+     */
+    static size_t Footprint(const CachedDefinition &definition);
+
+    /**
+     * @brief Прибирає термін з кола CLOCK (під mutex).
+     */
+    void RemoveLocked(const TermBase *term);
+
+    /**
+     * @brief Витісняє визначення, поки розмір перевищує бюджет (під mutex).
+     * @param held М'ютекс терміна, який уже утримує викликач (або nullptr).
+     */
+    void EvictLocked(const std::mutex *held);
+
+    mutable std::mutex mutex;
+
+    /** @brief Коло CLOCK: терміни з прочитаними визначеннями. */
+    std::vector<const TermBase *> ring;
+    /** @brief Стрілка CLOCK. */
+    size_t hand = 0;
+
+    std::atomic<size_t> budget;
+    size_t residentBytes = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    std::array<Counter, kHitStripes> hits;
+
+    /**
+     * @brief Кладовище, куди йдуть витіснені зараз (читається через std::atomic_load).
+     */
+    std::shared_ptr<Graveyard> graveyard;
+};
+
+#endif //KURSOVA_DEFINITIONCACHE_H
@@ -0,0 +1,208 @@
+/**
+ * @file DefinitionCodec.cpp
+ * @brief Реалізація кодека стиснення визначень за таблицею символів.
+ */
+
+#include "DefinitionCodec.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+    /** @brief Кількість поколінь навчання таблиці. */
+    constexpr int kGenerations = 5;
+
+    /**
+     * @brief Маска молодших length байтів слова.
+     */
+    uint64_t LowBytes(size_t length) {
+        return length >= 8 ? ~uint64_t(0) : (uint64_t(1) << (8 * length)) - 1;
+    }
+
+    /**
+     * @brief Читає до 8 байтів тексту в слово (решта — нулі).
+     */
+    uint64_t LoadWord(const char *data, size_t size) {
+        uint64_t word = 0;
+        std::memcpy(&word, data, size < 8 ? size : 8);
+        return word;
+    }
+}
+
+// -------------------------------------------------------------
+//                     STATS
+// -------------------------------------------------------------
+
+/**
+ * @brief Форматує підсумок стиснення одним рядком.
+ */
+std::string DefinitionCodec::Stats::Describe() const {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(1) << static_cast<double>(plainBytes) / 1e6 << " МБ -> "
+         << static_cast<double>(encodedBytes) / 1e6 << " МБ";
+    if (encodedBytes > 0) {
+        text << " (x" << static_cast<double>(plainBytes) / static_cast<double>(encodedBytes) << ")";
+    }
+    text << ", визначень " << terms << ", символів " << symbols << ", " << std::setprecision(0) << elapsedMs
+         << " мс";
+    return text.str();
+}
+
+// -------------------------------------------------------------
+//                     TRAINING
+// -------------------------------------------------------------
+
+/**
+ * @brief Покоління за поколінням уточнює таблицю символів.
+ *
+ * Перше покоління починає з порожньої таблиці, тож кандидатами стають
+ * окремі байти і їхні пари; кожне наступне склеює сусідні символи
+ * попереднього, і довжина символів росте до kMaxSymbolLength. Перший байт
+ * довгого символу теж рахується кандидатом, щоб таблиця не втрачала
+ * частих байтів. Кандидати з однаковим виграшем впорядковуються за
+ * вмістом, тож таблиця не залежить від порядку обходу хеш-таблиці.
+ */
+std::shared_ptr<const DefinitionCodec> DefinitionCodec::Train(const std::vector<std::string> &sample) {
+    std::vector<std::string> table;
+    std::unordered_map<std::string, uint64_t> gain;
+
+    for (int generation = 0; generation < kGenerations; ++generation) {
+        DefinitionCodec current;
+        current.Build(table);
+        gain.clear();
+
+        for (const auto &text : sample) {
+            const char *data = text.data();
+            const size_t size = text.size();
+            size_t previous = 0;
+            size_t previousLength = 0;
+            for (size_t pos = 0; pos < size;) {
+                unsigned char code;
+                size_t length = current.Match(data + pos, size - pos, code);
+                if (length == 0) length = 1;
+
+                gain[std::string(data + pos, length)] += length;
+                if (length > 1) gain[std::string(data + pos, 1)] += 1;
+                if (previousLength > 0 && previousLength + length <= kMaxSymbolLength) {
+                    gain[std::string(data + previous, previousLength + length)] += previousLength + length;
+                }
+                previous = pos;
+                previousLength = length;
+                pos += length;
+            }
+        }
+
+        std::vector<std::pair<std::string, uint64_t>> candidates(gain.begin(), gain.end());
+        size_t keep = std::min(kMaxSymbols, candidates.size());
+        std::partial_sort(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(keep),
+                          candidates.end(), [](const auto &a, const auto &b) {
+                              return a.second != b.second ? a.second > b.second : a.first < b.first;
+                          });
+        table.clear();
+        for (size_t i = 0; i < keep; ++i) table.push_back(std::move(candidates[i].first));
+    }
+
+    std::shared_ptr<DefinitionCodec> codec(new DefinitionCodec());
+    codec->Build(table);
+    return codec;
+}
+
+/**
+ * @brief Пакує символи в слова і розкладає коди за першим байтом.
+ */
+void DefinitionCodec::Build(const std::vector<std::string> &table) {
+    count = std::min(table.size(), kMaxSymbols);
+    for (auto &codes : byFirstByte) codes.clear();
+
+    for (size_t code = 0; code < count; ++code) {
+        const std::string &symbol = table[code];
+        symbols[code] = LoadWord(symbol.data(), symbol.size());
+        lengths[code] = static_cast<uint8_t>(symbol.size());
+        byFirstByte[static_cast<unsigned char>(symbol[0])].push_back(static_cast<unsigned char>(code));
+    }
+    for (auto &codes : byFirstByte) {
+        std::stable_sort(codes.begin(), codes.end(), [this](unsigned char a, unsigned char b) {
+            return lengths[a] > lengths[b];
+        });
+    }
+}
+
+// -------------------------------------------------------------
+//                     CODING
+// -------------------------------------------------------------
+
+/**
+ * @brief Порівнює наступні 8 байтів тексту з кандидатами одним словом.
+ */
+size_t DefinitionCodec::Match(const char *data, size_t size, unsigned char &code) const {
+    const uint64_t word = LoadWord(data, size);
+    for (unsigned char candidate : byFirstByte[static_cast<unsigned char>(data[0])]) {
+        size_t length = lengths[candidate];
+        if (length <= size && (word & LowBytes(length)) == symbols[candidate]) {
+            code = candidate;
+            return length;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Жадібно замінює найдовші символи кодами.
+ */
+void DefinitionCodec::Encode(const char *data, size_t size, std::string &out) const {
+    for (size_t pos = 0; pos < size;) {
+        unsigned char code;
+        size_t length = Match(data + pos, size - pos, code);
+        if (length > 0) {
+            out.push_back(static_cast<char>(code));
+            pos += length;
+        } else {
+            out.push_back(static_cast<char>(kEscape));
+            out.push_back(data[pos++]);
+        }
+    }
+}
+
+/**
+ * @brief Розкодовує через буфер потоку і дописує лише розкодовані байти.
+ *
+ * Буфер потоку тільки росте, тож resize заповнює нулями лише новий
+ * приріст, а не size * kMaxSymbolLength байтів на кожен виклик.
+ */
+void DefinitionCodec::Decode(const char *data, size_t size, std::string &out) const {
+    thread_local std::string scratch;
+    if (scratch.size() < size * kMaxSymbolLength) scratch.resize(size * kMaxSymbolLength);
+    out.append(scratch.data(), DecodeTo(data, size, &scratch[0]));
+}
+
+/**
+ * @brief Розкодовує в заздалегідь виділене місце.
+ *
+ * Символ копіюється цілим словом, а вказівник просувається на його
+ * довжину; місця вистачає, бо кожен код дає не більше kMaxSymbolLength
+ * байтів.
+ */
+size_t DefinitionCodec::DecodeTo(const char *data, size_t size, char *out) const {
+    char *write = out;
+    for (size_t i = 0; i < size; ++i) {
+        auto code = static_cast<unsigned char>(data[i]);
+        if (code == kEscape) {
+            if (++i < size) *write++ = data[i];
+        } else {
+            std::memcpy(write, &symbols[code], kMaxSymbolLength);
+            write += lengths[code];
+        }
+    }
+    return static_cast<size_t>(write - out);
+}
+
+/**
+ * @brief Кількість символів у таблиці.
+ */
+size_t DefinitionCodec::GetSymbolCount() const {
+    return count;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file DefinitionCodec.h
+ * @brief Оголошення кодека стиснення визначень за таблицею символів.
+ */
+
+#ifndef KURSOVA_DEFINITIONCODEC_H
+#define KURSOVA_DEFINITIONCODEC_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class DefinitionCodec
+ * @brief Стиснення коротких текстів таблицею з 255 символів (за ідеєю FSST).
+ *
+ * Символ — це послідовність з 1..8 байтів, що часто трапляється у вибірці;
+ * у стисненому тексті кожен символ замінюється однобайтовим кодом, а байт,
+ * якого немає в таблиці, записується після коду kEscape. Таблиця спільна
+ * для всіх визначень, тож кожне визначення кодується і розкодовується
+ * окремо, без сусідів: довільний доступ коштує одного проходу по кількох
+ * десятках байтів.
+ *
+ * Таблиця навчається на вибірці з бази (Train) і після цього не змінюється,
+ * тому кодек можна використовувати з будь-якої кількості потоків. Стиснений
+ * формат залежить від порядку байтів платформи і не зберігається на диск.
+ */
+class DefinitionCodec {
+public:
+    /** @brief Найбільша кількість символів у таблиці. */
+    static constexpr size_t kMaxSymbols = 255;
+
+    /** @brief Найбільша довжина символу в байтах. */
+    static constexpr size_t kMaxSymbolLength = 8;
+
+    /** @brief Код, після якого йде байт без символу. */
+    static constexpr unsigned char kEscape = 255;
+
+    /**
+     * @brief Підсумок стиснення бази для звітів.
+     */
+    struct Stats {
+        /** @brief Символів у таблиці. */
+        size_t symbols = 0;
+        /** @brief Стиснених визначень. */
+        size_t terms = 0;
+        /** @brief Байтів визначень до стиснення. */
+        size_t plainBytes = 0;
+        /** @brief Байтів після стиснення. */
+        size_t encodedBytes = 0;
+        /** @brief Тривалість навчання і стиснення, мс. */
+        double elapsedMs = 0.0;
+
+        /**
+         * @brief Опис для звітів, наприклад "4.1 МБ -> 1.6 МБ (x2.6), 30000 визначень, 255 символів, 85 мс".
+         */
+        std::string Describe() const;
+    };
+
+    /**
+     * @brief Будує таблицю символів за вибіркою текстів.
+     *
+     * Кілька поколінь: вибірка кодується поточною таблицею, для кожного
+     * символу і кожної пари сусідніх символів (до kMaxSymbolLength байтів)
+     * рахується виграш "частота × довжина", і наступна таблиця складається
+     * з kMaxSymbols кандидатів з найбільшим виграшем.
+     * @param sample Тексти вибірки.
+     * @return Навчений кодек.
+     */
+    static std::shared_ptr<const DefinitionCodec> Train(const std::vector<std::string> &sample);
+
+    /**
+     * @brief Дописує стиснений текст у буфер.
+     * @param data Початок тексту.
+     * @param size Довжина тексту.
+     * @param out Буфер викликача.
+     */
+    void Encode(const char *data, size_t size, std::string &out) const;
+
+    /**
+     * @brief Дописує розкодований текст у буфер.
+     * @param data Початок стисненого тексту.
+     * @param size Довжина стисненого тексту.
+     * @param out Буфер викликача.
+     */
+    void Decode(const char *data, size_t size, std::string &out) const;
+
+    /**
+     * @brief Розкодовує текст у буфер викликача без проміжних копій.
+     *
+     * Буфер має вміщати size * kMaxSymbolLength байтів: символи копіюються
+     * цілим словом. Буфер, що лише росте (наприклад, буфер потоку), не
+     * заповнюється нулями від виклику до виклику.
+     * @param data Початок стисненого тексту.
+     * @param size Довжина стисненого тексту.
+     * @param out Початок місця для розкодованого тексту.
+     * @return Довжина розкодованого тексту.
+     */
+    size_t DecodeTo(const char *data, size_t size, char *out) const;
+
+    /**
+     * @brief Кількість символів у таблиці.
+     */
+    size_t GetSymbolCount() const;
+
+private:
+    DefinitionCodec() = default;
+
+    /**
+     * @brief Заповнює таблиці кодування і розкодування.
+     * @param table Символи; код символу — його номер у списку.
+     */
+    void Build(const std::vector<std::string> &table);
+
+    /**
+     * @brief Шукає найдовший символ на початку тексту.
+     * @param code Куди записати код знайденого символу.
+     * @return Довжина символу або 0, якщо жоден не підходить.
+     */
+    size_t Match(const char *data, size_t size, unsigned char &code) const;
+
+    /** @brief Байти символів, вирівняні до 8 (для копіювання одним словом). */
+    std::array<uint64_t, kMaxSymbols> symbols{};
+
+    /** @brief Довжини символів. */
+    std::array<uint8_t, kMaxSymbols> lengths{};
+
+    /** @brief Коди символів за першим байтом, від довших до коротших. */
+    std::array<std::vector<unsigned char>, 256> byFirstByte;
+
+    size_t count = 0;
+};
+
+#endif //KURSOVA_DEFINITIONCODEC_H
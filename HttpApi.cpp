@@ -0,0 +1,292 @@
+/**
+ * @file HttpApi.cpp
+ * @brief Реалізація JSON API для читання бази термінів.
+ */
+
+#include "HttpApi.h"
+#include "QueryHandler.h"
+#include "Term.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+
+// -------------------------------------------------------------
+//                     CONSTRUCTOR
+// -------------------------------------------------------------
+
+/**
+ * @brief Конструктор.
+ * @param termManager База термінів.
+ */
+HttpApi::HttpApi(const TermManager &termManager)
+        : termManager(termManager) {}
+
+// -------------------------------------------------------------
+//                     ENCODING
+// -------------------------------------------------------------
+
+/**
+ * @brief Декодує %-послідовності URL.
+ */
+bool HttpApi::UrlDecode(const std::string &value, bool plusIsSpace, std::string &out) {
+    out.clear();
+    out.reserve(value.size());
+    for (size_t i = 0; i < value.size(); ++i) {
+        char c = value[i];
+        if (c == '+' && plusIsSpace) {
+            out.push_back(' ');
+        } else if (c == '%') {
+            if (i + 2 >= value.size()) return false;
+            unsigned byte = 0;
+            auto result = std::from_chars(value.data() + i + 1, value.data() + i + 3, byte, 16);
+            if (result.ec != std::errc() || result.ptr != value.data() + i + 3) return false;
+            out.push_back(static_cast<char>(byte));
+            i += 2;
+        } else {
+            out.push_back(c);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Кодує рядок для шляху або параметра URL.
+ */
+std::string HttpApi::UrlEncode(const std::string &value) {
+    static const char hex[] = "0123456789ABCDEF";
+    std::string out;
+    out.reserve(value.size() * 3);
+    for (char c : value) {
+        auto byte = static_cast<unsigned char>(c);
+        if ((byte < 0x80 && std::isalnum(byte)) || c == '-' || c == '_' || c == '.' || c == '~') {
+            out.push_back(c);
+        } else {
+            out.push_back('%');
+            out.push_back(hex[byte >> 4]);
+            out.push_back(hex[byte & 0x0F]);
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Дописує рядок JSON; UTF-8 передається як є, керуючі символи — \\uXXXX.
+ */
+void HttpApi::AppendJsonString(std::string &out, const std::string &value) {
+    static const char hex[] = "0123456789abcdef";
+    out.push_back('"');
+    for (char c : value) {
+        auto byte = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            out.push_back('\\');
+            out.push_back(c);
+        } else if (byte < 0x20) {
+            switch (c) {
+                case '\n': out.append("\\n"); break;
+                case '\r': out.append("\\r"); break;
+                case '\t': out.append("\\t"); break;
+                default:
+                    out.append("\\u00");
+                    out.push_back(hex[byte >> 4]);
+                    out.push_back(hex[byte & 0x0F]);
+            }
+        } else {
+            out.push_back(c);
+        }
+    }
+    out.push_back('"');
+}
+
+/**
+ * @brief Дописує число через std::to_chars.
+ */
+void HttpApi::AppendNumber(std::string &out, uint64_t value) {
+    char digits[24];
+    auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+    out.append(digits, end);
+}
+
+/**
+ * @brief Знаходить key=value у рядку запиту.
+ */
+bool HttpApi::QueryParam(const std::string &query, const std::string &key, std::string &out) {
+    size_t pos = 0;
+    while (pos <= query.size()) {
+        size_t end = query.find('&', pos);
+        if (end == std::string::npos) end = query.size();
+        if (end - pos > key.size() && query.compare(pos, key.size(), key) == 0 && query[pos + key.size()] == '=') {
+            size_t start = pos + key.size() + 1;
+            return UrlDecode(query.substr(start, end - start), true, out);
+        }
+        pos = end + 1;
+    }
+    return false;
+}
+
+/**
+ * @brief Тіло помилки.
+ */
+int HttpApi::Error(std::string &body, int status, const char *code) {
+    body.append("{\"error\":\"");
+    body.append(code);
+    body.append("\"}");
+    return status;
+}
+
+// -------------------------------------------------------------
+//                     ROUTES
+// -------------------------------------------------------------
+
+/**
+ * @brief Виконує запит і дописує JSON у body.
+ * @param target Шлях з параметрами.
+ * @param body Буфер тіла відповіді.
+ * @return HTTP-статус.
+ */
+int HttpApi::Handle(const std::string &target, std::string &body) const {
+    size_t question = target.find('?');
+    std::string rawPath = target.substr(0, question);
+    std::string query = question == std::string::npos ? std::string() : target.substr(question + 1);
+
+    std::string path;
+    if (!UrlDecode(rawPath, false, path)) return Error(body, 400, "bad_encoding");
+
+    const std::string termsPrefix = "/terms/";
+    const std::string chainPrefix = "/chain/";
+
+    if (path.compare(0, termsPrefix.size(), termsPrefix) == 0) {
+        auto term = termManager.FindByName(path.substr(termsPrefix.size()));
+        if (!term) return Error(body, 404, "not_found");
+
+        body.append("{\"name\":");
+        AppendJsonString(body, term->GetName());
+        body.append(term->IsPrimitive() ? ",\"type\":\"PRIM\",\"definition\":" : ",\"type\":\"TERM\",\"definition\":");
+        AppendJsonString(body, term->GetDefinition());
+        body.append(",\"references\":[");
+        if (auto t = std::dynamic_pointer_cast<const Term>(term)) {
+            bool first = true;
+            for (const auto &ref : t->GetReferences()) {
+                if (!first) body.push_back(',');
+                first = false;
+                AppendJsonString(body, ref);
+            }
+        }
+        body.append("]}");
+        return 200;
+    }
+
+    if (path == "/complete") {
+        std::string q;
+        if (!QueryParam(query, "q", q)) return Error(body, 400, "bad_arguments");
+        size_t limit = TermManager::kDefaultCompletions;
+        std::string limitText;
+        if (QueryParam(query, "limit", limitText)) {
+            auto result = std::from_chars(limitText.data(), limitText.data() + limitText.size(), limit);
+            if (result.ec != std::errc() || limit == 0) return Error(body, 400, "bad_arguments");
+        }
+
+        auto names = termManager.CompleteName(q, std::min(limit, TermManager::kMaxCompletions));
+        body.append("{\"prefix\":");
+        AppendJsonString(body, q);
+        body.append(",\"count\":");
+        AppendNumber(body, names.size());
+        body.append(",\"results\":[");
+        for (size_t i = 0; i < names.size(); ++i) {
+            if (i > 0) body.push_back(',');
+            AppendJsonString(body, names[i]);
+        }
+        body.append("]}");
+        return 200;
+    }
+
+    if (path == "/search") {
+        std::string q;
+        if (!QueryParam(query, "q", q) || q.empty()) return Error(body, 400, "bad_arguments");
+
+        auto found = termManager.SearchDefinitions(q);
+        body.append("{\"query\":");
+        AppendJsonString(body, q);
+        body.append(",\"count\":");
+        AppendNumber(body, found.size());
+        body.append(",\"results\":[");
+        for (size_t i = 0; i < found.size(); ++i) {
+            if (i > 0) body.push_back(',');
+            AppendJsonString(body, found[i]->GetName());
+        }
+        body.append("]}");
+        return 200;
+    }
+
+    if (path == "/query") {
+        std::string q;
+        if (!QueryParam(query, "q", q) || q.empty()) return Error(body, 400, "bad_arguments");
+        std::string explain;
+        bool withPlan = QueryParam(query, "explain", explain) && explain == "1";
+
+        std::vector<TermSnapshot::TermPtr> found;
+        std::string error;
+        std::string plan;
+        if (!termManager.Query(q, found, error, withPlan ? &plan : nullptr)) {
+            body.append("{\"error\":\"bad_query\",\"message\":");
+            AppendJsonString(body, error);
+            body.append("}");
+            return 400;
+        }
+
+        body.append("{\"query\":");
+        AppendJsonString(body, q);
+        body.append(",\"count\":");
+        AppendNumber(body, found.size());
+        body.append(",\"results\":[");
+        for (size_t i = 0; i < found.size(); ++i) {
+            if (i > 0) body.push_back(',');
+            AppendJsonString(body, found[i]->GetName());
+        }
+        body.append("]");
+        if (withPlan) {
+            body.append(",\"plan\":");
+            AppendJsonString(body, plan);
+        }
+        body.append("}");
+        return 200;
+    }
+
+    if (path.compare(0, chainPrefix.size(), chainPrefix) == 0) {
+        std::string name = path.substr(chainPrefix.size());
+        auto steps = termManager.CollectChain(name);
+        if (steps.empty()) return Error(body, 404, "not_found");
+
+        body.append("{\"name\":");
+        AppendJsonString(body, name);
+        body.append(",\"count\":");
+        AppendNumber(body, steps.size());
+        body.append(",\"steps\":[");
+        for (size_t i = 0; i < steps.size(); ++i) {
+            if (i > 0) body.push_back(',');
+            body.append("{\"level\":");
+            AppendNumber(body, static_cast<uint64_t>(steps[i].level));
+            body.append(",\"name\":");
+            AppendJsonString(body, steps[i].name);
+            body.append(",\"kind\":\"");
+            body.append(QueryHandler::ChainKindName(steps[i].kind));
+            body.append("\"}");
+        }
+        body.append("]}");
+        return 200;
+    }
+
+    if (path == "/stats") {
+        TermStats stats = termManager.GetStats();
+        body.append("{\"total\":");
+        AppendNumber(body, stats.total);
+        body.append(",\"primitive\":");
+        AppendNumber(body, stats.primitive);
+        body.append(",\"composite\":");
+        AppendNumber(body, stats.composite);
+        body.append("}");
+        return 200;
+    }
+
+    return Error(body, 404, "no_route");
+}
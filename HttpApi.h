@@ -0,0 +1,87 @@
+/**
+ * @file HttpApi.h
+ * @brief Оголошення JSON API для читання бази термінів по HTTP.
+ */
+
+#ifndef KURSOVA_HTTPAPI_H
+#define KURSOVA_HTTPAPI_H
+
+#include <cstdint>
+#include <string>
+
+#include "TermManager.h"
+
+/**
+ * @class HttpApi
+ * @brief Маршрутизує GET-запити і серіалізує відповіді в JSON.
+ *
+ * Маршрути:
+ *
+ *     /terms/{name}   -> {"name","type","definition","references":[...]}
+ *     /complete?q=...[&limit=N] -> {"prefix","count","results":[назви]}
+ *     /search?q=...   -> {"query","count","results":[назви]}
+ *     /chain/{name}   -> {"name","count","steps":[{"level","name","kind"}]}
+ *     /stats          -> {"total","primitive","composite"}
+ *     /query?q=...[&explain=1] -> {"query","count","results":[назви][,"plan"]}
+ *
+ * Помилки повертаються як {"error":"<код>"} з відповідним статусом.
+ * Тіло дописується в переданий буфер без проміжних рядків.
+ */
+class HttpApi {
+private:
+    const TermManager &termManager;
+
+public:
+    /**
+     * @brief Конструктор.
+     * @param termManager База термінів (лише методи читання).
+     */
+    explicit HttpApi(const TermManager &termManager);
+
+    /**
+     * @brief Обробляє ціль запиту ("/шлях?параметри").
+     * @param target Ціль з рядка запиту HTTP.
+     * @param body Буфер, у який дописується JSON.
+     * @return HTTP-статус (200, 400, 404).
+     */
+    int Handle(const std::string &target, std::string &body) const;
+
+    /**
+     * @brief Декодує %XX і '+' (лише для параметрів запиту).
+     * @param value Закодований рядок.
+     * @param plusIsSpace Чи означає '+' пробіл.
+     * @param out Результат.
+     * @return false для некоректного %-кодування.
+     */
+    static bool UrlDecode(const std::string &value, bool plusIsSpace, std::string &out);
+
+    /**
+     * @brief Кодує все, крім неспеціальних ASCII-символів, як %XX.
+     */
+    static std::string UrlEncode(const std::string &value);
+
+    /**
+     * @brief Дописує рядок JSON у лапках з екрануванням.
+     */
+    static void AppendJsonString(std::string &out, const std::string &value);
+
+    /**
+     * @brief Дописує {"error":"<код>"} і повертає статус.
+     */
+    static int Error(std::string &body, int status, const char *code);
+
+private:
+    /**
+     * @brief Дописує число без тимчасових рядків.
+     */
+    static void AppendNumber(std::string &out, uint64_t value);
+
+    /**
+     * @brief Шукає параметр у рядку запиту і декодує його.
+     * @return false, якщо параметра немає або він некоректний.
+     */
+    static bool QueryParam(const std::string &query, const std::string &key, std::string &out);
+
+};
+
+#endif //KURSOVA_HTTPAPI_H
@@ -0,0 +1,247 @@
+/**
+ * @file HttpServer.cpp
+ * @brief Реалізація вбудованого HTTP/1.1 сервера.
+ */
+
+#include "HttpServer.h"
+
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+#include <cerrno>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// -------------------------------------------------------------
+//                     CONSTRUCTOR
+// -------------------------------------------------------------
+
+/**
+ * @brief Конструктор.
+ * @param termManager База термінів.
+ * @param port TCP-порт.
+ */
+HttpServer::HttpServer(const TermManager &termManager, uint16_t port)
+        : api(termManager), port(port) {}
+
+// -------------------------------------------------------------
+//                     RESPONSES
+// -------------------------------------------------------------
+
+/**
+ * @brief Текстова фраза для статусу.
+ */
+static const char *ReasonPhrase(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 413: return "Payload Too Large";
+        case 431: return "Request Header Fields Too Large";
+        case 501: return "Not Implemented";
+        case 505: return "HTTP Version Not Supported";
+        default:  return "Error";
+    }
+}
+
+/**
+ * @brief Формує відповідь з тілом із буфера body.
+ */
+void HttpServer::AppendResponse(std::string &out, int status, bool keepAlive, bool withBody) const {
+    char digits[24];
+
+    out.append("HTTP/1.1 ");
+    out.append(digits, std::to_chars(digits, digits + sizeof(digits), status).ptr);
+    out.push_back(' ');
+    out.append(ReasonPhrase(status));
+    out.append("\r\nContent-Type: application/json; charset=utf-8\r\nContent-Length: ");
+    out.append(digits, std::to_chars(digits, digits + sizeof(digits), body.size()).ptr);
+    if (status == 405) out.append("\r\nAllow: GET, HEAD");
+    out.append(keepAlive ? "\r\nConnection: keep-alive\r\n\r\n" : "\r\nConnection: close\r\n\r\n");
+    if (withBody) out.append(body);
+}
+
+// -------------------------------------------------------------
+//                     PARSING
+// -------------------------------------------------------------
+
+/**
+ * @brief Перевіряє назву заголовка in[start, colon) без урахування регістру.
+ */
+bool HttpServer::HeaderIs(const std::string &in, size_t start, size_t colon, const char *name) {
+    size_t length = std::strlen(name);
+    if (colon - start != length) return false;
+    for (size_t i = 0; i < length; ++i) {
+        if (std::tolower(static_cast<unsigned char>(in[start + i])) != name[i]) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Обробляє всі повні запити з буфера з'єднання.
+ *
+ * Незавершений запит лишається в буфері до наступного читання.
+ * Після помилки розбору або "Connection: close" решта вхідних даних
+ * відкидається, а з'єднання закривається після відправлення відповіді.
+ * @return Завжди true: помилки протоколу повідомляються відповіддю.
+ */
+bool HttpServer::ProcessRequests(Connection &conn) {
+    const std::string &in = conn.in;
+    size_t pos = 0;
+
+    while (!conn.closing && CanAcceptMore(conn)) {
+        size_t headerEnd = in.find("\r\n\r\n", pos);
+        if (headerEnd == std::string::npos) {
+            if (in.size() - pos > kMaxHeaderBytes) {
+                body.clear();
+                HttpApi::Error(body, 431, "headers_too_large");
+                AppendResponse(conn.out, 431, false, true);
+                conn.closing = true;
+            }
+            break;
+        }
+
+        // Рядок запиту: МЕТОД ЦІЛЬ ВЕРСІЯ
+        size_t lineEnd = in.find("\r\n", pos);
+        size_t sp1 = in.find(' ', pos);
+        size_t sp2 = sp1 < lineEnd ? in.find(' ', sp1 + 1) : std::string::npos;
+        int status = 0;
+        bool http11 = false;
+        if (sp1 >= lineEnd || sp2 >= lineEnd) {
+            status = 400;
+        } else if (in.compare(sp2 + 1, lineEnd - sp2 - 1, "HTTP/1.1") == 0) {
+            http11 = true;
+        } else if (in.compare(sp2 + 1, lineEnd - sp2 - 1, "HTTP/1.0") != 0) {
+            status = 505;
+        }
+
+        // Заголовки, що впливають на розбір: Connection, Content-Length, Transfer-Encoding
+        bool keepAlive = http11;
+        size_t bodyLength = 0;
+        for (size_t line = lineEnd + 2; status == 0 && line < headerEnd + 2;) {
+            size_t end = in.find("\r\n", line);
+            size_t colon = in.find(':', line);
+            if (colon >= end) {
+                status = 400;
+                break;
+            }
+            size_t value = colon + 1;
+            while (value < end && (in[value] == ' ' || in[value] == '\t')) value++;
+
+            if (HeaderIs(in, line, colon, "connection")) {
+                std::string token = in.substr(value, end - value);
+                for (auto &c : token) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                if (token.find("close") != std::string::npos) keepAlive = false;
+                else if (token.find("keep-alive") != std::string::npos) keepAlive = true;
+            } else if (HeaderIs(in, line, colon, "content-length")) {
+                auto result = std::from_chars(in.data() + value, in.data() + end, bodyLength);
+                if (result.ec != std::errc()) status = 400;
+                else if (bodyLength > kMaxBodyBytes) status = 413;
+            } else if (HeaderIs(in, line, colon, "transfer-encoding")) {
+                status = 501;
+            }
+            line = end + 2;
+        }
+
+        size_t requestEnd = headerEnd + 4 + bodyLength;
+        if (status == 0 && requestEnd > in.size()) break;  // тіло ще не надійшло
+
+        body.clear();
+        bool withBody = true;
+        if (status != 0) {
+            keepAlive = false;
+            HttpApi::Error(body, status, "bad_request");
+        } else if (in.compare(pos, sp1 - pos, "GET") == 0 || in.compare(pos, sp1 - pos, "HEAD") == 0) {
+            withBody = in[pos] == 'G';
+            status = api.Handle(in.substr(sp1 + 1, sp2 - sp1 - 1), body);
+        } else {
+            status = 405;
+            HttpApi::Error(body, status, "method_not_allowed");
+        }
+        AppendResponse(conn.out, status, keepAlive, withBody);
+
+        if (!keepAlive) {
+            conn.closing = true;
+            pos = in.size();
+            break;
+        }
+        pos = requestEnd;
+    }
+
+    conn.in.erase(0, pos);
+    return true;
+}
+
+/**
+ * @brief Заголовки, порожній рядок і тіло найбільшого допустимого запиту.
+ */
+size_t HttpServer::MaxRequestBytes() const {
+    return kMaxHeaderBytes + 4 + kMaxBodyBytes;
+}
+
+#ifdef __linux__
+
+// -------------------------------------------------------------
+//                     SOCKET
+// -------------------------------------------------------------
+
+/**
+ * @brief Створює неблокувальний TCP-сокет на 127.0.0.1:port.
+ * @return Дескриптор або -1.
+ */
+int HttpServer::OpenListener() {
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        std::cerr << "[ERROR] socket: " << std::strerror(errno) << std::endl;
+        return -1;
+    }
+
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 ||
+        ::listen(fd, SOMAXCONN) < 0) {
+        std::cerr << "[ERROR] bind/listen 127.0.0.1:" << port << ": " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        return -1;
+    }
+
+    std::cout << "[INFO] HTTP API слухає http://127.0.0.1:" << port << "/" << std::endl;
+    return fd;
+}
+
+/**
+ * @brief Вимикає затримку Нейгла: відповідь іде одним записом.
+ */
+void HttpServer::ConfigureConnection(int fd) {
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+#else
+
+/**
+ * @brief TCP-сервер на epoll доступний лише в Linux.
+ */
+int HttpServer::OpenListener() {
+    return -1;
+}
+
+/**
+ * @brief Нічого не робить поза Linux.
+ */
+void HttpServer::ConfigureConnection(int) {}
+
+#endif
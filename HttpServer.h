@@ -0,0 +1,81 @@
+/**
+ * @file HttpServer.h
+ * @brief Оголошення вбудованого HTTP/1.1 сервера для JSON API.
+ */
+
+#ifndef KURSOVA_HTTPSERVER_H
+#define KURSOVA_HTTPSERVER_H
+
+#include <cstdint>
+#include <string>
+
+#include "SocketServer.h"
+#include "HttpApi.h"
+
+/**
+ * @class HttpServer
+ * @brief Мінімальний HTTP/1.1 сервер на localhost поверх SocketServer.
+ *
+ * Підтримує GET і HEAD, постійні з'єднання (keep-alive за замовчуванням
+ * для HTTP/1.1, "Connection: close" закриває після відповіді) та
+ * конвеєрні запити. Тіло запиту (Content-Length) пропускається;
+ * chunked-тіла не підтримуються. Слухає лише 127.0.0.1.
+ */
+class HttpServer : public SocketServer {
+public:
+    /**
+     * @brief Конструктор.
+     * @param termManager Завантажена база термінів.
+     * @param port TCP-порт на 127.0.0.1.
+     */
+    HttpServer(const TermManager &termManager, uint16_t port);
+
+protected:
+    /**
+     * @brief Створює TCP-сокет на 127.0.0.1:port.
+     */
+    int OpenListener() override;
+
+    /**
+     * @brief Вимикає алгоритм Нейгла для коротких відповідей.
+     */
+    void ConfigureConnection(int fd) override;
+
+    /**
+     * @brief Розбирає повні HTTP-запити з вхідного буфера і формує відповіді.
+     */
+    bool ProcessRequests(Connection &conn) override;
+
+    /**
+     * @brief Заголовки і тіло найбільшого допустимого запиту.
+     */
+    size_t MaxRequestBytes() const override;
+
+private:
+    /** @brief Максимальний розмір рядка запиту з заголовками. */
+    static constexpr size_t kMaxHeaderBytes = 16 * 1024;
+
+    /** @brief Максимальний розмір тіла запиту, яке ще можна пропустити. */
+    static constexpr size_t kMaxBodyBytes = 64 * 1024;
+
+    /**
+     * @brief Дописує рядок статусу, заголовки і тіло у вихідний буфер.
+     * @param out Вихідний буфер з'єднання.
+     * @param status HTTP-статус.
+     * @param keepAlive Чи лишається з'єднання відкритим.
+     * @param withBody false для HEAD.
+     */
+    void AppendResponse(std::string &out, int status, bool keepAlive, bool withBody) const;
+
+    /**
+     * @brief Порівнює назву заголовка без урахування регістру.
+     */
+    static bool HeaderIs(const std::string &in, size_t start, size_t colon, const char *name);
+
+    HttpApi api;
+    uint16_t port;
+    /** @brief Тіло поточної відповіді (перевикористовується між запитами). */
+    std::string body;
+};
+
+#endif //KURSOVA_HTTPSERVER_H
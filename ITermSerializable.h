@@ -14,7 +14,8 @@
  *
  * Визначає контракт для будь-якого класу, який потребує збереження свого стану
  * у текстовому форматі (наприклад, для запису у файл CSV).
- * Класи-спадкоємці зобов'язані реалізувати метод Serialize().
+ * Класи-спадкоємці зобов'язані реалізувати метод SerializeTo(), який дописує
+ * рядок у буфер викликача; Serialize() побудований на ньому.
  */
 class ITermSerializable {
 public:
@@ -27,15 +28,27 @@ public:
     virtual ~ITermSerializable() = default;
 
     /**
-     * @brief Перетворює об'єкт у рядковий формат.
+     * @brief Дописує об'єкт у рядковому форматі в кінець out.
+     *
+     * Метод має дописати всі дані об'єкта, розділені визначеним символом
+     * (наприклад, крапкою з комою), без переводу рядка. Проміжних рядків
+     * не створює: при збереженні бази один буфер перевикористовується для
+     * всіх термінів, тож після першого розширення виділень пам'яті немає.
      *
-     * Метод має повертати рядок, що містить всі дані об'єкта,
-     * розділені визначеним символом (наприклад, крапкою з комою),
-     * готовий для запису у файл.
+     * @param out Буфер викликача.
+     */
+    virtual void SerializeTo(std::string &out) const = 0;
+
+    /**
+     * @brief Перетворює об'єкт у рядковий формат.
      *
-     * @return std::string Рядок із серіалізованими даними.
+     * @return std::string Рядок із серіалізованими даними (те саме, що дописує SerializeTo).
      */
-    virtual std::string Serialize() const = 0;
+    virtual std::string Serialize() const {
+        std::string out;
+        SerializeTo(out);
+        return out;
+    }
 };
 
 #endif // ITERM_SERIALIZABLE_H
\ No newline at end of file
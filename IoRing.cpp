@@ -0,0 +1,237 @@
+/**
+ * @file IoRing.cpp
+ * @brief Реалізація обгортки над io_uring через системні виклики.
+ */
+
+#include "IoRing.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define KURSOVA_IO_URING 1
+#endif
+#endif
+
+#ifdef KURSOVA_IO_URING
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// -------------------------------------------------------------
+//                     SETUP
+// -------------------------------------------------------------
+
+/**
+ * @brief io_uring_setup і відображення кілець у пам'ять.
+ *
+ * Новіші ядра (IORING_FEAT_SINGLE_MMAP) віддають обидва кільця одним
+ * відображенням; для старіших робиться два.
+ */
+IoRing::IoRing(unsigned entries) {
+    io_uring_params params{};
+    ringFd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+    if (ringFd < 0) return;
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single) sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+
+    sqRing = ::mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    ringFd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED) {
+        sqRing = nullptr;
+        return;
+    }
+    if (single) {
+        cqRing = sqRing;
+    } else {
+        cqRing = ::mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        ringFd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED) {
+            cqRing = nullptr;
+            return;
+        }
+    }
+
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    sqes = ::mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  ringFd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        sqes = nullptr;
+        return;
+    }
+
+    auto *sq = static_cast<char *>(sqRing);
+    sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sqMask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    sqEntries = params.sq_entries;
+
+    auto *cq = static_cast<char *>(cqRing);
+    cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cqMask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes = cq + params.cq_off.cqes;
+}
+
+/**
+ * @brief Звільняє відображення і дескриптор.
+ */
+IoRing::~IoRing() {
+    if (sqes) ::munmap(sqes, sqesSize);
+    if (cqRing && cqRing != sqRing) ::munmap(cqRing, cqRingSize);
+    if (sqRing) ::munmap(sqRing, sqRingSize);
+    if (ringFd >= 0) ::close(ringFd);
+}
+
+/**
+ * @brief Кільце створено і всі відображення на місці.
+ */
+bool IoRing::IsOpen() const {
+    return ringFd >= 0 && sqRing && cqRing && sqes;
+}
+
+// -------------------------------------------------------------
+//                     SUBMISSION
+// -------------------------------------------------------------
+
+/**
+ * @brief Заповнює елемент черги і публікує новий хвіст (release для ядра).
+ */
+bool IoRing::Queue(uint8_t opcode, int fd, const void *buffer, uint32_t length, uint64_t offset, uint64_t tag) {
+    if (!IsOpen()) return false;
+    unsigned tail = *sqTail;
+    unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+    if (tail - head >= sqEntries) return false;
+
+    unsigned index = tail & *sqMask;
+    auto *sqe = static_cast<io_uring_sqe *>(sqes) + index;
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(buffer);
+    sqe->len = length;
+    sqe->off = offset;
+    sqe->user_data = tag;
+
+    sqArray[index] = index;
+    __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+    unsubmitted++;
+    return true;
+}
+
+/**
+ * @brief IORING_OP_READ за зміщенням.
+ */
+bool IoRing::Read(int fd, void *buffer, uint32_t length, uint64_t offset, uint64_t tag) {
+    return Queue(IORING_OP_READ, fd, buffer, length, offset, tag);
+}
+
+/**
+ * @brief IORING_OP_WRITE за зміщенням.
+ */
+bool IoRing::Write(int fd, const void *buffer, uint32_t length, uint64_t offset, uint64_t tag) {
+    return Queue(IORING_OP_WRITE, fd, buffer, length, offset, tag);
+}
+
+/**
+ * @brief io_uring_enter без очікування.
+ */
+bool IoRing::Submit() {
+    while (unsubmitted > 0) {
+        long submitted = ::syscall(__NR_io_uring_enter, ringFd, unsubmitted, 0, 0, nullptr, 0);
+        if (submitted < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        unsubmitted -= static_cast<unsigned>(submitted);
+    }
+    return true;
+}
+
+// -------------------------------------------------------------
+//                     COMPLETION
+// -------------------------------------------------------------
+
+/**
+ * @brief Забирає одне завершення; якщо їх немає — чекає в io_uring_enter.
+ */
+bool IoRing::WaitOne(uint64_t &tag, int32_t &result) {
+    if (!Submit()) return false;
+    while (true) {
+        unsigned head = *cqHead;
+        if (head != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+            const auto *cqe = static_cast<const io_uring_cqe *>(cqes) + (head & *cqMask);
+            tag = cqe->user_data;
+            result = cqe->res;
+            __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+            return true;
+        }
+
+        long rc = ::syscall(__NR_io_uring_enter, ringFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+        if (rc < 0 && errno != EINTR) return false;
+    }
+}
+
+/**
+ * @brief Пробне кільце на 2 елементи; результат кешується.
+ */
+bool IoRing::Supported() {
+    static const bool supported = IoRing(2).IsOpen();
+    return supported;
+}
+
+#else
+
+/**
+ * @brief Без io_uring кільце ніколи не відкривається.
+ */
+IoRing::IoRing(unsigned) {}
+
+/**
+ * @brief Нічого звільняти.
+ */
+IoRing::~IoRing() = default;
+
+/**
+ * @brief Завжди false.
+ */
+bool IoRing::IsOpen() const { return false; }
+
+/**
+ * @brief Недоступно на цій платформі.
+ */
+bool IoRing::Queue(uint8_t, int, const void *, uint32_t, uint64_t, uint64_t) { return false; }
+
+/**
+ * @brief Недоступно на цій платформі.
+ */
+bool IoRing::Read(int, void *, uint32_t, uint64_t, uint64_t) { return false; }
+
+/**
+ * @brief Недоступно на цій платформі.
+ */
+bool IoRing::Write(int, const void *, uint32_t, uint64_t, uint64_t) { return false; }
+
+/**
+ * @brief Недоступно на цій платформі.
+ */
+bool IoRing::Submit() { return false; }
+
+/**
+ * @brief Недоступно на цій платформі.
+ */
+bool IoRing::WaitOne(uint64_t &, int32_t &) { return false; }
+
+/**
+ * @brief io_uring є лише в Linux.
+ */
+bool IoRing::Supported() { return false; }
+
+#endif
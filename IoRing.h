@@ -0,0 +1,116 @@
+/**
+ * @file IoRing.h
+ * @brief Оголошення мінімальної обгортки над io_uring (Linux).
+ */
+
+#ifndef KURSOVA_IORING_H
+#define KURSOVA_IORING_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Спосіб файлового вводу-виводу для завантаження і збереження бази.
+ */
+enum class IoBackend {
+    Posix,  ///< Звичайні read/pwrite: кожен виклик блокує потік до завершення.
+    Uring   ///< io_uring: кілька запитів у польоті, потік тим часом працює далі.
+};
+
+/**
+ * @class IoRing
+ * @brief Кільце io_uring для асинхронних read/write за зміщенням.
+ *
+ * Кільця створюються системними викликами io_uring_setup / io_uring_enter
+ * і відображаються через mmap, без liburing. Запит ставиться в чергу
+ * Read/Write з міткою tag, відправляється Submit (або разом з очікуванням)
+ * і повертається з WaitOne як пара (tag, результат), де результат — кількість
+ * байтів або -errno, як у read/write.
+ *
+ * Якщо ядро не підтримує io_uring (ENOSYS, заборона seccomp тощо), IsOpen()
+ * повертає false і викликачі переходять на POSIX-шлях.
+ * Об'єкт не потокобезпечний: одне кільце — один потік.
+ */
+class IoRing {
+public:
+    /**
+     * @brief Створює кільце.
+     * @param entries Розмір черги відправлення (округлюється ядром до степеня 2).
+     */
+    explicit IoRing(unsigned entries);
+
+    /**
+     * @brief Знімає відображення і закриває дескриптор кільця.
+     */
+    ~IoRing();
+
+    IoRing(const IoRing &) = delete;
+    IoRing &operator=(const IoRing &) = delete;
+
+    /**
+     * @brief Чи створено кільце.
+     */
+    bool IsOpen() const;
+
+    /**
+     * @brief Ставить у чергу читання length байтів з offset.
+     * @return false, якщо черга відправлення повна.
+     */
+    bool Read(int fd, void *buffer, uint32_t length, uint64_t offset, uint64_t tag);
+
+    /**
+     * @brief Ставить у чергу запис length байтів за offset.
+     * @return false, якщо черга відправлення повна.
+     */
+    bool Write(int fd, const void *buffer, uint32_t length, uint64_t offset, uint64_t tag);
+
+    /**
+     * @brief Відправляє ядру всі поставлені в чергу запити.
+     * @return false, якщо io_uring_enter завершився помилкою.
+     */
+    bool Submit();
+
+    /**
+     * @brief Відправляє чергу і чекає одне завершення.
+     * @param tag Мітка завершеного запиту.
+     * @param result Кількість байтів або -errno.
+     * @return false, якщо очікування завершилось помилкою.
+     */
+    bool WaitOne(uint64_t &tag, int32_t &result);
+
+    /**
+     * @brief Чи підтримує ядро io_uring (перевіряється один раз).
+     */
+    static bool Supported();
+
+private:
+    /**
+     * @brief Заповнює наступний елемент черги відправлення.
+     */
+    bool Queue(uint8_t opcode, int fd, const void *buffer, uint32_t length, uint64_t offset, uint64_t tag);
+
+    int ringFd = -1;
+
+    void *sqRing = nullptr;
+    size_t sqRingSize = 0;
+    void *cqRing = nullptr;
+    size_t cqRingSize = 0;
+    void *sqes = nullptr;
+    size_t sqesSize = 0;
+
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned *sqMask = nullptr;
+    unsigned *sqArray = nullptr;
+    unsigned sqEntries = 0;
+
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    unsigned *cqMask = nullptr;
+    void *cqes = nullptr;
+
+    /** @brief Поставлено в чергу, але ще не відправлено ядру. */
+    unsigned unsubmitted = 0;
+};
+
+#endif //KURSOVA_IORING_H
@@ -0,0 +1,196 @@
+/**
+ * @file LineReader.cpp
+ * @brief Реалізація блочного читання по рядках.
+ */
+
+#include "LineReader.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/stat.h>
+#endif
+
+// -------------------------------------------------------------
+//                     CONSTRUCTOR / DESTRUCTOR
+// -------------------------------------------------------------
+
+/**
+ * @brief Відкриває файл і, якщо просили io_uring, створює кільце та слоти.
+ */
+LineReader::LineReader(const std::string &path, IoBackend backend) {
+    file = std::fopen(path.c_str(), "rb");
+    if (!file) return;
+
+#ifdef __linux__
+    struct stat info {};
+    if (backend == IoBackend::Uring && ::fstat(fileno(file), &info) == 0) {
+        auto candidate = std::make_unique<IoRing>(static_cast<unsigned>(kQueueDepth));
+        if (candidate->IsOpen()) {
+            ring = std::move(candidate);
+            fileSize = static_cast<uint64_t>(info.st_size);
+            slots.resize(kQueueDepth);
+            for (auto &slot : slots) slot.data.reset(new char[kBlockSize]);
+        }
+    }
+#else
+    (void) backend;
+#endif
+
+    if (!ring) {
+        slots.resize(1);
+        slots[0].data.reset(new char[kBlockSize]);
+    }
+}
+
+/**
+ * @brief Ядро ще може писати в буфери слотів, тому спершу чекаємо всі читання.
+ */
+LineReader::~LineReader() {
+    while (ring && std::any_of(slots.begin(), slots.end(), [](const Slot &s) { return s.pending; })) {
+        uint64_t tag;
+        int32_t result;
+        if (!ring->WaitOne(tag, result)) break;
+        if (tag < slots.size()) slots[tag].pending = false;
+    }
+    if (file) std::fclose(file);
+}
+
+/**
+ * @brief Файл відкрито.
+ */
+bool LineReader::IsOpen() const {
+    return file != nullptr;
+}
+
+/**
+ * @brief Фактичний спосіб читання.
+ */
+IoBackend LineReader::GetBackend() const {
+    return ring ? IoBackend::Uring : IoBackend::Posix;
+}
+
+/**
+ * @brief Опис помилки читання.
+ */
+const std::string &LineReader::Error() const {
+    return error;
+}
+
+/**
+ * @brief Запам'ятовує першу помилку.
+ */
+bool LineReader::Fail(const std::string &what) {
+    if (error.empty()) error = what;
+    return false;
+}
+
+// -------------------------------------------------------------
+//                     LINES
+// -------------------------------------------------------------
+
+/**
+ * @brief Шукає '\n' у поточному блоці; рядок, що переходить межу блоку, склеюється.
+ */
+bool LineReader::Next(std::string &line) {
+    line.clear();
+    if (!file || !error.empty()) return false;
+
+    while (true) {
+        if (pos < size) {
+            const char *begin = data + pos;
+            const auto *end = static_cast<const char *>(std::memchr(begin, '\n', size - pos));
+            if (end) {
+                line.append(begin, end);
+                pos = static_cast<size_t>(end - data) + 1;
+                return true;
+            }
+            line.append(begin, data + size);
+            pos = size;
+        }
+        if (!NextBlock()) return error.empty() && !line.empty();
+    }
+}
+
+// -------------------------------------------------------------
+//                     BLOCKS
+// -------------------------------------------------------------
+
+/**
+ * @brief Ставить читання наступних блоків у всі вільні слоти.
+ */
+bool LineReader::SubmitReads() {
+    while (inFlight < slots.size() && nextOffset < fileSize) {
+        Slot &slot = slots[(head + inFlight) % slots.size()];
+        slot.offset = nextOffset;
+        slot.wanted = static_cast<size_t>(std::min<uint64_t>(kBlockSize, fileSize - nextOffset));
+        slot.filled = 0;
+        slot.pending = true;
+        if (!ring->Read(fileno(file), slot.data.get(), static_cast<uint32_t>(slot.wanted), slot.offset,
+                        (head + inFlight) % slots.size())) {
+            slot.pending = false;
+            return Fail("io_uring: черга відправлення переповнена");
+        }
+        nextOffset += slot.wanted;
+        inFlight++;
+    }
+    return ring->Submit() || Fail(std::string("io_uring_enter: ") + std::strerror(errno));
+}
+
+/**
+ * @brief Переходить до наступного блоку.
+ *
+ * POSIX: один fread у єдиний буфер. io_uring: звільнений слот одразу
+ * отримує нове читання, далі чекаємо завершення читання голови черги
+ * (інші завершення запам'ятовуються у своїх слотах). Неповне читання
+ * дочитується ще одним запитом у той самий слот.
+ */
+bool LineReader::NextBlock() {
+    data = nullptr;
+    size = pos = 0;
+
+    if (!ring) {
+        size_t n = std::fread(slots[0].data.get(), 1, kBlockSize, file);
+        if (n == 0) {
+            return std::ferror(file) ? Fail(std::string("fread: ") + std::strerror(errno)) : false;
+        }
+        data = slots[0].data.get();
+        size = n;
+        return true;
+    }
+
+    if (holdingHead) {
+        head = (head + 1) % slots.size();
+        inFlight--;
+        holdingHead = false;
+    }
+    if (!SubmitReads()) return false;
+    if (inFlight == 0) return false;
+
+    Slot &current = slots[head];
+    while (current.pending) {
+        uint64_t tag;
+        int32_t result;
+        if (!ring->WaitOne(tag, result)) return Fail(std::string("io_uring_enter: ") + std::strerror(errno));
+        if (tag >= slots.size()) continue;
+
+        Slot &done = slots[tag];
+        done.pending = false;
+        if (result < 0) return Fail(std::string("io_uring read: ") + std::strerror(-result));
+        done.filled += static_cast<size_t>(result);
+
+        if (result > 0 && done.filled < done.wanted) {
+            done.pending = ring->Read(fileno(file), done.data.get() + done.filled,
+                                      static_cast<uint32_t>(done.wanted - done.filled),
+                                      done.offset + done.filled, tag);
+            if (!done.pending || !ring->Submit()) return Fail("io_uring: не вдалося дочитати блок");
+        }
+    }
+
+    holdingHead = true;
+    data = current.data.get();
+    size = current.filled;
+    return size > 0;
+}
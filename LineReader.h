@@ -0,0 +1,113 @@
+/**
+ * @file LineReader.h
+ * @brief Оголошення блочного читання текстового файлу по рядках.
+ */
+
+#ifndef KURSOVA_LINEREADER_H
+#define KURSOVA_LINEREADER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "IoRing.h"
+
+/**
+ * @class LineReader
+ * @brief Читає файл великими блоками і видає рядки (як std::getline).
+ *
+ * POSIX-шлях читає блок за блоком (fread). Шлях io_uring тримає в польоті
+ * кілька читань наступних блоків, поки розбираються рядки поточного, тож
+ * очікування диска перекривається з розбором. Якщо кільце створити не
+ * вдалося, використовується POSIX-шлях (GetBackend() це показує).
+ */
+class LineReader {
+public:
+    /** @brief Розмір одного блоку читання. */
+    static constexpr size_t kBlockSize = 1 << 20;
+
+    /** @brief Скільки блоків io_uring читає наперед. */
+    static constexpr size_t kQueueDepth = 4;
+
+    /**
+     * @brief Відкриває файл.
+     * @param path Шлях до файлу.
+     * @param backend Бажаний спосіб читання.
+     */
+    LineReader(const std::string &path, IoBackend backend);
+
+    /**
+     * @brief Дочікується незавершених читань і закриває файл.
+     */
+    ~LineReader();
+
+    LineReader(const LineReader &) = delete;
+    LineReader &operator=(const LineReader &) = delete;
+
+    /**
+     * @brief Чи відкрито файл.
+     */
+    bool IsOpen() const;
+
+    /**
+     * @brief Читає наступний рядок без символу '\n'.
+     * @param line Куди записати рядок (пам'ять перевикористовується).
+     * @return false наприкінці файлу або після помилки читання.
+     */
+    bool Next(std::string &line);
+
+    /**
+     * @brief Фактичний спосіб читання (Posix, якщо io_uring недоступний).
+     */
+    IoBackend GetBackend() const;
+
+    /**
+     * @brief Опис помилки читання (порожньо, якщо помилок не було).
+     */
+    const std::string &Error() const;
+
+private:
+    /**
+     * @brief Один блок читання io_uring.
+     */
+    struct Slot {
+        std::unique_ptr<char[]> data;
+        uint64_t offset = 0;
+        size_t wanted = 0;
+        size_t filled = 0;
+        bool pending = false;
+    };
+
+    /**
+     * @brief Робить поточним наступний блок файлу.
+     * @return false наприкінці файлу або після помилки.
+     */
+    bool NextBlock();
+
+    /**
+     * @brief Ставить читання у вільні слоти (до kQueueDepth наперед).
+     */
+    bool SubmitReads();
+
+    /**
+     * @brief Запам'ятовує помилку.
+     */
+    bool Fail(const std::string &what);
+
+    std::FILE *file = nullptr;
+    std::unique_ptr<IoRing> ring;
+    std::vector<Slot> slots;
+    uint64_t fileSize = 0;
+    uint64_t nextOffset = 0;
+    size_t head = 0;
+    size_t inFlight = 0;
+    bool holdingHead = false;
+
+    const char *data = nullptr;
+    size_t size = 0;
+    size_t pos = 0;
+    std::string error;
+};
+
+#endif //KURSOVA_LINEREADER_H
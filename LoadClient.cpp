@@ -0,0 +1,349 @@
+/**
+ * @file LoadClient.cpp
+ * @brief Реалізація генератора навантаження для сервера запитів.
+ */
+
+#include "LoadClient.h"
+#include "Utils.h"
+#include "HttpApi.h"
+#include "ShardStore.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// -------------------------------------------------------------
+//                     CONSTRUCTOR
+// -------------------------------------------------------------
+
+/**
+ * @brief Конструктор.
+ * @param address Шлях до сокета або TCP-порт.
+ * @param termsFile Файл бази для вибору назв.
+ */
+LoadClient::LoadClient(const std::string &address, const std::string &termsFile)
+        : address(address), termsFile(termsFile) {}
+
+// -------------------------------------------------------------
+//                     REQUESTS
+// -------------------------------------------------------------
+
+/**
+ * @brief Зчитує назви термінів і довші слова з визначень (з файлу або шардів).
+ */
+void LoadClient::LoadSamples() {
+    names.clear();
+    words.clear();
+
+    // База з шардів: ті самі рядки CSV, розкладені по файлах шардів
+    std::vector<std::string> files{termsFile};
+    if (ShardStore::IsDirectory(termsFile)) {
+        ShardStore store(termsFile);
+        files.clear();
+        for (size_t shard = 0; shard < store.GetShardCount(); ++shard) {
+            if (!store.CurrentPath(shard).empty()) files.push_back(store.CurrentPath(shard));
+        }
+    }
+
+    for (const auto &file : files) {
+        std::ifstream in(file);
+        std::string line;
+        while (std::getline(in, line)) {
+            auto parts = Utils::Split(line, ';');
+            if (parts.size() < 3) continue;
+            names.push_back(Utils::Unescape(parts[1]));
+
+            // Кожне п'яте визначення дає слово для запитів search
+            if (names.size() % 5 != 0) continue;
+            std::istringstream definition(Utils::Unescape(parts[2]));
+            std::string word;
+            while (definition >> word) {
+                if (word.size() >= 8) {
+                    words.push_back(word);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Будує запит: 80% find, 10% chain, 8% search, 2% stats.
+ */
+std::string LoadClient::MakeRequest(size_t i) const {
+    // Множник розкидає сусідні номери по всій базі
+    size_t pick = i * 2654435761u;
+    size_t kind = i % 50;
+
+    if (http) {
+        std::string target;
+        if (kind < 4 && !words.empty()) target = "/search?q=" + HttpApi::UrlEncode(words[pick % words.size()]);
+        else if (kind == 4) target = "/stats";
+        else if (kind < 10) target = "/chain/" + HttpApi::UrlEncode(names[pick % names.size()]);
+        else target = "/terms/" + HttpApi::UrlEncode(names[pick % names.size()]);
+        return "GET " + target + " HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    }
+
+    if (kind < 4 && !words.empty()) return "search;" + Utils::Escape(words[pick % words.size()]) + "\n";
+    if (kind == 4) return "stats\n";
+    if (kind < 10) return "chain;" + Utils::Escape(names[pick % names.size()]) + "\n";
+    return "find;" + Utils::Escape(names[pick % names.size()]) + "\n";
+}
+
+#ifdef __linux__
+
+// -------------------------------------------------------------
+//                     WORKER
+// -------------------------------------------------------------
+
+/**
+ * @brief Підключається до Unix-сокета або до 127.0.0.1:порт.
+ * @return Дескриптор або -1.
+ */
+int LoadClient::Connect() const {
+    int fd;
+    int rc;
+    if (http) {
+        fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) return -1;
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<uint16_t>(std::strtoul(address.c_str(), nullptr, 10)));
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        rc = ::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+    } else {
+        fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) return -1;
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, address.c_str(), sizeof(addr.sun_path) - 1);
+        rc = ::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+    }
+    if (rc < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Рахує завершені відповіді.
+ *
+ * Рядковий протокол: відповідь завершує рядок OK або ERR (статус — друге
+ * поле). HTTP: заголовки до порожнього рядка плюс Content-Length байтів тіла;
+ * помилкою вважається будь-який статус, крім 200.
+ */
+size_t LoadClient::TakeResponses(std::string &in, size_t &errors) const {
+    size_t done = 0;
+    size_t pos = 0;
+
+    if (http) {
+        static const std::string lengthHeader = "Content-Length: ";
+        while (true) {
+            size_t headerEnd = in.find("\r\n\r\n", pos);
+            if (headerEnd == std::string::npos) break;
+            size_t field = in.find(lengthHeader, pos);
+            size_t length = 0;
+            if (field != std::string::npos && field < headerEnd) {
+                length = std::strtoul(in.c_str() + field + lengthHeader.size(), nullptr, 10);
+            }
+            if (headerEnd + 4 + length > in.size()) break;
+
+            if (in.compare(pos, 12, "HTTP/1.1 200") != 0) errors++;
+            done++;
+            pos = headerEnd + 4 + length;
+        }
+    } else {
+        size_t eol;
+        while ((eol = in.find('\n', pos)) != std::string::npos) {
+            size_t tab = in.find('\t', pos);
+            if (tab != std::string::npos && tab < eol) {
+                if (in.compare(tab + 1, 3, "OK\t") == 0) {
+                    done++;
+                } else if (in.compare(tab + 1, 4, "ERR\t") == 0) {
+                    done++;
+                    errors++;
+                }
+            }
+            pos = eol + 1;
+        }
+    }
+
+    in.erase(0, pos);
+    return done;
+}
+
+/**
+ * @brief Надсилає count запитів, тримаючи до depth без відповіді.
+ *
+ * Оскільки сервер відповідає у порядку запитів, затримка рахується
+ * від найстарішого запиту без відповіді.
+ */
+void LoadClient::Worker(size_t count, size_t seed, size_t depth, Result &result) const {
+    using Clock = std::chrono::steady_clock;
+
+    int fd = Connect();
+    if (fd < 0) {
+        result.failed = true;
+        return;
+    }
+
+    std::deque<Clock::time_point> inFlight;
+    std::string out;
+    std::string in;
+    char chunk[64 * 1024];
+    size_t sentCount = 0;
+    size_t doneCount = 0;
+    result.latenciesUs.reserve(count);
+
+    while (doneCount < count) {
+        // Доповнюємо конвеєр до depth запитів одним записом
+        out.clear();
+        auto now = Clock::now();
+        while (sentCount < count && inFlight.size() < depth) {
+            out += MakeRequest(seed + sentCount++);
+            inFlight.push_back(now);
+        }
+        for (size_t off = 0; off < out.size();) {
+            ssize_t n = ::send(fd, out.data() + off, out.size() - off, MSG_NOSIGNAL);
+            if (n <= 0) {
+                result.failed = true;
+                ::close(fd);
+                return;
+            }
+            off += static_cast<size_t>(n);
+        }
+
+        ssize_t n = ::read(fd, chunk, sizeof(chunk));
+        if (n <= 0) {
+            result.failed = true;
+            break;
+        }
+        in.append(chunk, static_cast<size_t>(n));
+
+        size_t done = TakeResponses(in, result.errors);
+        auto received = Clock::now();
+        for (size_t i = 0; i < done && !inFlight.empty(); ++i) {
+            auto elapsed = std::chrono::duration<double, std::micro>(received - inFlight.front());
+            result.latenciesUs.push_back(elapsed.count());
+            inFlight.pop_front();
+        }
+        doneCount += done;
+    }
+    ::close(fd);
+}
+
+// -------------------------------------------------------------
+//                     RUN
+// -------------------------------------------------------------
+
+/**
+ * @brief Запускає потоки-з'єднання і друкує підсумки.
+ * @param options Параметри навантаження.
+ * @return false, якщо навантаження не вдалося виконати.
+ */
+bool LoadClient::Run(const Options &options) {
+    http = options.http;
+    LoadSamples();
+    if (names.empty()) {
+        std::cerr << "[ERROR] Немає назв термінів у " << termsFile << std::endl;
+        return false;
+    }
+
+    size_t connections = std::max<size_t>(1, options.connections);
+    size_t depth = std::max<size_t>(1, options.depth);
+    std::vector<Result> results(connections);
+    std::vector<std::thread> threads;
+    threads.reserve(connections);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t c = 0; c < connections; ++c) {
+        // Запити діляться порівну; залишок дістається першим з'єднанням
+        size_t count = options.requests / connections + (c < options.requests % connections ? 1 : 0);
+        threads.emplace_back(&LoadClient::Worker, this, count, c * 1000003, depth, std::ref(results[c]));
+    }
+    for (auto &t : threads) t.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> latencies;
+    size_t errors = 0;
+    size_t failedConnections = 0;
+    for (auto &r : results) {
+        latencies.insert(latencies.end(), r.latenciesUs.begin(), r.latenciesUs.end());
+        errors += r.errors;
+        if (r.failed) failedConnections++;
+    }
+    if (latencies.empty()) {
+        std::cerr << "[ERROR] Не вдалося отримати відповіді від " << address << std::endl;
+        return false;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    auto percentile = [&](double p) {
+        size_t index = static_cast<size_t>(p * static_cast<double>(latencies.size() - 1));
+        return latencies[index];
+    };
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Запитів:         " << latencies.size() << " (помилок ERR: " << errors << ")\n";
+    std::cout << "З'єднань:        " << connections << ", глибина конвеєра: " << depth << "\n";
+    if (failedConnections > 0) std::cout << "Обірваних з'єднань: " << failedConnections << "\n";
+    std::cout << "Час:             " << seconds << " с\n";
+    std::cout << "Пропускна здатність: " << static_cast<double>(latencies.size()) / seconds << " запитів/с\n";
+    std::cout << "Затримка p50:    " << percentile(0.50) << " мкс\n";
+    std::cout << "Затримка p99:    " << percentile(0.99) << " мкс\n";
+    std::cout << "Затримка max:    " << latencies.back() << " мкс" << std::endl;
+    return failedConnections == 0;
+}
+
+#else
+
+/**
+ * @brief Без Unix-сокетів навантаження не виконується.
+ */
+void LoadClient::Worker(size_t, size_t, size_t, Result &result) const {
+    result.failed = true;
+}
+
+/**
+ * @brief Без сокетів підключення неможливе.
+ */
+int LoadClient::Connect() const {
+    return -1;
+}
+
+/**
+ * @brief Без сокетів відповідей немає.
+ */
+size_t LoadClient::TakeResponses(std::string &, size_t &) const {
+    return 0;
+}
+
+/**
+ * @brief Генератор навантаження потребує Linux.
+ */
+bool LoadClient::Run(const Options &) {
+    std::cerr << "[ERROR] Генератор навантаження доступний лише в Linux." << std::endl;
+    return false;
+}
+
+#endif
@@ -0,0 +1,102 @@
+/**
+ * @file LoadClient.h
+ * @brief Оголошення генератора навантаження для сервера запитів.
+ */
+
+#ifndef KURSOVA_LOADCLIENT_H
+#define KURSOVA_LOADCLIENT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class LoadClient
+ * @brief Надсилає запити на сервер (QueryServer або HttpServer) і вимірює затримки.
+ *
+ * Кожне з'єднання обслуговується окремим потоком і тримає в польоті до
+ * depth запитів (pipelining); для HTTP з'єднання постійні (keep-alive). Назви термінів для запитів беруться з файлу
+ * бази. Після завершення виводяться пропускна здатність і перцентилі
+ * затримки (p50, p99, максимум).
+ */
+class LoadClient {
+public:
+    /**
+     * @brief Параметри навантаження.
+     */
+    struct Options {
+        /** @brief Кількість з'єднань (потоків). */
+        size_t connections = 4;
+        /** @brief Загальна кількість запитів. */
+        size_t requests = 100000;
+        /** @brief Скільки запитів одне з'єднання тримає без відповіді. */
+        size_t depth = 16;
+        /** @brief HTTP замість рядкового протоколу Unix-сокета. */
+        bool http = false;
+    };
+
+    /**
+     * @brief Конструктор.
+     * @param address Шлях до Unix-сокета або TCP-порт на 127.0.0.1 (для HTTP).
+     * @param termsFile Файл бази або каталог шардів, з якого беруться назви для запитів.
+     */
+    LoadClient(const std::string &address, const std::string &termsFile);
+
+    /**
+     * @brief Виконує навантаження і друкує звіт.
+     * @param options Параметри.
+     * @return false, якщо не вдалося підключитися або немає назв для запитів.
+     */
+    bool Run(const Options &options);
+
+private:
+    /**
+     * @brief Результат одного з'єднання.
+     */
+    struct Result {
+        std::vector<double> latenciesUs;
+        size_t errors = 0;
+        bool failed = false;
+    };
+
+    /**
+     * @brief Зчитує назви та слова визначень з файлу бази.
+     */
+    void LoadSamples();
+
+    /**
+     * @brief Будує запит номер i (детермінована суміш find/chain/search/stats).
+     */
+    std::string MakeRequest(size_t i) const;
+
+    /**
+     * @brief Підключається до сервера.
+     * @return Дескриптор або -1.
+     */
+    int Connect() const;
+
+    /**
+     * @brief Виділяє з буфера завершені відповіді.
+     * @param in Прочитані байти; оброблені видаляються.
+     * @param errors Лічильник відповідей з помилкою.
+     * @return Кількість завершених відповідей.
+     */
+    size_t TakeResponses(std::string &in, size_t &errors) const;
+
+    /**
+     * @brief Робота одного з'єднання.
+     * @param count Скільки запитів надіслати.
+     * @param seed Зсув для вибору запитів.
+     * @param depth Глибина конвеєра.
+     * @param result Куди записати вимірювання.
+     */
+    void Worker(size_t count, size_t seed, size_t depth, Result &result) const;
+
+    std::string address;
+    std::string termsFile;
+    bool http = false;
+    std::vector<std::string> names;
+    std::vector<std::string> words;
+};
+
+#endif //KURSOVA_LOADCLIENT_H
@@ -0,0 +1,92 @@
+/**
+ * @file MappedFile.cpp
+ * @brief Реалізація відображеного в пам'ять файлу.
+ */
+
+#include "MappedFile.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+#ifdef __linux__
+
+/**
+ * @brief open -> fstat -> mmap; дескриптор одразу закривається (відображення його не потребує).
+ */
+MappedFile::MappedFile(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return;
+
+    struct stat info {};
+    if (::fstat(fd, &info) == 0) {
+        size = static_cast<size_t>(info.st_size);
+        if (size == 0) {
+            open = true;
+        } else {
+            void *mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                data = static_cast<const char *>(mapped);
+                open = true;
+            } else {
+                size = 0;
+            }
+        }
+    }
+    ::close(fd);
+}
+
+/**
+ * @brief munmap.
+ */
+MappedFile::~MappedFile() {
+    if (data) ::munmap(const_cast<char *>(data), size);
+}
+
+#else
+
+/**
+ * @brief Читає файл у буфер цілком.
+ */
+MappedFile::MappedFile(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return;
+    buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    data = buffer.empty() ? nullptr : buffer.data();
+    size = buffer.size();
+    open = true;
+}
+
+/**
+ * @brief Буфер звільняється автоматично.
+ */
+MappedFile::~MappedFile() = default;
+
+#endif
+
+/**
+ * @brief Файл відкрито.
+ */
+bool MappedFile::IsOpen() const {
+    return open;
+}
+
+/**
+ * @brief Початок вмісту.
+ */
+const char *MappedFile::Data() const {
+    return data;
+}
+
+/**
+ * @brief Розмір вмісту.
+ */
+size_t MappedFile::Size() const {
+    return size;
+}
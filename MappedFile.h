@@ -0,0 +1,64 @@
+/**
+ * @file MappedFile.h
+ * @brief Оголошення відображеного в пам'ять файлу лише для читання.
+ */
+
+#ifndef KURSOVA_MAPPEDFILE_H
+#define KURSOVA_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief Вміст файлу, відображений у пам'ять (mmap, лише читання).
+ *
+ * Сторінки підтягуються з кешу ОС при першому зверненні і не рахуються
+ * як пам'ять процесу, тож невикористані частини файлу нічого не коштують.
+ * Відображення тримає сам файл: збереження бази замінює файл через rename
+ * (див. AtomicFile), тому старий вміст лишається доступним, поки живе
+ * об'єкт. На платформах без mmap файл читається в пам'ять цілком.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Відкриває і відображає файл.
+     * @param path Шлях до файлу.
+     */
+    explicit MappedFile(const std::string &path);
+
+    /**
+     * @brief Знімає відображення.
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /**
+     * @brief Чи вдалося відкрити файл.
+     */
+    bool IsOpen() const;
+
+    /**
+     * @brief Початок вмісту (nullptr для порожнього файлу).
+     */
+    const char *Data() const;
+
+    /**
+     * @brief Розмір вмісту в байтах.
+     */
+    size_t Size() const;
+
+private:
+    const char *data = nullptr;
+    size_t size = 0;
+    bool open = false;
+
+#ifndef __linux__
+    /** @brief Вміст файлу там, де mmap не використовується. */
+    std::string buffer;
+#endif
+};
+
+#endif //KURSOVA_MAPPEDFILE_H
@@ -0,0 +1,290 @@
+/**
+ * @file Metrics.cpp
+ * @brief Реалізація лічильників операцій і їх дампу.
+ */
+
+#include "Metrics.h"
+#include "AtomicFile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+
+namespace {
+    /**
+     * @brief Лічильники однієї операції.
+     *
+     * Пише лише потік-власник (звичайні load + store без lock-префікса);
+     * атомарність потрібна, щоб Collect читав їх з іншого потоку без гонки.
+     */
+    struct Counters {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> totalNs{0};
+        std::atomic<uint64_t> maxNs{0};
+        std::array<std::atomic<uint64_t>, Metrics::kBuckets + 1> buckets{};
+    };
+
+    /**
+     * @brief Лічильники всіх операцій одного потоку.
+     */
+    struct Shard {
+        std::array<Counters, Metrics::kOps> ops;
+    };
+
+    /**
+     * @brief Живі шарди потоків і запас завершених потоків.
+     */
+    struct Registry {
+        std::mutex mutex;
+        std::vector<const Shard *> live;
+        Shard retired;
+    };
+
+    /**
+     * @brief Реєстр не знищується: thread_local шарди звертаються до нього й після main.
+     */
+    Registry &GetRegistry() {
+        static Registry *registry = new Registry();
+        return *registry;
+    }
+
+    /**
+     * @brief Додає значення до лічильника, який пише лише поточний потік.
+     */
+    void Bump(std::atomic<uint64_t> &counter, uint64_t value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Додає лічильники одного шарду до підсумку.
+     */
+    void AddShard(const Shard &shard, std::vector<Metrics::OpStats> &stats) {
+        for (size_t op = 0; op < Metrics::kOps; ++op) {
+            const Counters &from = shard.ops[op];
+            Metrics::OpStats &to = stats[op];
+            to.count += from.count.load(std::memory_order_relaxed);
+            to.totalNs += from.totalNs.load(std::memory_order_relaxed);
+            to.maxNs = std::max(to.maxNs, from.maxNs.load(std::memory_order_relaxed));
+            for (size_t b = 0; b <= Metrics::kBuckets; ++b) {
+                to.buckets[b] += from.buckets[b].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Шард потоку: реєструється при першому вимірі, при виході потоку зливається в запас.
+     */
+    struct LocalShard {
+        Shard shard;
+
+        LocalShard() {
+            Registry &registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.live.push_back(&shard);
+        }
+
+        ~LocalShard() {
+            Registry &registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            for (size_t op = 0; op < Metrics::kOps; ++op) {
+                const Counters &from = shard.ops[op];
+                Counters &to = registry.retired.ops[op];
+                to.count.fetch_add(from.count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                to.totalNs.fetch_add(from.totalNs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                uint64_t longest = std::max(to.maxNs.load(std::memory_order_relaxed),
+                                            from.maxNs.load(std::memory_order_relaxed));
+                to.maxNs.store(longest, std::memory_order_relaxed);
+                for (size_t b = 0; b <= Metrics::kBuckets; ++b) {
+                    to.buckets[b].fetch_add(from.buckets[b].load(std::memory_order_relaxed),
+                                            std::memory_order_relaxed);
+                }
+            }
+            registry.live.erase(std::find(registry.live.begin(), registry.live.end(), &shard));
+        }
+    };
+
+    /**
+     * @brief Кошик для тривалості: найменше k, для якого ns <= 2^k мкс.
+     */
+    size_t BucketOf(uint64_t ns) {
+        uint64_t us = (ns + 999) / 1000;
+        if (us <= 1) return 0;
+#if defined(__GNUC__)
+        size_t bucket = 64 - static_cast<size_t>(__builtin_clzll(us - 1));
+#else
+        size_t bucket = 0;
+        while (bucket < Metrics::kBuckets && (uint64_t(1) << bucket) < us) ++bucket;
+#endif
+        return std::min(bucket, Metrics::kBuckets);
+    }
+
+    /**
+     * @brief Секунди з наносекунд для дампів.
+     */
+    double Seconds(uint64_t ns) {
+        return static_cast<double>(ns) / 1e9;
+    }
+}
+
+// -------------------------------------------------------------
+//                     RECORDING
+// -------------------------------------------------------------
+
+/**
+ * @brief Назви у порядку Op.
+ */
+const char *Metrics::Name(Op op) {
+    static const char *const names[kOps] = {
+            "load", "save", "find_by_name", "search_by_definition",
+            "sort_by_name", "sort_by_definition", "chain", "authenticate"
+    };
+    return names[static_cast<size_t>(op)];
+}
+
+/**
+ * @brief 2^bucket мкс.
+ */
+uint64_t Metrics::BucketBoundUs(size_t bucket) {
+    return uint64_t(1) << bucket;
+}
+
+/**
+ * @brief Оновлює лічильники шарду поточного потоку.
+ */
+void Metrics::Record(Op op, uint64_t ns) {
+    thread_local LocalShard local;
+    Counters &counters = local.shard.ops[static_cast<size_t>(op)];
+    Bump(counters.count, 1);
+    Bump(counters.totalNs, ns);
+    if (ns > counters.maxNs.load(std::memory_order_relaxed)) counters.maxNs.store(ns, std::memory_order_relaxed);
+    Bump(counters.buckets[BucketOf(ns)], 1);
+}
+
+// -------------------------------------------------------------
+//                     AGGREGATION
+// -------------------------------------------------------------
+
+/**
+ * @brief Запас завершених потоків плюс усі живі шарди, під м'ютексом реєстру.
+ */
+std::vector<Metrics::OpStats> Metrics::Collect() {
+    std::vector<OpStats> stats(kOps);
+    for (size_t op = 0; op < kOps; ++op) stats[op].name = Name(static_cast<Op>(op));
+
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    AddShard(registry.retired, stats);
+    for (const Shard *shard : registry.live) AddShard(*shard, stats);
+    return stats;
+}
+
+/**
+ * @brief Межа кошика, у який потрапляє q-та частка викликів.
+ *
+ * Для останнього кошика (без межі) повертається найдовший виклик.
+ */
+double Metrics::OpStats::QuantileUs(double q) const {
+    if (count == 0) return 0.0;
+    auto rank = static_cast<uint64_t>(q * static_cast<double>(count));
+    if (rank >= count) rank = count - 1;
+    uint64_t seen = 0;
+    for (size_t b = 0; b < kBuckets; ++b) {
+        seen += buckets[b];
+        if (seen > rank) return std::min(static_cast<double>(BucketBoundUs(b)), static_cast<double>(maxNs) / 1e3);
+    }
+    return static_cast<double>(maxNs) / 1e3;
+}
+
+// -------------------------------------------------------------
+//                     OUTPUT
+// -------------------------------------------------------------
+
+/**
+ * @brief Таблиця операцій, що хоч раз викликались.
+ */
+std::string Metrics::Describe(const std::vector<OpStats> &stats) {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(1)
+         << "Операція                Викликів    Сума, мс  Сер., мкс  p50 <= мкс  p99 <= мкс   Макс., мкс\n";
+    bool any = false;
+    for (const auto &op : stats) {
+        if (op.count == 0) continue;
+        any = true;
+        text << std::left << std::setw(22) << op.name << std::right
+             << std::setw(10) << op.count
+             << std::setw(12) << std::setprecision(3) << static_cast<double>(op.totalNs) / 1e6 << std::setprecision(1)
+             << std::setw(11) << static_cast<double>(op.totalNs) / 1e3 / static_cast<double>(op.count)
+             << std::setw(12) << op.QuantileUs(0.50)
+             << std::setw(12) << op.QuantileUs(0.99)
+             << std::setw(13) << static_cast<double>(op.maxNs) / 1e3 << "\n";
+    }
+    if (!any) text << "Операцій ще не було.\n";
+    return text.str();
+}
+
+/**
+ * @brief JSON з кумулятивними кошиками, як у гістограмі Prometheus.
+ */
+std::string Metrics::ToJson(const std::vector<OpStats> &stats) {
+    std::ostringstream text;
+    text << std::setprecision(9) << "{\"operations\": [";
+    for (size_t i = 0; i < stats.size(); ++i) {
+        const OpStats &op = stats[i];
+        text << (i ? ",\n  " : "\n  ") << "{\"name\": \"" << op.name << "\", \"count\": " << op.count
+             << ", \"sum_seconds\": " << Seconds(op.totalNs) << ", \"max_seconds\": " << Seconds(op.maxNs)
+             << ", \"p50_us\": " << op.QuantileUs(0.50) << ", \"p99_us\": " << op.QuantileUs(0.99)
+             << ", \"buckets\": [";
+        uint64_t cumulative = 0;
+        for (size_t b = 0; b < kBuckets; ++b) {
+            cumulative += op.buckets[b];
+            text << (b ? ", " : "") << "{\"le_us\": " << BucketBoundUs(b) << ", \"count\": " << cumulative << "}";
+        }
+        text << "]}";
+    }
+    text << "\n]}\n";
+    return text.str();
+}
+
+/**
+ * @brief Гістограма з міткою op, плюс максимум окремою метрикою.
+ */
+std::string Metrics::ToPrometheus(const std::vector<OpStats> &stats) {
+    std::ostringstream text;
+    text << std::setprecision(9)
+         << "# HELP kursova_operation_seconds Тривалість операцій бази термінів.\n"
+         << "# TYPE kursova_operation_seconds histogram\n";
+    for (const auto &op : stats) {
+        uint64_t cumulative = 0;
+        for (size_t b = 0; b < kBuckets; ++b) {
+            cumulative += op.buckets[b];
+            text << "kursova_operation_seconds_bucket{op=\"" << op.name << "\",le=\""
+                 << static_cast<double>(BucketBoundUs(b)) / 1e6 << "\"} " << cumulative << "\n";
+        }
+        text << "kursova_operation_seconds_bucket{op=\"" << op.name << "\",le=\"+Inf\"} " << op.count << "\n"
+             << "kursova_operation_seconds_sum{op=\"" << op.name << "\"} " << Seconds(op.totalNs) << "\n"
+             << "kursova_operation_seconds_count{op=\"" << op.name << "\"} " << op.count << "\n";
+    }
+    text << "# HELP kursova_operation_max_seconds Найдовший виклик операції.\n"
+         << "# TYPE kursova_operation_max_seconds gauge\n";
+    for (const auto &op : stats) {
+        text << "kursova_operation_max_seconds{op=\"" << op.name << "\"} " << Seconds(op.maxNs) << "\n";
+    }
+    return text.str();
+}
+
+/**
+ * @brief Формат за розширенням, запис через AtomicFile.
+ */
+bool Metrics::Dump(const std::string &path, std::string &error) {
+    auto stats = Collect();
+    const std::string suffix = ".json";
+    bool json = path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+
+    AtomicFile out(path);
+    out.Write(json ? ToJson(stats) : ToPrometheus(stats));
+    bool ok = out.Commit();
+    error = out.Error();
+    return ok;
+}
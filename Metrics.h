@@ -0,0 +1,153 @@
+/**
+ * @file Metrics.h
+ * @brief Оголошення лічильників і таймерів операцій менеджерів.
+ */
+
+#ifndef KURSOVA_METRICS_H
+#define KURSOVA_METRICS_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @namespace Metrics
+ * @brief Кількість і тривалість основних операцій TermManager і UserManager.
+ *
+ * Кожен потік пише у власні лічильники (thread_local), без блокувань і
+ * без спільних рядків кешу, тож таймер коштує двох зчитувань годинника.
+ * Лічильники всіх потоків підсумовуються лише на запит (Collect); потік,
+ * що завершився, перед виходом додає свої значення до загального запасу.
+ * Тривалості розкладаються в гістограму з межами 1, 2, 4, ... мкс.
+ */
+namespace Metrics {
+
+    /**
+     * @brief Операції, що вимірюються.
+     */
+    enum class Op {
+        Load,
+        Save,
+        FindByName,
+        SearchByDefinition,
+        SortByName,
+        SortByDefinition,
+        Chain,
+        Authenticate,
+        Count
+    };
+
+    /** @brief Кількість операцій. */
+    constexpr size_t kOps = static_cast<size_t>(Op::Count);
+
+    /** @brief Кошиків гістограми зі скінченною межею: 2^0 .. 2^25 мкс (~34 с). */
+    constexpr size_t kBuckets = 26;
+
+    /**
+     * @brief Підсумок однієї операції по всіх потоках.
+     */
+    struct OpStats {
+        /** @brief Назва (snake_case, як у дампі). */
+        const char *name = "";
+        /** @brief Кількість викликів. */
+        uint64_t count = 0;
+        /** @brief Сумарна тривалість, нс. */
+        uint64_t totalNs = 0;
+        /** @brief Найдовший виклик, нс. */
+        uint64_t maxNs = 0;
+        /** @brief Викликів у кожному кошику; останній — довші за 2^(kBuckets-1) мкс. */
+        std::array<uint64_t, kBuckets + 1> buckets{};
+
+        /**
+         * @brief Верхня межа квантиля за гістограмою, мкс (0 — викликів не було).
+         * @param q Квантиль від 0 до 1.
+         */
+        double QuantileUs(double q) const;
+    };
+
+    /**
+     * @brief Назва операції.
+     */
+    const char *Name(Op op);
+
+    /**
+     * @brief Верхня межа кошика, мкс.
+     */
+    uint64_t BucketBoundUs(size_t bucket);
+
+    /**
+     * @brief Додає один вимір до лічильників поточного потоку.
+     * @param op Операція.
+     * @param ns Тривалість, нс.
+     */
+    void Record(Op op, uint64_t ns);
+
+    /**
+     * @brief Підсумовує лічильники всіх потоків.
+     * @return По одному запису на операцію, у порядку Op.
+     */
+    std::vector<OpStats> Collect();
+
+    /**
+     * @brief Таблиця для меню: кількість, сума, середнє, p50, p99, максимум.
+     */
+    std::string Describe(const std::vector<OpStats> &stats);
+
+    /**
+     * @brief Дамп у JSON: {"operations": [{"name": ..., "count": ..., "buckets": [...]}, ...]}.
+     */
+    std::string ToJson(const std::vector<OpStats> &stats);
+
+    /**
+     * @brief Дамп у текстовому форматі Prometheus (гістограма kursova_operation_seconds).
+     */
+    std::string ToPrometheus(const std::vector<OpStats> &stats);
+
+    /**
+     * @brief Атомарно записує поточні лічильники у файл.
+     *
+     * Шлях, що закінчується на ".json", отримує JSON, будь-який інший —
+     * текстовий формат Prometheus (його можна віддати node_exporter через
+     * textfile collector).
+     * @param path Шлях до файлу.
+     * @param error Опис помилки.
+     * @return false, якщо файл не записано.
+     */
+    bool Dump(const std::string &path, std::string &error);
+
+    /**
+     * @class Timer
+     * @brief Вимірює час від створення до виходу з області видимості.
+     *
+     * @code
+     * Metrics::Timer timer(Metrics::Op::FindByName);
+     * @endcode
+     */
+    class Timer {
+    public:
+        /**
+         * @brief Запам'ятовує час початку.
+         */
+        explicit Timer(Op op) : op(op), start(std::chrono::steady_clock::now()) {}
+
+        /**
+         * @brief Записує тривалість у лічильники потоку.
+         */
+        ~Timer() {
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            Record(op, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+
+        Timer(const Timer &) = delete;
+        Timer &operator=(const Timer &) = delete;
+
+    private:
+        Op op;
+        std::chrono::steady_clock::time_point start;
+    };
+}
+
+#endif //KURSOVA_METRICS_H
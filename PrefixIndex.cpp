@@ -0,0 +1,165 @@
+/**
+ * @file PrefixIndex.cpp
+ * @brief Реалізація відсортованого індексу назв.
+ */
+
+#include "PrefixIndex.h"
+
+#include <algorithm>
+
+/**
+ * @brief Чи починається рядок із префікса.
+ */
+static bool StartsWith(const std::string &value, const std::string &prefix) {
+    return value.compare(0, prefix.size(), prefix) == 0;
+}
+
+// -------------------------------------------------------------
+//                     HELPERS
+// -------------------------------------------------------------
+
+/**
+ * @brief Двійковий пошук блоку за його останнім рядком.
+ * @return Номер блоку або blocks.size(), якщо key більший за всі рядки.
+ */
+size_t PrefixIndex::BlockFor(const std::string &key) const {
+    auto it = std::partition_point(blocks.begin(), blocks.end(),
+                                   [&](const std::shared_ptr<Block> &b) { return b->back() < key; });
+    return static_cast<size_t>(it - blocks.begin());
+}
+
+/**
+ * @brief Повертає блок для зміни.
+ *
+ * Блок, спільний з іншою копією індексу (use_count > 1), спершу копіюється.
+ */
+PrefixIndex::Block &PrefixIndex::MutableBlock(size_t index) {
+    auto &block = blocks[index];
+    if (block.use_count() > 1) {
+        block = std::make_shared<Block>(*block);
+    }
+    return *block;
+}
+
+// -------------------------------------------------------------
+//                     WRITE ACCESS
+// -------------------------------------------------------------
+
+/**
+ * @brief Вставляє рядок у відповідний блок, зберігаючи порядок.
+ * @param key Рядок у нижньому регістрі.
+ * @return false, якщо рядок уже був в індексі.
+ */
+bool PrefixIndex::Insert(const std::string &key) {
+    if (blocks.empty()) {
+        blocks.push_back(std::make_shared<Block>(1, key));
+        count = 1;
+        return true;
+    }
+
+    // Рядок, більший за всі наявні, дописується в останній блок
+    size_t index = std::min(BlockFor(key), blocks.size() - 1);
+    const Block &current = *blocks[index];
+    auto pos = std::lower_bound(current.begin(), current.end(), key);
+    if (pos != current.end() && *pos == key) return false;
+
+    size_t offset = static_cast<size_t>(pos - current.begin());
+    Block &block = MutableBlock(index);
+    block.insert(block.begin() + static_cast<std::ptrdiff_t>(offset), key);
+    count++;
+
+    if (block.size() > kMaxBlockSize) {
+        auto middle = block.begin() + static_cast<std::ptrdiff_t>(block.size() / 2);
+        auto tail = std::make_shared<Block>(std::make_move_iterator(middle), std::make_move_iterator(block.end()));
+        block.erase(middle, block.end());
+        blocks.insert(blocks.begin() + static_cast<std::ptrdiff_t>(index) + 1, std::move(tail));
+    }
+    return true;
+}
+
+/**
+ * @brief Видаляє рядок; порожній блок прибирається.
+ * @param key Рядок у нижньому регістрі.
+ * @return false, якщо рядка не було.
+ */
+bool PrefixIndex::Erase(const std::string &key) {
+    size_t index = BlockFor(key);
+    if (index == blocks.size()) return false;
+
+    const Block &current = *blocks[index];
+    auto pos = std::lower_bound(current.begin(), current.end(), key);
+    if (pos == current.end() || *pos != key) return false;
+
+    size_t offset = static_cast<size_t>(pos - current.begin());
+    Block &block = MutableBlock(index);
+    block.erase(block.begin() + static_cast<std::ptrdiff_t>(offset));
+    count--;
+
+    if (block.empty()) {
+        blocks.erase(blocks.begin() + static_cast<std::ptrdiff_t>(index));
+    }
+    return true;
+}
+
+/**
+ * @brief Видаляє всі рядки.
+ */
+void PrefixIndex::Clear() {
+    blocks.clear();
+    count = 0;
+}
+
+// -------------------------------------------------------------
+//                     READ ACCESS
+// -------------------------------------------------------------
+
+/**
+ * @brief Перші limit рядків із префіксом.
+ *
+ * Пошук починається з першого рядка, не меншого за prefix, і йде вперед,
+ * доки рядки починаються з prefix: O(log n + limit).
+ * @param prefix Префікс у нижньому регістрі.
+ * @param limit Максимальна кількість результатів.
+ * @return Рядки за зростанням.
+ */
+std::vector<std::string> PrefixIndex::Complete(const std::string &prefix, size_t limit) const {
+    std::vector<std::string> out;
+    if (limit == 0) return out;
+
+    for (size_t index = BlockFor(prefix); index < blocks.size(); ++index) {
+        const Block &block = *blocks[index];
+        for (auto pos = std::lower_bound(block.begin(), block.end(), prefix); pos != block.end(); ++pos) {
+            if (!StartsWith(*pos, prefix)) return out;
+            out.push_back(*pos);
+            if (out.size() == limit) return out;
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Рахує рядки з префіксом.
+ *
+ * Блоки, повністю покриті діапазоном, додаються цілими, тож вартість
+ * O(log n + кількість блоків у діапазоні).
+ * @param prefix Префікс у нижньому регістрі.
+ */
+size_t PrefixIndex::Count(const std::string &prefix) const {
+    size_t total = 0;
+    for (size_t index = BlockFor(prefix); index < blocks.size(); ++index) {
+        const Block &block = *blocks[index];
+        auto first = std::lower_bound(block.begin(), block.end(), prefix);
+        auto last = std::partition_point(first, block.end(),
+                                         [&](const std::string &s) { return StartsWith(s, prefix); });
+        total += static_cast<size_t>(last - first);
+        if (last != block.end()) break;
+    }
+    return total;
+}
+
+/**
+ * @brief Загальна кількість рядків.
+ */
+size_t PrefixIndex::Size() const {
+    return count;
+}
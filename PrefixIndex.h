@@ -0,0 +1,82 @@
+/**
+ * @file PrefixIndex.h
+ * @brief Оголошення відсортованого індексу назв для пошуку за префіксом.
+ */
+
+#ifndef KURSOVA_PREFIXINDEX_H
+#define KURSOVA_PREFIXINDEX_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class PrefixIndex
+ * @brief Відсортований масив рядків, розбитий на блоки зі спільним володінням.
+ *
+ * Рядки (назви у нижньому регістрі) зберігаються за зростанням байтів UTF-8,
+ * тобто в порядку кодових точок. Усі рядки з префіксом p лежать поспіль,
+ * тому їх знаходять двійковим пошуком спочатку по блоках, потім у блоці.
+ *
+ * Копія індексу копіює лише вказівники на блоки, а вставка чи видалення
+ * копіює один блок (copy-on-write, як блоки термінів у TermSnapshot).
+ * Блок, що виріс понад kMaxBlockSize, ділиться навпіл; порожній прибирається.
+ */
+class PrefixIndex {
+public:
+    /** @brief Максимальна кількість рядків в одному блоці. */
+    static constexpr size_t kMaxBlockSize = 512;
+
+    /**
+     * @brief Додає рядок.
+     * @return false, якщо такий рядок уже є.
+     */
+    bool Insert(const std::string &key);
+
+    /**
+     * @brief Видаляє рядок.
+     * @return false, якщо рядка не було.
+     */
+    bool Erase(const std::string &key);
+
+    /**
+     * @brief Видаляє всі рядки.
+     */
+    void Clear();
+
+    /**
+     * @brief Повертає перші limit рядків із заданим префіксом (за зростанням).
+     * @param prefix Префікс у нижньому регістрі.
+     * @param limit Максимальна кількість результатів.
+     */
+    std::vector<std::string> Complete(const std::string &prefix, size_t limit) const;
+
+    /**
+     * @brief Кількість рядків із заданим префіксом.
+     */
+    size_t Count(const std::string &prefix) const;
+
+    /**
+     * @brief Загальна кількість рядків.
+     */
+    size_t Size() const;
+
+private:
+    /** @brief Відсортований блок рядків. */
+    using Block = std::vector<std::string>;
+
+    /**
+     * @brief Номер першого блоку, останній рядок якого не менший за key.
+     */
+    size_t BlockFor(const std::string &key) const;
+
+    /**
+     * @brief Повертає блок для зміни (копіює спільний блок).
+     */
+    Block &MutableBlock(size_t index);
+
+    std::vector<std::shared_ptr<Block>> blocks;
+    size_t count = 0;
+};
+
+#endif //KURSOVA_PREFIXINDEX_H
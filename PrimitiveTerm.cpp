@@ -85,17 +85,27 @@ bool PrimitiveTerm::IsPrimitive() const {
 }
 
 /**
- * @brief Серіалізує об'єкт у рядок для збереження у CSV.
+ * @brief Створює копію терміна через конструктор копіювання.
+ * @return Вказівник на новий об'єкт PrimitiveTerm.
+ */
+std::shared_ptr<TermBase> PrimitiveTerm::Clone() const {
+    return std::make_shared<PrimitiveTerm>(*this);
+}
+
+/**
+ * @brief Дописує об'єкт у буфер для збереження у CSV.
  *
  * Формує рядок у форматі: PRIM;Назва;Визначення;
- * Використовує екранування спецсимволів (Utils::Escape).
+ * Поля екрануються прямо в буфері (Utils::EscapeTo).
  *
- * @return std::string Серіалізовані дані.
+ * @param out Буфер викликача.
  */
-std::string PrimitiveTerm::Serialize() const {
-    std::string escapedName = Utils::Escape(name);
-    std::string escapedDef = Utils::Escape(definition);
+void PrimitiveTerm::SerializeTo(std::string &out) const {
     // Формат: TYPE;name;definition;
     // Останню крапку з комою залишаємо для сумісності з форматом TERM (де далі йдуть посилання)
-    return GetType() + ";" + escapedName + ";" + escapedDef + ";";
+    out.append("PRIM;");
+    Utils::EscapeTo(out, name);
+    out.push_back(';');
+    EscapeDefinitionTo(out);
+    out.push_back(';');
 }
\ No newline at end of file
@@ -74,10 +74,16 @@ public:
     bool IsPrimitive() const override;
 
     /**
-     * @brief Серіалізує об'єкт у рядок формату CSV.
-     * @return Рядок вигляду: PRIM;Назва;Визначення;
+     * @brief Створює копію терміна.
+     * @return Новий об'єкт PrimitiveTerm.
      */
-    std::string Serialize() const override;
+    std::shared_ptr<TermBase> Clone() const override;
+
+    /**
+     * @brief Дописує об'єкт у форматі CSV.
+     * @param out Буфер; дописується рядок вигляду PRIM;Назва;Визначення;
+     */
+    void SerializeTo(std::string &out) const override;
 };
 
 #endif //KURSOVA_PRIMITIVETERM_H
\ No newline at end of file
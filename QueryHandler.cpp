@@ -0,0 +1,241 @@
+/**
+ * @file QueryHandler.cpp
+ * @brief Реалізація обробника запитів на читання.
+ */
+
+#include "QueryHandler.h"
+#include "Term.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <charconv>
+
+// -------------------------------------------------------------
+//                     CONSTRUCTOR
+// -------------------------------------------------------------
+
+/**
+ * @brief Конструктор.
+ * @param termManager База термінів.
+ */
+QueryHandler::QueryHandler(const TermManager &termManager)
+        : termManager(termManager) {}
+
+// -------------------------------------------------------------
+//                     FORMATTING
+// -------------------------------------------------------------
+
+/**
+ * @brief Дописує "<id>\t<status>\t<команда>".
+ */
+void QueryHandler::AppendHead(std::string &out, uint64_t id, const char *status, const std::string &command) {
+    char digits[24];
+    auto end = std::to_chars(digits, digits + sizeof(digits), id).ptr;
+    out.append(digits, end);
+    out.push_back('\t');
+    out.append(status);
+    AppendField(out, command);
+}
+
+/**
+ * @brief Дописує поле, не даючи значенню зламати формат рядка.
+ */
+void QueryHandler::AppendField(std::string &out, const std::string &value) {
+    out.push_back('\t');
+    size_t start = out.size();
+    out.append(value);
+    for (size_t i = start; i < out.size(); ++i) {
+        char c = out[i];
+        if (c == '\t' || c == '\n' || c == '\r') out[i] = ' ';
+    }
+}
+
+/**
+ * @brief Дописує число через std::to_chars.
+ */
+void QueryHandler::AppendNumber(std::string &out, uint64_t value) {
+    char digits[24];
+    auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+    out.push_back('\t');
+    out.append(digits, end);
+}
+
+/**
+ * @brief Назва типу кроку ланцюжка для відповідей.
+ */
+const char *QueryHandler::ChainKindName(ChainStep::Kind kind) {
+    switch (kind) {
+        case ChainStep::Kind::Primitive: return "prim";
+        case ChainStep::Kind::Missing:   return "missing";
+        case ChainStep::Kind::Cycle:     return "cycle";
+        case ChainStep::Kind::Composite: break;
+    }
+    return "term";
+}
+
+/**
+ * @brief Дописує рядок "<id>\tERR\t<команда>\t<код>".
+ */
+void QueryHandler::AppendError(std::string &out, uint64_t id, const std::string &command, const char *code) {
+    AppendHead(out, id, "ERR", command);
+    out.push_back('\t');
+    out.append(code);
+    out.push_back('\n');
+}
+
+// -------------------------------------------------------------
+//                     QUERIES
+// -------------------------------------------------------------
+
+/**
+ * @brief Перевіряє, чи обробляє цей клас команду.
+ */
+bool QueryHandler::IsQuery(const std::string &command) {
+    return command == "find" || command == "complete" || command == "suggest" ||
+           command == "search" || command == "chain" || command == "stats" || command == "query";
+}
+
+/**
+ * @brief Виконує один запит на читання.
+ * @param id Номер запиту.
+ * @param fields Поля запиту.
+ * @param out Буфер відповіді.
+ * @return false для відповіді ERR.
+ */
+bool QueryHandler::Execute(uint64_t id, const std::vector<std::string> &fields, std::string &out) const {
+    const std::string command = fields.empty() ? std::string() : Utils::Trim(fields[0]);
+    std::string argument = fields.size() > 1 ? Utils::Trim(Utils::Unescape(fields[1])) : std::string();
+
+    if (command == "find") {
+        auto term = termManager.FindByName(argument);
+        if (!term) {
+            AppendError(out, id, command, "not_found");
+            return false;
+        }
+
+        AppendHead(out, id, "OK", command);
+        out.append(term->IsPrimitive() ? "\tPRIM" : "\tTERM");
+        AppendField(out, term->GetName());
+        AppendField(out, term->GetDefinition());
+        if (auto t = std::dynamic_pointer_cast<const Term>(term)) {
+            AppendField(out, Utils::Join(t->GetReferences(), ','));
+        } else {
+            out.push_back('\t');
+        }
+        out.push_back('\n');
+        return true;
+    }
+
+    if (command == "complete" || command == "suggest") {
+        size_t limit = TermManager::kDefaultCompletions;
+        if (fields.size() > 2) {
+            std::string text = Utils::Trim(fields[2]);
+            auto result = std::from_chars(text.data(), text.data() + text.size(), limit);
+            if (result.ec != std::errc() || limit == 0) {
+                AppendError(out, id, command, "bad_arguments");
+                return false;
+            }
+        }
+
+        limit = std::min(limit, TermManager::kMaxCompletions);
+        auto names = command == "complete" ? termManager.CompleteName(argument, limit)
+                                           : termManager.SuggestNames(argument, limit);
+        for (const auto &name : names) {
+            AppendHead(out, id, "ROW", command);
+            AppendField(out, name);
+            out.push_back('\n');
+        }
+        AppendHead(out, id, "OK", command);
+        AppendNumber(out, names.size());
+        out.push_back('\n');
+        return true;
+    }
+
+    if (command == "search") {
+        if (argument.empty()) {
+            AppendError(out, id, command, "bad_arguments");
+            return false;
+        }
+
+        auto found = termManager.SearchDefinitions(argument);
+        for (const auto &t : found) {
+            AppendHead(out, id, "ROW", command);
+            AppendField(out, t->GetName());
+            out.push_back('\n');
+        }
+        AppendHead(out, id, "OK", command);
+        AppendNumber(out, found.size());
+        out.push_back('\n');
+        return true;
+    }
+
+    if (command == "query") {
+        // Префікс "explain " — як у меню: перед результатами йдуть рядки плану
+        bool explain = Utils::ToLower(argument.substr(0, 8)) == "explain ";
+        if (explain) argument = Utils::Trim(argument.substr(8));
+
+        std::vector<TermSnapshot::TermPtr> found;
+        std::string error;
+        std::string plan;
+        if (!termManager.Query(argument, found, error, explain ? &plan : nullptr)) {
+            AppendHead(out, id, "ERR", command);
+            out.append("\tbad_query");
+            AppendField(out, error);
+            out.push_back('\n');
+            return false;
+        }
+
+        for (size_t start = 0; start < plan.size();) {
+            size_t end = std::min(plan.find('\n', start), plan.size());
+            AppendHead(out, id, "ROW", command);
+            out.append("\tplan");
+            AppendField(out, plan.substr(start, end - start));
+            out.push_back('\n');
+            start = end + 1;
+        }
+        for (const auto &t : found) {
+            AppendHead(out, id, "ROW", command);
+            if (explain) out.append("\tterm");
+            AppendField(out, t->GetName());
+            out.push_back('\n');
+        }
+        AppendHead(out, id, "OK", command);
+        AppendNumber(out, found.size());
+        out.push_back('\n');
+        return true;
+    }
+
+    if (command == "chain") {
+        auto steps = termManager.CollectChain(argument);
+        if (steps.empty()) {
+            AppendError(out, id, command, "not_found");
+            return false;
+        }
+
+        for (const auto &step : steps) {
+            AppendHead(out, id, "ROW", command);
+            AppendNumber(out, static_cast<uint64_t>(step.level));
+            AppendField(out, step.name);
+            out.push_back('\t');
+            out.append(ChainKindName(step.kind));
+            out.push_back('\n');
+        }
+        AppendHead(out, id, "OK", command);
+        AppendNumber(out, steps.size());
+        out.push_back('\n');
+        return true;
+    }
+
+    if (command == "stats") {
+        TermStats stats = termManager.GetStats();
+        AppendHead(out, id, "OK", command);
+        AppendNumber(out, stats.total);
+        AppendNumber(out, stats.primitive);
+        AppendNumber(out, stats.composite);
+        out.push_back('\n');
+        return true;
+    }
+
+    AppendError(out, id, command, "unknown_command");
+    return false;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file QueryHandler.h
+ * @brief Оголошення обробника запитів на читання бази термінів.
+ */
+
+#ifndef KURSOVA_QUERYHANDLER_H
+#define KURSOVA_QUERYHANDLER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "TermManager.h"
+
+/**
+ * @class QueryHandler
+ * @brief Виконує запити лише на читання (find, complete, suggest, search, chain, stats, query).
+ *
+ * Спільний для пакетного режиму та сервера запитів. Результат дописується
+ * у переданий рядок-буфер, тож виклики можуть перевикористовувати один
+ * буфер без проміжних потоків і тимчасових рядків.
+ *
+ * Формат відповіді — рядки з полями через табуляцію; перше поле — номер
+ * запиту (рядок скрипта або порядковий номер запиту в з'єднанні):
+ *
+ *     <N>\tROW\t<команда>\t...      (нуль або більше рядків даних)
+ *     <N>\tOK\t<команда>[\t...]     або     <N>\tERR\t<команда>\t<код>
+ *
+ * Кожна відповідь закінчується рівно одним рядком OK або ERR. Для
+ * "query;explain ..." рядки ROW мають друге поле: "plan" (рядок плану) або
+ * "term" (назва терміна).
+ */
+class QueryHandler {
+private:
+    const TermManager &termManager;
+
+public:
+    /**
+     * @brief Конструктор.
+     * @param termManager База термінів (використовуються лише методи читання).
+     */
+    explicit QueryHandler(const TermManager &termManager);
+
+    /**
+     * @brief Перевіряє, чи є команда запитом на читання.
+     * @param command Назва команди.
+     */
+    static bool IsQuery(const std::string &command);
+
+    /**
+     * @brief Виконує запит і дописує відповідь у буфер.
+     * @param id Номер запиту.
+     * @param fields Поля запиту через ';' (з екрануванням, як у terms.csv).
+     * @param out Буфер відповіді (дописується в кінець).
+     * @return false, якщо відповідь — ERR.
+     */
+    bool Execute(uint64_t id, const std::vector<std::string> &fields, std::string &out) const;
+
+    /**
+     * @brief Дописує початок рядка відповіді: "<id>\t<status>\t<команда>".
+     */
+    static void AppendHead(std::string &out, uint64_t id, const char *status, const std::string &command);
+
+    /**
+     * @brief Дописує "\t" і значення, замінюючи табуляції та переноси рядків пробілами.
+     */
+    static void AppendField(std::string &out, const std::string &value);
+
+    /**
+     * @brief Дописує "\t" і число без тимчасових рядків.
+     */
+    static void AppendNumber(std::string &out, uint64_t value);
+
+    /**
+     * @brief Назва типу кроку ланцюжка: term, prim, missing, cycle.
+     */
+    static const char *ChainKindName(ChainStep::Kind kind);
+
+    /**
+     * @brief Дописує повний рядок помилки.
+     */
+    static void AppendError(std::string &out, uint64_t id, const std::string &command, const char *code);
+};
+
+#endif //KURSOVA_QUERYHANDLER_H
@@ -0,0 +1,123 @@
+/**
+ * @file QueryServer.cpp
+ * @brief Реалізація сервера запитів на Unix-сокеті.
+ */
+
+#include "QueryServer.h"
+#include "Utils.h"
+
+#include <iostream>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// -------------------------------------------------------------
+//                     CONSTRUCTOR / DESTRUCTOR
+// -------------------------------------------------------------
+
+/**
+ * @brief Конструктор.
+ * @param termManager База термінів.
+ * @param socketPath Шлях до сокета.
+ */
+QueryServer::QueryServer(const TermManager &termManager, const std::string &socketPath)
+        : queries(termManager), socketPath(socketPath) {}
+
+/**
+ * @brief Прибирає файл сокета, якщо сервер його створив.
+ */
+QueryServer::~QueryServer() {
+#ifdef __linux__
+    if (bound) ::unlink(socketPath.c_str());
+#endif
+}
+
+// -------------------------------------------------------------
+//                     PROTOCOL
+// -------------------------------------------------------------
+
+/**
+ * @brief Виконує повні рядки-запити з вхідного буфера.
+ *
+ * Відповіді дописуються в out; обробка зупиняється, коли невідправлених
+ * даних стає забагато.
+ * @return false, якщо незавершений запит перевищив допустиму довжину.
+ */
+bool QueryServer::ProcessRequests(Connection &conn) {
+    size_t pos = 0;
+    while (CanAcceptMore(conn)) {
+        size_t eol = conn.in.find('\n', pos);
+        if (eol == std::string::npos) break;
+
+        size_t end = eol;
+        if (end > pos && conn.in[end - 1] == '\r') end--;
+        if (end > pos) {
+            fields = Utils::Split(conn.in.substr(pos, end - pos), ';');
+            queries.Execute(conn.nextId++, fields, conn.out);
+        }
+        pos = eol + 1;
+    }
+    conn.in.erase(0, pos);
+    return conn.in.size() <= kMaxRequestBytes || conn.in.find('\n') != std::string::npos;
+}
+
+/**
+ * @brief Межа довжини рядка-запиту.
+ */
+size_t QueryServer::MaxRequestBytes() const {
+    return kMaxRequestBytes;
+}
+
+#ifdef __linux__
+
+/**
+ * @brief Створює сокет, прив'язує його до шляху і починає слухати.
+ * @return Дескриптор або -1.
+ */
+int QueryServer::OpenListener() {
+    sockaddr_un addr{};
+    if (socketPath.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "[ERROR] Задовгий шлях до сокета: " << socketPath << std::endl;
+        return -1;
+    }
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        std::cerr << "[ERROR] socket: " << std::strerror(errno) << std::endl;
+        return -1;
+    }
+
+    // Файл від попереднього запуску заважає bind
+    ::unlink(socketPath.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 ||
+        ::listen(fd, SOMAXCONN) < 0) {
+        std::cerr << "[ERROR] bind/listen " << socketPath << ": " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        return -1;
+    }
+    bound = true;
+    // Доступ мають власник і його група
+    ::chmod(socketPath.c_str(), 0660);
+
+    std::cout << "[INFO] Сервер запитів слухає " << socketPath << std::endl;
+    return fd;
+}
+
+#else
+
+/**
+ * @brief Unix-сокети з epoll доступні лише в Linux.
+ */
+int QueryServer::OpenListener() {
+    return -1;
+}
+
+#endif
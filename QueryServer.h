@@ -0,0 +1,69 @@
+/**
+ * @file QueryServer.h
+ * @brief Оголошення локального сервера запитів (Unix-сокет + epoll).
+ */
+
+#ifndef KURSOVA_QUERYSERVER_H
+#define KURSOVA_QUERYSERVER_H
+
+#include <string>
+#include <vector>
+
+#include "SocketServer.h"
+#include "TermManager.h"
+#include "QueryHandler.h"
+
+/**
+ * @class QueryServer
+ * @brief Обслуговує запити на читання з "теплої" бази через Unix-сокет.
+ *
+ * База завантажується один раз, а локальні процеси підключаються до сокета
+ * замість того, щоб щоразу запускати програму і платити за Load.
+ *
+ * Протокол — рядки "команда;аргумент" (find, search, chain, stats), відповіді
+ * у форматі QueryHandler з порядковим номером запиту в з'єднанні. Клієнт
+ * може надіслати багато запитів, не чекаючи відповідей (pipelining):
+ * відповіді повертаються у тому ж порядку.
+ */
+class QueryServer : public SocketServer {
+public:
+    /**
+     * @brief Конструктор.
+     * @param termManager Завантажена база термінів.
+     * @param socketPath Шлях до Unix-сокета.
+     */
+    QueryServer(const TermManager &termManager, const std::string &socketPath);
+
+    /**
+     * @brief Видаляє файл сокета.
+     */
+    ~QueryServer() override;
+
+protected:
+    /**
+     * @brief Створює, прив'язує та слухає Unix-сокет (права 0660).
+     */
+    int OpenListener() override;
+
+    /**
+     * @brief Виконує повні рядки-запити з вхідного буфера.
+     * @return false при надто довгому запиті.
+     */
+    bool ProcessRequests(Connection &conn) override;
+
+    /**
+     * @brief kMaxRequestBytes.
+     */
+    size_t MaxRequestBytes() const override;
+
+private:
+    /** @brief Максимальна довжина одного запиту. */
+    static constexpr size_t kMaxRequestBytes = 64 * 1024;
+
+    QueryHandler queries;
+    std::string socketPath;
+    bool bound = false;
+    std::vector<std::string> fields;
+};
+
+#endif //KURSOVA_QUERYSERVER_H
@@ -0,0 +1,207 @@
+/**
+ * @file RoleManager.cpp
+ * @brief Реалізація менеджера ролей.
+ */
+
+#include "RoleManager.h"
+#include "Utils.h"
+#include "AtomicFile.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+    /**
+     * @brief Відповідність назв прав у файлі бітам маски.
+     */
+    struct PermissionName {
+        const char *name;
+        Permission bit;
+    };
+
+    const PermissionName kPermissionNames[] = {
+            {"view",         PermViewTerms},
+            {"add",          PermAddTerm},
+            {"edit",         PermEditTerm},
+            {"remove",       PermRemoveTerm},
+            {"sort",         PermSortTerms},
+            {"view_users",   PermViewUsers},
+            {"manage_users", PermManageUsers},
+    };
+
+}
+
+// -------------------------------------------------------------
+//                     CONSTRUCTOR
+// -------------------------------------------------------------
+
+/**
+ * @brief Конструктор.
+ * @param filePath Шлях до файлу ролей.
+ */
+RoleManager::RoleManager(const std::string &filePath)
+        : filePath(filePath) {}
+
+// -------------------------------------------------------------
+//                     PARSING
+// -------------------------------------------------------------
+
+/**
+ * @brief Розбирає список прав через кому.
+ * @param list Рядок прав.
+ * @param outMask Результат.
+ * @return false при невідомій назві.
+ */
+bool RoleManager::ParsePermissions(const std::string &list, uint32_t &outMask) {
+    outMask = 0;
+    for (const auto &raw : Utils::Split(list, ',')) {
+        std::string name = Utils::Trim(raw);
+        if (name.empty()) continue;
+        if (name == "*") {
+            outMask |= PermAll;
+            continue;
+        }
+        bool known = false;
+        for (const auto &entry : kPermissionNames) {
+            if (name == entry.name) {
+                outMask |= entry.bit;
+                known = true;
+                break;
+            }
+        }
+        if (!known) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Перетворює маску у список назв через кому.
+ * @param mask Маска прав.
+ * @return "*" для всіх прав, інакше перелік назв.
+ */
+std::string RoleManager::Describe(uint32_t mask) {
+    if ((mask & PermAll) == PermAll) return "*";
+    std::string out;
+    for (const auto &entry : kPermissionNames) {
+        if (mask & entry.bit) {
+            if (!out.empty()) out += ",";
+            out += entry.name;
+        }
+    }
+    return out;
+}
+
+// -------------------------------------------------------------
+//                     LOAD / SAVE
+// -------------------------------------------------------------
+
+/**
+ * @brief Завантажує ролі з файлу у форматі "роль:права".
+ */
+void RoleManager::Load() {
+    roles.clear();
+    order.clear();
+
+    std::ifstream in(filePath);
+    if (!in.is_open()) {
+        std::cout << "[INFO] Файл ролей не знайдено, буде створено новий." << std::endl;
+        return;
+    }
+
+    std::string line;
+    while (std::getline(in, line)) {
+        line = Utils::Trim(line);
+        if (line.empty() || line[0] == '#') continue;
+
+        auto parts = Utils::Split(line, ':');
+        if (parts.size() < 2) continue;
+
+        std::string name = Utils::Trim(parts[0]);
+        uint32_t mask = 0;
+        if (name.empty() || !ParsePermissions(parts[1], mask)) {
+            std::cerr << "[WARN] Некоректний рядок ролі: " << line << std::endl;
+            continue;
+        }
+        SetRole(name, mask);
+    }
+}
+
+/**
+ * @brief Зберігає ролі у файл (атомарно, див. AtomicFile).
+ */
+void RoleManager::Save() const {
+    std::ostringstream out;
+    out << "# роль:права (";
+    for (size_t i = 0; i < sizeof(kPermissionNames) / sizeof(kPermissionNames[0]); ++i) {
+        if (i) out << ",";
+        out << kPermissionNames[i].name;
+    }
+    out << "; * = усі права)\n";
+    for (const auto &name : order) {
+        out << name << ":" << Describe(roles.at(name)) << "\n";
+    }
+
+    std::string error;
+    if (!AtomicFile::WriteAll(filePath, out.str(), error)) {
+        std::cerr << "[ERROR] Не вдалося записати файл ролей: " << error << std::endl;
+    }
+}
+
+/**
+ * @brief Додає відсутні стандартні ролі.
+ *
+ * Існуючі ролі не перезаписуються, тож зміни у файлі зберігаються.
+ */
+void RoleManager::EnsureDefaultRoles() {
+    const std::pair<const char *, uint32_t> defaults[] = {
+            {"admin",   PermAll},
+            {"user",    PermViewTerms},
+            {"editor",  PermViewTerms | PermAddTerm | PermEditTerm | PermRemoveTerm | PermSortTerms},
+            {"auditor", PermViewTerms | PermViewUsers},
+    };
+
+    bool changed = false;
+    for (const auto &role : defaults) {
+        if (!HasRole(role.first)) {
+            SetRole(role.first, role.second);
+            changed = true;
+        }
+    }
+    if (changed) Save();
+}
+
+// -------------------------------------------------------------
+//                     ACCESS
+// -------------------------------------------------------------
+
+/**
+ * @brief Додає або замінює роль.
+ */
+void RoleManager::SetRole(const std::string &name, uint32_t mask) {
+    if (roles.find(name) == roles.end()) order.push_back(name);
+    roles[name] = mask;
+}
+
+/**
+ * @brief Маска прав ролі (0 для невідомої).
+ */
+uint32_t RoleManager::Compile(const std::string &name) const {
+    auto it = roles.find(name);
+    return it == roles.end() ? 0 : it->second;
+}
+
+/**
+ * @brief Перевіряє існування ролі.
+ */
+bool RoleManager::HasRole(const std::string &name) const {
+    return roles.find(name) != roles.end();
+}
+
+/**
+ * @brief Назви ролей у порядку оголошення.
+ */
+const std::vector<std::string> &RoleManager::GetRoleNames() const {
+    return order;
+}
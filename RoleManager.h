@@ -0,0 +1,132 @@
+/**
+ * @file RoleManager.h
+ * @brief Оголошення прав доступу та менеджера ролей.
+ */
+
+#ifndef KURSOVA_ROLEMANAGER_H
+#define KURSOVA_ROLEMANAGER_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @enum Permission
+ * @brief Окремі права доступу (біти маски).
+ *
+ * Кожна операція меню оголошує потрібне право, а перевірка зводиться
+ * до одного побітового AND з маскою користувача.
+ */
+enum Permission : uint32_t {
+    /** @brief Перегляд і пошук термінів. */
+    PermViewTerms = 1u << 0,
+    /** @brief Додавання термінів. */
+    PermAddTerm = 1u << 1,
+    /** @brief Редагування визначень. */
+    PermEditTerm = 1u << 2,
+    /** @brief Видалення термінів. */
+    PermRemoveTerm = 1u << 3,
+    /** @brief Сортування бази. */
+    PermSortTerms = 1u << 4,
+    /** @brief Перегляд списку користувачів. */
+    PermViewUsers = 1u << 5,
+    /** @brief Додавання та видалення користувачів. */
+    PermManageUsers = 1u << 6,
+
+    /** @brief Усі права. */
+    PermAll = (1u << 7) - 1
+};
+
+/**
+ * @class RoleManager
+ * @brief Клас для завантаження ролей і компіляції їх у маски прав.
+ *
+ * Ролі описуються у текстовому файлі (roles.txt) у форматі
+ * "роль:право1,право2,...", де "*" означає всі права. Нові ролі
+ * (наприклад, аудитор лише для читання чи редактор без керування
+ * користувачами) додаються у файл без зміни коду.
+ *
+ * Якщо файлу немає, створюються ролі за замовчуванням:
+ * admin, user, editor, auditor.
+ */
+class RoleManager {
+private:
+    /**
+     * @brief Таблиця: назва ролі -> маска прав.
+     */
+    std::unordered_map<std::string, uint32_t> roles;
+
+    /**
+     * @brief Порядок ролей у файлі (для збереження та виводу).
+     */
+    std::vector<std::string> order;
+
+    /**
+     * @brief Шлях до файлу ролей.
+     */
+    std::string filePath;
+
+    /**
+     * @brief Розбирає список прав через кому.
+     * @param list Рядок на кшталт "view,add,edit" або "*".
+     * @param outMask Отримана маска.
+     * @return false, якщо трапилась невідома назва права.
+     */
+    static bool ParsePermissions(const std::string &list, uint32_t &outMask);
+
+public:
+    /**
+     * @brief Конструктор.
+     * @param filePath Шлях до файлу ролей.
+     */
+    explicit RoleManager(const std::string &filePath);
+
+    /**
+     * @brief Завантажує ролі з файлу.
+     * Рядки з невідомими правами пропускаються з попередженням.
+     */
+    void Load();
+
+    /**
+     * @brief Зберігає ролі у файл.
+     */
+    void Save() const;
+
+    /**
+     * @brief Додає ролі за замовчуванням, яких ще немає, і зберігає файл.
+     */
+    void EnsureDefaultRoles();
+
+    /**
+     * @brief Додає або замінює роль.
+     * @param name Назва ролі.
+     * @param mask Маска прав.
+     */
+    void SetRole(const std::string &name, uint32_t mask);
+
+    /**
+     * @brief Компілює назву ролі у маску прав.
+     * @param name Назва ролі.
+     * @return Маска прав (0 для невідомої ролі).
+     */
+    uint32_t Compile(const std::string &name) const;
+
+    /**
+     * @brief Перевіряє, чи існує роль.
+     */
+    bool HasRole(const std::string &name) const;
+
+    /**
+     * @brief Список назв ролей у порядку оголошення.
+     */
+    const std::vector<std::string> &GetRoleNames() const;
+
+    /**
+     * @brief Перетворює маску прав у рядок назв (для виводу та файлу).
+     * @param mask Маска прав.
+     */
+    static std::string Describe(uint32_t mask);
+};
+
+#endif //KURSOVA_ROLEMANAGER_H
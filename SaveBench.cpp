@@ -0,0 +1,114 @@
+/**
+ * @file SaveBench.cpp
+ * @brief Точка входу KursovaBench: виділення пам'яті під час збереження бази.
+ *
+ * Збирається окремою програмою разом з AllocationCounter.cpp, який
+ * замінює глобальні operator new / operator delete. Kursova лишається
+ * зі стандартним розподільником пам'яті.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h> // Для налаштування кодування консолі у Windows
+#endif
+
+#include "TermManager.h"
+#include "AllocationCounter.h"
+
+/**
+ * @brief Рахує виділення пам'яті на один збережений термін.
+ *
+ * База завантажується з файлу. Далі окремо вимірюються два етапи:
+ * серіалізація всіх термінів через SerializeTo у буфер, що
+ * перевикористовується, як у TermManager::WriteTo, і повний експорт у
+ * "<файл>.savebench" (TermManager::WriteTo разом з AtomicFile). Перед
+ * виміром кожен етап виконується один раз, щоб буфери набрали місткість.
+ * Вихідний файл не змінюється.
+ * @param argc Кількість аргументів.
+ * @param argv Аргументи: [файл] [повторів].
+ * @return Код завершення: 0 — SerializeTo не виділяє пам'яті, 1 — виділяє або запис не вдався.
+ */
+int main(int argc, char *argv[]) {
+#ifdef _WIN32
+    SetConsoleOutputCP(65001);
+#endif
+
+    std::string source = argc >= 2 ? argv[1] : "terms.csv";
+    unsigned long repeats = argc >= 3 ? std::strtoul(argv[2], nullptr, 10) : 5;
+    if (repeats == 0) repeats = 1;
+    const std::string target = source + ".savebench";
+
+    // TermManager пише [INFO] у cout, а таблиця має лишитися єдиним виводом
+    std::ostream report(std::cout.rdbuf());
+    std::cout.rdbuf(std::cerr.rdbuf());
+
+    TermManager manager(source);
+    manager.Load();
+    auto snapshot = manager.Snapshot();
+    const double terms = static_cast<double>(std::max<size_t>(1, snapshot->Size()));
+
+    std::string block;
+    block.reserve(128 * 1024);
+    size_t bytes = 0;
+    auto serializeAll = [&] {
+        snapshot->ForEach([&](const TermSnapshot::TermPtr &t) {
+            t->SerializeTo(block);
+            block.push_back('\n');
+            if (block.size() >= 64 * 1024) {
+                bytes += block.size();
+                block.clear();
+            }
+        });
+        bytes += block.size();
+        block.clear();
+    };
+
+    struct Stage {
+        const char *name;
+        AllocationCounter::Totals totals;
+        double bestMs = 0;
+    };
+    Stage stages[] = {{"SerializeTo", {}, 0}, {"Export", {}, 0}};
+    bool written = manager.Export(target);
+    serializeAll();
+    for (unsigned long i = 0; i < repeats && written; ++i) {
+        for (size_t s = 0; s < 2; ++s) {
+            auto start = std::chrono::steady_clock::now();
+            AllocationCounter::Start();
+            if (s == 0) serializeAll();
+            else written = manager.Export(target) && written;
+            AllocationCounter::Totals totals = AllocationCounter::Stop();
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            stages[s].totals.count += totals.count;
+            stages[s].totals.bytes += totals.bytes;
+            stages[s].bestMs = i == 0 ? ms : std::min(stages[s].bestMs, ms);
+        }
+    }
+    std::remove(target.c_str());
+    if (!written) {
+        report << "Не вдалося записати " << target << "\n";
+        return 1;
+    }
+
+    report << std::fixed << std::setprecision(2)
+           << "Файл: " << source << ", термінів: " << snapshot->Size() << ", повторів: " << repeats << "\n"
+           // setw рахує байти, а не літери, тому заголовок вирівняно вручну
+           << "Етап           Виділень/термін   КБ/термін   Виділень/прохід   Найкращий, мс\n";
+    for (const auto &stage : stages) {
+        double count = static_cast<double>(stage.totals.count) / repeats;
+        report << std::left << std::setw(12) << stage.name << std::right
+               << std::setw(18) << count / terms
+               << std::setw(12) << static_cast<double>(stage.totals.bytes) / repeats / terms / 1024
+               << std::setw(18) << count
+               << std::setw(16) << stage.bestMs << "\n";
+    }
+    return stages[0].totals.count == 0 ? 0 : 1;
+}
@@ -0,0 +1,203 @@
+/**
+ * @file ScanExecutor.cpp
+ * @brief Реалізація пулу потоків для паралельного перегляду бази.
+ */
+
+#include "ScanExecutor.h"
+
+#include <algorithm>
+
+// -------------------------------------------------------------
+//                     CONSTRUCTOR / DESTRUCTOR
+// -------------------------------------------------------------
+
+/**
+ * @brief Запускає робочі потоки.
+ *
+ * Один потік не створюється: його роль виконує потік, що викликає ParallelFor.
+ * @param threads Бажана кількість потоків (0 — std::thread::hardware_concurrency()).
+ */
+ScanExecutor::ScanExecutor(size_t threads) {
+    if (threads == 0) {
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 1; i < threads; ++i) {
+        workers.emplace_back(&ScanExecutor::WorkerLoop, this);
+    }
+}
+
+/**
+ * @brief Сигналізує потокам про завершення і чекає на них.
+ */
+ScanExecutor::~ScanExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto &w : workers) {
+        w.join();
+    }
+}
+
+/**
+ * @brief Кількість потоків, що виконують роботу.
+ */
+size_t ScanExecutor::GetThreadCount() const {
+    return workers.size() + 1;
+}
+
+// -------------------------------------------------------------
+//                     WORKERS
+// -------------------------------------------------------------
+
+/**
+ * @brief Цикл робочого потоку: чекає на нову роботу і виконує її завдання.
+ */
+void ScanExecutor::WorkerLoop() {
+    uint64_t seen = 0;
+    while (true) {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || (current && generation != seen); });
+            if (stopping) return;
+            seen = generation;
+            job = current;
+        }
+        Drain(*job);
+    }
+}
+
+/**
+ * @brief Виконує завдання, поки лічильник не дійде до кінця.
+ *
+ * Завдання роздаються через атомарний лічильник, тому швидші потоки
+ * автоматично беруть більше роботи. Потік, що прокинувся запізно,
+ * просто знаходить вичерпаний лічильник своєї роботи і нічого не робить.
+ *
+ * Виняток не виходить за межі Drain: у робочому потоці він викликав би
+ * std::terminate, а в потоці виклику ParallelFor повернувся б, поки інші
+ * потоки ще виконують fn. Завдання з винятком теж рахується виконаним,
+ * інакше ParallelFor чекав би вічно.
+ * @param job Робота.
+ */
+void ScanExecutor::Drain(Job &job) {
+    size_t done = 0;
+    std::exception_ptr error;
+    while (true) {
+        size_t task = job.next.fetch_add(1);
+        if (task >= job.tasks) break;
+        done++;
+        if (job.failed.load(std::memory_order_relaxed)) continue;
+        try {
+            (*job.fn)(task);
+        } catch (...) {
+            if (!error) error = std::current_exception();
+            job.failed.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    if (done == 0) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (error && !job.error) job.error = error;
+    job.done += done;
+    if (job.done == job.tasks) finished.notify_all();
+}
+
+// -------------------------------------------------------------
+//                     PARALLEL FOR
+// -------------------------------------------------------------
+
+/**
+ * @brief Розподіляє завдання між потоками пулу і чекає на завершення.
+ *
+ * Виняток із завдання перекидається лише після того, як усі потоки
+ * відзвітували, тож посилання на fn більше ніхто не тримає.
+ * @param tasks Кількість завдань.
+ * @param fn Тіло завдання.
+ */
+void ScanExecutor::ParallelFor(size_t tasks, const std::function<void(size_t)> &fn) {
+    if (tasks == 0) return;
+
+    // Пул уже зайнятий (або потоків немає) — виконуємо все тут же
+    std::unique_lock<std::mutex> job(jobMutex, std::try_to_lock);
+    if (!job.owns_lock() || workers.empty() || tasks == 1) {
+        for (size_t i = 0; i < tasks; ++i) fn(i);
+        return;
+    }
+
+    auto work = std::make_shared<Job>();
+    work->fn = &fn;
+    work->tasks = tasks;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        current = work;
+        generation++;
+    }
+    wake.notify_all();
+
+    Drain(*work);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&] { return work->done == work->tasks; });
+    current.reset();
+    std::exception_ptr error = work->error;
+    lock.unlock();
+    if (error) std::rethrow_exception(error);
+}
+
+// -------------------------------------------------------------
+//                     FILTER
+// -------------------------------------------------------------
+
+/**
+ * @brief Паралельний відбір термінів за умовою.
+ *
+ * Блоки знімка діляться на неперервні діапазони (кілька діапазонів на потік,
+ * щоб вирівняти навантаження). Кожен діапазон пише у власний буфер, після
+ * чого буфери з'єднуються по порядку.
+ *
+ * @param snapshot Знімок бази.
+ * @param predicate Умова відбору.
+ * @return Знайдені терміни у порядку бази.
+ */
+std::vector<TermSnapshot::TermPtr> ScanExecutor::Filter(const TermSnapshot &snapshot,
+                                                        const Predicate &predicate) {
+    const auto &chunks = snapshot.GetChunks();
+    std::vector<TermSnapshot::TermPtr> result;
+
+    // Для малої бази накладні витрати на потоки більші за виграш
+    if (chunks.size() < kMinParallelChunks || workers.empty()) {
+        for (const auto &chunk : chunks) {
+            for (const auto &t : *chunk) {
+                if (predicate(*t)) result.push_back(t);
+            }
+        }
+        return result;
+    }
+
+    size_t ranges = std::min(chunks.size(), GetThreadCount() * 4);
+    std::vector<std::vector<TermSnapshot::TermPtr>> partial(ranges);
+
+    ParallelFor(ranges, [&](size_t r) {
+        size_t begin = chunks.size() * r / ranges;
+        size_t end = chunks.size() * (r + 1) / ranges;
+        auto &local = partial[r];
+        for (size_t c = begin; c < end; ++c) {
+            for (const auto &t : *chunks[c]) {
+                if (predicate(*t)) local.push_back(t);
+            }
+        }
+    });
+
+    size_t total = 0;
+    for (const auto &p : partial) total += p.size();
+    result.reserve(total);
+    for (auto &p : partial) {
+        result.insert(result.end(),
+                      std::make_move_iterator(p.begin()),
+                      std::make_move_iterator(p.end()));
+    }
+    return result;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file ScanExecutor.h
+ * @brief Оголошення пулу потоків для паралельного перегляду бази термінів.
+ */
+
+#ifndef KURSOVA_SCANEXECUTOR_H
+#define KURSOVA_SCANEXECUTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "TermSnapshot.h"
+
+/**
+ * @class ScanExecutor
+ * @brief Пул робочих потоків для запитів, які не може обслужити жоден індекс.
+ *
+ * Знімок бази ділиться на неперервні діапазони блоків, кожен потік перевіряє
+ * умову на своєму діапазоні і складає збіги у власний буфер. Потім буфери
+ * з'єднуються у вихідному порядку, тому результат збігається з послідовним
+ * переглядом.
+ *
+ * Потік, що викликав метод, теж бере участь у роботі. Якщо пул уже зайнятий
+ * іншим запитом, робота виконується у потоці виклику (без очікування).
+ */
+class ScanExecutor {
+public:
+    /** @brief Умова відбору терміна. */
+    using Predicate = std::function<bool(const TermBase &)>;
+
+    /**
+     * @brief Мінімальна кількість блоків, починаючи з якої має сенс паралелити.
+     */
+    static constexpr size_t kMinParallelChunks = 8;
+
+    /**
+     * @brief Створює пул потоків.
+     * @param threads Кількість потоків (0 — за кількістю ядер).
+     */
+    explicit ScanExecutor(size_t threads = 0);
+
+    /**
+     * @brief Зупиняє та приєднує робочі потоки.
+     */
+    ~ScanExecutor();
+
+    ScanExecutor(const ScanExecutor &) = delete;
+    ScanExecutor &operator=(const ScanExecutor &) = delete;
+
+    /**
+     * @brief Повертає терміни, для яких виконується умова, у порядку бази.
+     * @param snapshot Знімок, що переглядається.
+     * @param predicate Умова відбору.
+     * @return Список знайдених термінів.
+     */
+    std::vector<TermSnapshot::TermPtr> Filter(const TermSnapshot &snapshot,
+                                              const Predicate &predicate);
+
+    /**
+     * @brief Виконує fn(0) ... fn(tasks - 1) на потоках пулу.
+     *
+     * Метод повертається, коли всі завдання виконано. Якщо fn кидає виняток,
+     * решта завдань пропускається, а перший виняток перекидається тут, уже
+     * після того, як жоден потік не звертається до fn.
+     * @param tasks Кількість завдань.
+     * @param fn Тіло завдання.
+     */
+    void ParallelFor(size_t tasks, const std::function<void(size_t)> &fn);
+
+    /**
+     * @brief Кількість потоків, що виконують роботу (разом із потоком виклику).
+     */
+    size_t GetThreadCount() const;
+
+private:
+    /**
+     * @brief Головний цикл робочого потоку.
+     */
+    void WorkerLoop();
+
+    /**
+     * @brief Одна робота, розподілена між потоками.
+     */
+    struct Job {
+        const std::function<void(size_t)> *fn = nullptr;
+        size_t tasks = 0;
+        std::atomic<size_t> next{0};
+        size_t done = 0;
+        /** @brief Завдання кинуло виняток: решта лише рахується як виконана. */
+        std::atomic<bool> failed{false};
+        /** @brief Перший виняток (захищений mutex). */
+        std::exception_ptr error;
+    };
+
+    /**
+     * @brief Бере й виконує завдання роботи, доки вони не скінчаться.
+     * @param job Робота, до якої долучається потік.
+     */
+    void Drain(Job &job);
+
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+
+    /** @brief Дозволяє лише одну роботу в пулі одночасно. */
+    std::mutex jobMutex;
+
+    std::shared_ptr<Job> current;
+    uint64_t generation = 0;
+    bool stopping = false;
+};
+
+#endif //KURSOVA_SCANEXECUTOR_H
@@ -0,0 +1,195 @@
+/**
+ * @file SessionTable.cpp
+ * @brief Реалізація таблиці сесій з відкритою адресацією.
+ */
+
+#include "SessionTable.h"
+#include "Crypto.h"
+
+#include <cstring>
+
+// -------------------------------------------------------------
+//                     CONSTRUCTOR
+// -------------------------------------------------------------
+
+/**
+ * @brief Виділяє всі комірки одразу; далі таблиця не росте.
+ * @param capacity Бажана кількість комірок.
+ * @param ttl Час життя сесії.
+ */
+SessionTable::SessionTable(size_t capacity, std::chrono::seconds ttl)
+        : ttl(ttl) {
+    size_t size = 16;
+    while (size < capacity) size <<= 1;
+    slots.resize(size);
+    mask = size - 1;
+}
+
+// -------------------------------------------------------------
+//                     HELPERS
+// -------------------------------------------------------------
+
+/**
+ * @brief Декодує hex-токен фіксованої довжини.
+ */
+bool SessionTable::ParseToken(const std::string &hex, Token &out) {
+    std::string raw;
+    if (hex.size() != kTokenBytes * 2 || !Crypto::FromHex(hex, raw)) return false;
+    std::memcpy(out.data(), raw.data(), kTokenBytes);
+    return true;
+}
+
+/**
+ * @brief Токен випадковий, тому його перші 8 байтів — готовий хеш.
+ */
+size_t SessionTable::HomeSlot(const Token &token) const {
+    uint64_t h = 0;
+    std::memcpy(&h, token.data(), sizeof(h));
+    return static_cast<size_t>(h) & mask;
+}
+
+/**
+ * @brief Лінійне зондування до першої порожньої комірки.
+ */
+size_t SessionTable::FindSlot(const Token &token) const {
+    size_t i = HomeSlot(token);
+    for (size_t probe = 0; probe < slots.size(); ++probe, i = (i + 1) & mask) {
+        const Slot &slot = slots[i];
+        if (slot.state == SlotState::Empty) break;
+        if (slot.state == SlotState::Used &&
+            Crypto::ConstantTimeEquals(slot.token.data(), token.data(), kTokenBytes)) {
+            return i;
+        }
+    }
+    return slots.size();
+}
+
+/**
+ * @brief Залишає в комірці позначку, щоб зондування йшло далі.
+ */
+void SessionTable::Release(Slot &slot) {
+    slot.state = SlotState::Deleted;
+    slot.username.clear();
+    used--;
+    deleted++;
+}
+
+/**
+ * @brief Виносить живі сесії, очищає всі комірки і вставляє сесії назад.
+ */
+void SessionTable::Rehash(Clock::time_point now) {
+    std::vector<Slot> live;
+    live.reserve(used);
+    for (auto &slot : slots) {
+        if (slot.state == SlotState::Used && slot.expires > now) live.push_back(std::move(slot));
+        slot = Slot();
+    }
+
+    for (auto &session : live) {
+        size_t i = HomeSlot(session.token);
+        while (slots[i].state != SlotState::Empty) i = (i + 1) & mask;
+        slots[i] = std::move(session);
+    }
+    used = live.size();
+    deleted = 0;
+}
+
+// -------------------------------------------------------------
+//                     OPEN / VALIDATE / CLOSE
+// -------------------------------------------------------------
+
+/**
+ * @brief Видає новий токен і записує сесію у таблицю.
+ *
+ * Зайняті й позначені комірки разом не перевищують 3/4 ємності, щоб ланцюжки
+ * зондування залишались короткими.
+ * @param username Логін.
+ * @param permissions Маска прав.
+ * @return Токен у hex або "" при переповненні.
+ */
+std::string SessionTable::Open(const std::string &username, uint32_t permissions) {
+    Token token{};
+    std::string raw = Crypto::RandomBytes(kTokenBytes);
+    std::memcpy(token.data(), raw.data(), kTokenBytes);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto now = Clock::now();
+    if ((used + deleted + 1) * 4 > slots.size() * 3) {
+        Rehash(now);
+        if ((used + 1) * 4 > slots.size() * 3) return "";
+    }
+
+    size_t i = HomeSlot(token);
+    while (true) {
+        Slot &slot = slots[i];
+        bool stale = slot.state == SlotState::Used && slot.expires <= now;
+        if (slot.state != SlotState::Used || stale) {
+            if (slot.state == SlotState::Deleted) deleted--;
+            if (!stale) used++;
+            slot.token = token;
+            slot.expires = now + ttl;
+            slot.permissions = permissions;
+            slot.username = username;
+            slot.state = SlotState::Used;
+            break;
+        }
+        i = (i + 1) & mask;
+    }
+
+    return Crypto::ToHex(token.data(), kTokenBytes);
+}
+
+/**
+ * @brief Перевіряє токен і повертає дані сесії.
+ * @param token Токен у hex.
+ * @param out Дані сесії.
+ * @return true, якщо сесія дійсна.
+ */
+bool SessionTable::Validate(const std::string &token, Session &out) const {
+    Token parsed{};
+    if (!ParseToken(token, parsed)) return false;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t i = FindSlot(parsed);
+    if (i == slots.size()) return false;
+
+    const Slot &slot = slots[i];
+    if (slot.expires <= Clock::now()) return false;
+
+    out.username = slot.username;
+    out.permissions = slot.permissions;
+    return true;
+}
+
+/**
+ * @brief Закриває сесію за токеном.
+ */
+bool SessionTable::Close(const std::string &token) {
+    Token parsed{};
+    if (!ParseToken(token, parsed)) return false;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t i = FindSlot(parsed);
+    if (i == slots.size()) return false;
+
+    Release(slots[i]);
+    return true;
+}
+
+/**
+ * @brief Закриває всі сесії користувача (повний прохід, операція рідкісна).
+ */
+void SessionTable::CloseAllFor(const std::string &username) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto &slot : slots) {
+        if (slot.state == SlotState::Used && slot.username == username) Release(slot);
+    }
+}
+
+/**
+ * @brief Кількість зайнятих комірок (включно з ще не прибраними простроченими).
+ */
+size_t SessionTable::GetActiveCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return used;
+}
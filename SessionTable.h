@@ -0,0 +1,152 @@
+/**
+ * @file SessionTable.h
+ * @brief Оголошення таблиці сесій (токенів доступу).
+ */
+
+#ifndef KURSOVA_SESSIONTABLE_H
+#define KURSOVA_SESSIONTABLE_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @struct Session
+ * @brief Дані, що повертаються при перевірці токена.
+ */
+struct Session {
+    /** @brief Логін власника сесії. */
+    std::string username;
+    /** @brief Маска прав (Permission), зафіксована під час входу. */
+    uint32_t permissions = 0;
+};
+
+/**
+ * @class SessionTable
+ * @brief Таблиця сесій фіксованого розміру з відкритою адресацією.
+ *
+ * Після успішного входу видається непрозорий токен (128 випадкових бітів
+ * у hex). Подальші запити перевіряють лише токен: пошук у таблиці займає
+ * O(1) і не звертається ні до списку користувачів, ні до хешів паролів.
+ *
+ * Токени випадкові, тому їхні перші байти використовуються як хеш комірки
+ * (лінійне зондування). Порівняння токена виконується за сталий час.
+ * Прострочені записи вважаються вільними і перевикористовуються.
+ *
+ * Закрита сесія лишає в комірці позначку Deleted, щоб не розірвати ланцюжок
+ * зондування. Позначки рахуються разом з активними записами: коли разом
+ * вони займуть 3/4 таблиці, Open перебудовує її на місці (Rehash), тож
+ * пошук завжди дійде до порожньої комірки за кілька кроків.
+ */
+class SessionTable {
+public:
+    /** @brief Кількість байтів токена. */
+    static constexpr size_t kTokenBytes = 16;
+
+    /**
+     * @brief Створює таблицю.
+     * @param capacity Кількість комірок (округлюється вгору до степеня двійки).
+     * @param ttl Час життя сесії.
+     */
+    explicit SessionTable(size_t capacity = 16384,
+                          std::chrono::seconds ttl = std::chrono::minutes(30));
+
+    /**
+     * @brief Відкриває нову сесію.
+     * @param username Логін.
+     * @param permissions Маска прав.
+     * @return Токен у hex або порожній рядок, якщо таблиця переповнена.
+     */
+    std::string Open(const std::string &username, uint32_t permissions);
+
+    /**
+     * @brief Перевіряє токен.
+     * @param token Токен у hex.
+     * @param out Дані сесії у разі успіху.
+     * @return true, якщо сесія існує і не прострочена.
+     */
+    bool Validate(const std::string &token, Session &out) const;
+
+    /**
+     * @brief Закриває сесію.
+     * @param token Токен у hex.
+     * @return true, якщо сесію знайдено.
+     */
+    bool Close(const std::string &token);
+
+    /**
+     * @brief Закриває всі сесії користувача (наприклад, після видалення облікового запису).
+     * @param username Логін.
+     */
+    void CloseAllFor(const std::string &username);
+
+    /**
+     * @brief Кількість активних сесій.
+     */
+    size_t GetActiveCount() const;
+
+private:
+    using Token = std::array<uint8_t, kTokenBytes>;
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Стан комірки таблиці.
+     */
+    enum class SlotState : uint8_t {
+        Empty,
+        Used,
+        Deleted
+    };
+
+    /**
+     * @brief Комірка таблиці.
+     */
+    struct Slot {
+        Token token{};
+        Clock::time_point expires;
+        uint32_t permissions = 0;
+        SlotState state = SlotState::Empty;
+        std::string username;
+    };
+
+    /**
+     * @brief Перетворює hex-токен у байти.
+     */
+    static bool ParseToken(const std::string &hex, Token &out);
+
+    /**
+     * @brief Початкова комірка зондування для токена.
+     */
+    size_t HomeSlot(const Token &token) const;
+
+    /**
+     * @brief Шукає комірку з токеном (викликати під mutex).
+     * @return Індекс комірки або capacity, якщо не знайдено.
+     */
+    size_t FindSlot(const Token &token) const;
+
+    /**
+     * @brief Позначає комірку як видалену (викликати під mutex).
+     */
+    void Release(Slot &slot);
+
+    /**
+     * @brief Перебудовує таблицю без позначок і прострочених сесій (викликати під mutex).
+     *
+     * Розмір таблиці не змінюється; активні сесії вставляються заново.
+     */
+    void Rehash(Clock::time_point now);
+
+    std::vector<Slot> slots;
+    size_t mask;
+    std::chrono::seconds ttl;
+    size_t used = 0;
+    /** @brief Комірок з позначкою Deleted. */
+    size_t deleted = 0;
+    mutable std::mutex mutex;
+};
+
+#endif //KURSOVA_SESSIONTABLE_H
@@ -0,0 +1,221 @@
+/**
+ * @file ShardStore.cpp
+ * @brief Реалізація розбитого на шарди сховища бази термінів.
+ */
+
+#include "ShardStore.h"
+#include "Utils.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+// -------------------------------------------------------------
+//                     CONSTRUCTOR
+// -------------------------------------------------------------
+
+/**
+ * @brief Читає маніфест; без нього сховище порожнє з заданою кількістю шардів.
+ */
+ShardStore::ShardStore(std::string directory, size_t shards)
+        : directory(std::move(directory)) {
+    if (!ReadManifest()) {
+        this->shards.assign(shards == 0 ? 1 : shards, Shard{});
+        generation = 0;
+    }
+    count = this->shards.size();
+    changed.reset(new std::atomic<uint64_t>[count]);
+    for (size_t i = 0; i < count; ++i) changed[i].store(0);
+}
+
+/**
+ * @brief stat і перевірка типу.
+ */
+bool ShardStore::IsDirectory(const std::string &path) {
+    struct stat info {};
+    return ::stat(path.c_str(), &info) == 0 && (info.st_mode & S_IFMT) == S_IFDIR;
+}
+
+/**
+ * @brief mkdir; наявний каталог — не помилка.
+ */
+bool ShardStore::MakeDirectory(const std::string &path, std::string &error) {
+#ifdef _WIN32
+    int rc = ::_mkdir(path.c_str());
+#else
+    int rc = ::mkdir(path.c_str(), 0777);
+#endif
+    if (rc == 0 || (errno == EEXIST && IsDirectory(path))) return true;
+    error = "mkdir " + path + ": " + std::strerror(errno);
+    return false;
+}
+
+// -------------------------------------------------------------
+//                     MANIFEST
+// -------------------------------------------------------------
+
+/**
+ * @brief Розбирає маніфест; некоректний маніфест не використовується.
+ *
+ * Краще не завантажити нічого й повідомити, ніж тихо втратити шарди:
+ * помилку видно через Error(), і TermManager не зберігає базу в такий
+ * каталог, тож наявні файли шардів лишаються недоторканими.
+ */
+bool ShardStore::ReadManifest() {
+    std::ifstream in(directory + "/" + kManifestName);
+    if (!in.is_open()) return false;
+
+    std::string line;
+    if (!std::getline(in, line)) {
+        error = "порожній маніфест";
+        return false;
+    }
+    auto header = Utils::Split(line, ';');
+    size_t total = header.size() >= 3 && header[0] == "SHARDS" ? std::strtoul(header[1].c_str(), nullptr, 10) : 0;
+    if (total == 0) {
+        error = "некоректний заголовок маніфесту: " + line;
+        return false;
+    }
+
+    std::vector<Shard> parsed(total);
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        auto parts = Utils::Split(line, ';');
+        size_t index = parts.size() >= 3 ? std::strtoul(parts[0].c_str(), nullptr, 10) : total;
+        if (index >= total) {
+            error = "некоректний рядок маніфесту: " + line;
+            return false;
+        }
+        parsed[index].file = parts[1];
+        parsed[index].terms = std::strtoul(parts[2].c_str(), nullptr, 10);
+    }
+
+    shards = std::move(parsed);
+    generation = std::strtoull(header[2].c_str(), nullptr, 10);
+    hasManifest = true;
+    return true;
+}
+
+/**
+ * @brief Маніфест прочитано.
+ */
+bool ShardStore::HasManifest() const {
+    return hasManifest;
+}
+
+/**
+ * @brief Опис помилки маніфесту.
+ */
+const std::string &ShardStore::Error() const {
+    return error;
+}
+
+/**
+ * @brief "shard-007.12.csv": номер шарду і покоління.
+ */
+std::string ShardStore::FileName(size_t shard, uint64_t generation) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "shard-%03zu.%llu.csv", shard,
+                  static_cast<unsigned long long>(generation));
+    return name;
+}
+
+/**
+ * @brief Пише шарди наступного покоління в маніфест і атомарно його замінює.
+ */
+bool ShardStore::Commit(const std::vector<size_t> &written, const std::vector<size_t> &termCounts,
+                        IoBackend backend, AtomicFile::Stats &stats, std::string &error) {
+    std::vector<Shard> next = shards;
+    for (size_t i = 0; i < written.size(); ++i) {
+        next[written[i]].file = FileName(written[i], generation + 1);
+        next[written[i]].terms = termCounts[i];
+    }
+
+    std::string text = "SHARDS;" + std::to_string(next.size()) + ";" + std::to_string(generation + 1) + "\n";
+    for (size_t i = 0; i < next.size(); ++i) {
+        text += std::to_string(i) + ";" + next[i].file + ";" + std::to_string(next[i].terms) + "\n";
+    }
+
+    AtomicFile out(directory + "/" + kManifestName, backend);
+    out.Write(text);
+    bool ok = out.Commit();
+    stats = out.GetStats();
+    if (!ok) {
+        error = out.Error();
+        return false;
+    }
+
+    // Маніфест уже посилається на нові файли: старі більше нікому не потрібні
+    for (size_t shard : written) {
+        if (!shards[shard].file.empty() && shards[shard].file != next[shard].file) {
+            std::remove((directory + "/" + shards[shard].file).c_str());
+        }
+    }
+    shards = std::move(next);
+    generation++;
+    hasManifest = true;
+    return true;
+}
+
+// -------------------------------------------------------------
+//                     SHARDS
+// -------------------------------------------------------------
+
+/**
+ * @brief Кількість шардів.
+ */
+size_t ShardStore::GetShardCount() const {
+    return count;
+}
+
+/**
+ * @brief FNV-1a: однаковий результат на всіх платформах, на відміну від std::hash.
+ */
+size_t ShardStore::ShardOf(const std::string &foldedName) const {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : foldedName) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return static_cast<size_t>(hash % count);
+}
+
+/**
+ * @brief Шлях до поточного файлу шарду.
+ */
+std::string ShardStore::CurrentPath(size_t shard) const {
+    return shards[shard].file.empty() ? std::string() : directory + "/" + shards[shard].file;
+}
+
+/**
+ * @brief Шлях до файлу шарду наступного покоління.
+ */
+std::string ShardStore::NextPath(size_t shard) const {
+    return directory + "/" + FileName(shard, generation + 1);
+}
+
+/**
+ * @brief Запам'ятовує найновішу версію, в якій змінювався шард.
+ */
+void ShardStore::MarkChanged(size_t shard, uint64_t version) {
+    uint64_t seen = changed[shard].load();
+    while (seen < version && !changed[shard].compare_exchange_weak(seen, version)) {}
+}
+
+/**
+ * @brief Перелічує шарди з позначкою, новішою за version.
+ */
+std::vector<size_t> ShardStore::ChangedSince(uint64_t version) const {
+    std::vector<size_t> result;
+    for (size_t i = 0; i < count; ++i) {
+        if (changed[i].load() > version) result.push_back(i);
+    }
+    return result;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file ShardStore.h
+ * @brief Оголошення розбитого на шарди сховища бази термінів.
+ */
+
+#ifndef KURSOVA_SHARDSTORE_H
+#define KURSOVA_SHARDSTORE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AtomicFile.h"
+
+/**
+ * @class ShardStore
+ * @brief Каталог з N файлами-шардами і маніфестом.
+ *
+ * Термін потрапляє в шард за хешем назви у нижньому регістрі (FNV-1a, не
+ * залежить від платформи). Кожен шард — звичайний CSV у форматі terms.csv,
+ * тому шарди можна читати й писати незалежно і паралельно. Рядок шарду
+ * додатково закінчується порядковим номером терміна: за ним шарди
+ * зливаються назад у порядок бази.
+ *
+ * Маніфест ("manifest") перелічує поточний файл кожного шарду:
+ * @code
+ * SHARDS;<кількість>;<покоління>
+ * <номер>;<файл>;<термінів>
+ * @endcode
+ * Збереження пише змінені шарди в нові файли наступного покоління і лише
+ * потім атомарно замінює маніфест, тож після збою база на диску — або
+ * повністю стара, або повністю нова. Файли попереднього покоління
+ * видаляються після фіксації маніфесту.
+ *
+ * Які шарди змінилися, відстежується версіями знімків (MarkChanged /
+ * ChangedSince): позначки атомарні і ніколи не скидаються, шард вважається
+ * зміненим, якщо його позначка новіша за збережену версію.
+ *
+ * ShardOf, GetShardCount і позначки безпечні з будь-якого потоку; шляхи
+ * до файлів і Commit — лише під блокуванням збережень власника.
+ */
+class ShardStore {
+public:
+    /** @brief Кількість шардів нового сховища за замовчуванням. */
+    static constexpr size_t kDefaultShards = 16;
+
+    /** @brief Назва файлу маніфесту в каталозі. */
+    static constexpr const char *kManifestName = "manifest";
+
+    /**
+     * @brief Відкриває каталог і читає маніфест, якщо він є.
+     * @param directory Каталог сховища.
+     * @param shards Кількість шардів, якщо маніфесту ще немає.
+     */
+    explicit ShardStore(std::string directory, size_t shards = kDefaultShards);
+
+    /**
+     * @brief Чи є шлях каталогом.
+     */
+    static bool IsDirectory(const std::string &path);
+
+    /**
+     * @brief Створює каталог (якщо його немає).
+     * @param error Опис помилки.
+     * @return false, якщо каталог не створено.
+     */
+    static bool MakeDirectory(const std::string &path, std::string &error);
+
+    /**
+     * @brief Чи був маніфест при відкритті.
+     */
+    bool HasManifest() const;
+
+    /**
+     * @brief Опис помилки читання маніфесту (порожньо, якщо все гаразд).
+     */
+    const std::string &Error() const;
+
+    /**
+     * @brief Кількість шардів.
+     */
+    size_t GetShardCount() const;
+
+    /**
+     * @brief Номер шарду для назви.
+     * @param foldedName Назва у нижньому регістрі (Utils::FoldUTF8).
+     */
+    size_t ShardOf(const std::string &foldedName) const;
+
+    /**
+     * @brief Поточний файл шарду.
+     * @return Повний шлях або порожній рядок, якщо шард ще не записувався.
+     */
+    std::string CurrentPath(size_t shard) const;
+
+    /**
+     * @brief Файл, у який шард буде записано наступним збереженням.
+     */
+    std::string NextPath(size_t shard) const;
+
+    /**
+     * @brief Позначає шард як змінений у версії version.
+     */
+    void MarkChanged(size_t shard, uint64_t version);
+
+    /**
+     * @brief Шарди, змінені після версії version, у порядку номерів.
+     */
+    std::vector<size_t> ChangedSince(uint64_t version) const;
+
+    /**
+     * @brief Фіксує записані шарди новим маніфестом.
+     *
+     * Файли NextPath(shard) мають бути вже записані й синхронізовані.
+     * Після успіху вони стають поточними, а старі файли цих шардів видаляються.
+     * @param written Записані шарди.
+     * @param termCounts Кількість термінів у кожному записаному шарді.
+     * @param backend Спосіб запису маніфесту.
+     * @param stats Виміри запису маніфесту.
+     * @param error Опис помилки.
+     */
+    bool Commit(const std::vector<size_t> &written, const std::vector<size_t> &termCounts,
+                IoBackend backend, AtomicFile::Stats &stats, std::string &error);
+
+private:
+    /**
+     * @brief Опис одного шарду в маніфесті.
+     */
+    struct Shard {
+        std::string file;
+        size_t terms = 0;
+    };
+
+    /**
+     * @brief Читає маніфест.
+     */
+    bool ReadManifest();
+
+    /**
+     * @brief Ім'я файлу шарду для покоління.
+     */
+    static std::string FileName(size_t shard, uint64_t generation);
+
+    std::string directory;
+
+    /** @brief Кількість шардів; не змінюється після конструктора (читається без блокувань). */
+    size_t count = 0;
+
+    /** @brief Файли шардів (змінює лише Commit; викликачі впорядковують доступ самі). */
+    std::vector<Shard> shards;
+    uint64_t generation = 0;
+    bool hasManifest = false;
+    std::string error;
+
+    /** @brief Версія знімка, в якій шард змінювався востаннє. */
+    std::unique_ptr<std::atomic<uint64_t>[]> changed;
+};
+
+#endif //KURSOVA_SHARDSTORE_H
@@ -0,0 +1,543 @@
+/**
+ * @file Simd.cpp
+ * @brief Реалізація векторизованих ядер обробки тексту.
+ *
+ * Для x86 використовуються інтринсики SSE2/AVX2/SSE4.2 з атрибутом target,
+ * тому файл не потребує спеціальних прапорів компіляції. На ARM CRC32C
+ * рахується інструкціями ARMv8, якщо компілятор їх дозволяє; решта
+ * функцій там, як і на інших архітектурах, — скалярні.
+ */
+
+#include "Simd.h"
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KURSOVA_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+#define KURSOVA_CRC_ARM 1
+#include <arm_acle.h>
+#endif
+
+namespace Simd {
+
+    namespace {
+
+        // -----------------------------------------------------------
+        //  Скалярні допоміжні функції
+        // -----------------------------------------------------------
+
+        /**
+         * @brief Приводить латинську літеру до нижнього регістру.
+         */
+        inline char FoldByte(char c) {
+            return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+        }
+
+        /**
+         * @brief Порівнює текст із шуканим рядком, починаючи з позиції p.
+         */
+        inline bool MatchAt(const char *p, const std::string &needle) {
+            for (size_t j = 0; j < needle.size(); ++j) {
+                if (FoldByte(p[j]) != needle[j]) return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Скалярний пошук (перевірка кожної позиції).
+         */
+        size_t FindFoldedScalar(const char *text, size_t length, const std::string &needle) {
+            size_t k = needle.size();
+            if (k == 0) return 0;
+            if (length < k) return npos;
+
+            for (size_t i = 0; i + k <= length; ++i) {
+                if (FoldByte(text[i]) == needle[0] && MatchAt(text + i, needle)) return i;
+            }
+            return npos;
+        }
+
+        /**
+         * @brief Скалярний пошук одного з двох байтів.
+         */
+        size_t FindEitherScalar(const char *text, size_t length, char a, char b) {
+            for (size_t i = 0; i < length; ++i) {
+                if (text[i] == a || text[i] == b) return i;
+            }
+            return length;
+        }
+
+        /**
+         * @brief Скалярний пошук великої кириличної літери.
+         */
+        size_t FindCyrillicUpperScalar(const char *text, size_t length) {
+            for (size_t i = 0; i + 1 < length; ++i) {
+                auto lead = static_cast<unsigned char>(text[i]);
+                auto next = static_cast<unsigned char>(text[i + 1]);
+                if ((lead == 0xD0 && next >= 0x80 && next <= 0xAF) || (lead == 0xD2 && next == 0x90)) return i;
+            }
+            return length;
+        }
+
+        // -----------------------------------------------------------
+        //  CRC32C: таблиці та скалярна версія
+        // -----------------------------------------------------------
+
+        /** @brief Поліном Кастаньолі у відображеному вигляді. */
+        constexpr uint32_t kCrcPolynomial = 0x82F63B78u;
+
+        /**
+         * @brief Довжина смуги, на які ділиться довгий фрагмент (див. CrcRawSse42).
+         */
+        constexpr size_t kCrcLane = 4096;
+
+        /**
+         * @brief Таблиці slicing-by-8: t[k][b] — внесок байта b, за яким іде k нульових байтів.
+         */
+        struct CrcTables {
+            uint32_t t[8][256];
+        };
+
+        /**
+         * @brief Будує таблиці slicing-by-8 (один раз за запуск).
+         */
+        const CrcTables &SoftTables() {
+            static const CrcTables tables = [] {
+                CrcTables built{};
+                for (uint32_t b = 0; b < 256; ++b) {
+                    uint32_t crc = b;
+                    for (int bit = 0; bit < 8; ++bit) crc = (crc >> 1) ^ (kCrcPolynomial & (0u - (crc & 1u)));
+                    built.t[0][b] = crc;
+                }
+                for (int k = 1; k < 8; ++k) {
+                    for (uint32_t b = 0; b < 256; ++b) {
+                        uint32_t previous = built.t[k - 1][b];
+                        built.t[k][b] = (previous >> 8) ^ built.t[0][previous & 0xFF];
+                    }
+                }
+                return built;
+            }();
+            return tables;
+        }
+
+        /**
+         * @brief CRC32C без початкової і кінцевої інверсії, по 8 байтів за крок.
+         *
+         * Байти збираються в слово явно, тож результат не залежить від
+         * порядку байтів платформи.
+         */
+        uint32_t CrcRawScalar(uint32_t crc, const unsigned char *p, size_t length) {
+            const auto &t = SoftTables().t;
+            for (; length >= 8; p += 8, length -= 8) {
+                uint32_t low = crc ^ (static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+                                      static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24);
+                crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+                      t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+            }
+            for (; length > 0; ++p, --length) crc = t[0][(crc ^ *p) & 0xFF] ^ (crc >> 8);
+            return crc;
+        }
+
+#ifdef KURSOVA_SIMD_X86
+
+        // -----------------------------------------------------------
+        //  SSE2: 16 байтів за крок
+        // -----------------------------------------------------------
+
+        /**
+         * @brief Приводить 16 байтів до нижнього регістру (тільки A-Z).
+         *
+         * Байти >= 0x80 при знаковому порівнянні від'ємні, тому не змінюються.
+         */
+        __attribute__((target("sse2")))
+        inline __m128i Fold16(__m128i v) {
+            __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)),
+                                          _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+            return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+        }
+
+        /**
+         * @brief Пошук із відбором кандидатів за першим і останнім байтом.
+         *
+         * За один крок перевіряється 16 можливих позицій початку: позиція
+         * стає кандидатом, якщо збігаються і перший, і останній байт шуканого
+         * рядка. Лише кандидати перевіряються повністю.
+         */
+        __attribute__((target("sse2")))
+        size_t FindFoldedSse2(const char *text, size_t length, const std::string &needle) {
+            size_t k = needle.size();
+            if (k == 0) return 0;
+            if (length < k) return npos;
+
+            const __m128i first = _mm_set1_epi8(needle[0]);
+            const __m128i last = _mm_set1_epi8(needle[k - 1]);
+
+            size_t i = 0;
+            for (; i + k - 1 + 16 <= length; i += 16) {
+                __m128i a = Fold16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i)));
+                __m128i b = Fold16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i + k - 1)));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+                        _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+                while (mask != 0) {
+                    unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+                    if (MatchAt(text + i + bit, needle)) return i + bit;
+                    mask &= mask - 1;
+                }
+            }
+
+            // Хвіст, коротший за один вектор
+            for (; i + k <= length; ++i) {
+                if (MatchAt(text + i, needle)) return i;
+            }
+            return npos;
+        }
+
+        /**
+         * @brief Пошук одного з двох байтів по 16 байтів за крок.
+         */
+        __attribute__((target("sse2")))
+        size_t FindEitherSse2(const char *text, size_t length, char a, char b) {
+            const __m128i va = _mm_set1_epi8(a);
+            const __m128i vb = _mm_set1_epi8(b);
+
+            size_t i = 0;
+            for (; i + 16 <= length; i += 16) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+                        _mm_or_si128(_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb))));
+                if (mask != 0) return i + static_cast<unsigned>(__builtin_ctz(mask));
+            }
+            return i + FindEitherScalar(text + i, length - i, a, b);
+        }
+
+        /**
+         * @brief Пошук великої кириличної літери по 16 позицій за крок.
+         *
+         * Другий вектор зсунутий на байт і дає наступний байт пари. Байти
+         * 0x80–0xAF при знаковому порівнянні менші за (char)0xB0.
+         */
+        __attribute__((target("sse2")))
+        size_t FindCyrillicUpperSse2(const char *text, size_t length) {
+            const __m128i d0 = _mm_set1_epi8(static_cast<char>(0xD0));
+            const __m128i d2 = _mm_set1_epi8(static_cast<char>(0xD2));
+            const __m128i b0 = _mm_set1_epi8(static_cast<char>(0xB0));
+            const __m128i g = _mm_set1_epi8(static_cast<char>(0x90));
+
+            size_t i = 0;
+            for (; i + 1 + 16 <= length; i += 16) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i));
+                __m128i n = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i + 1));
+                __m128i hit = _mm_or_si128(_mm_and_si128(_mm_cmpeq_epi8(v, d0), _mm_cmplt_epi8(n, b0)),
+                                           _mm_and_si128(_mm_cmpeq_epi8(v, d2), _mm_cmpeq_epi8(n, g)));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hit));
+                if (mask != 0) return i + static_cast<unsigned>(__builtin_ctz(mask));
+            }
+            return i + FindCyrillicUpperScalar(text + i, length - i);
+        }
+
+        // -----------------------------------------------------------
+        //  AVX2: 32 байти за крок
+        // -----------------------------------------------------------
+
+        /**
+         * @brief Приводить 32 байти до нижнього регістру (тільки A-Z).
+         */
+        __attribute__((target("avx2")))
+        inline __m256i Fold32(__m256i v) {
+            __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('A' - 1)),
+                                             _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), v));
+            return _mm256_or_si256(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+        }
+
+        /**
+         * @brief Те саме, що FindFoldedSse2, але для 32 позицій за крок.
+         */
+        __attribute__((target("avx2")))
+        size_t FindFoldedAvx2(const char *text, size_t length, const std::string &needle) {
+            size_t k = needle.size();
+            if (k == 0) return 0;
+            if (length < k) return npos;
+
+            const __m256i first = _mm256_set1_epi8(needle[0]);
+            const __m256i last = _mm256_set1_epi8(needle[k - 1]);
+
+            size_t i = 0;
+            for (; i + k - 1 + 32 <= length; i += 32) {
+                __m256i a = Fold32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + i)));
+                __m256i b = Fold32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + i + k - 1)));
+                unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                        _mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last))));
+                while (mask != 0) {
+                    unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+                    if (MatchAt(text + i + bit, needle)) return i + bit;
+                    mask &= mask - 1;
+                }
+            }
+
+            // Залишок обробляє SSE2-версія
+            size_t rest = FindFoldedSse2(text + i, length - i, needle);
+            return rest == npos ? npos : i + rest;
+        }
+
+        /**
+         * @brief Пошук одного з двох байтів по 32 байти за крок.
+         */
+        __attribute__((target("avx2")))
+        size_t FindEitherAvx2(const char *text, size_t length, char a, char b) {
+            const __m256i va = _mm256_set1_epi8(a);
+            const __m256i vb = _mm256_set1_epi8(b);
+
+            size_t i = 0;
+            for (; i + 32 <= length; i += 32) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + i));
+                unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                        _mm256_or_si256(_mm256_cmpeq_epi8(v, va), _mm256_cmpeq_epi8(v, vb))));
+                if (mask != 0) return i + static_cast<unsigned>(__builtin_ctz(mask));
+            }
+            return i + FindEitherSse2(text + i, length - i, a, b);
+        }
+
+        /**
+         * @brief Те саме, що FindCyrillicUpperSse2, але для 32 позицій за крок.
+         */
+        __attribute__((target("avx2")))
+        size_t FindCyrillicUpperAvx2(const char *text, size_t length) {
+            const __m256i d0 = _mm256_set1_epi8(static_cast<char>(0xD0));
+            const __m256i d2 = _mm256_set1_epi8(static_cast<char>(0xD2));
+            const __m256i b0 = _mm256_set1_epi8(static_cast<char>(0xB0));
+            const __m256i g = _mm256_set1_epi8(static_cast<char>(0x90));
+
+            size_t i = 0;
+            for (; i + 1 + 32 <= length; i += 32) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + i));
+                __m256i n = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + i + 1));
+                __m256i hit = _mm256_or_si256(
+                        _mm256_and_si256(_mm256_cmpeq_epi8(v, d0), _mm256_cmpgt_epi8(b0, n)),
+                        _mm256_and_si256(_mm256_cmpeq_epi8(v, d2), _mm256_cmpeq_epi8(n, g)));
+                unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(hit));
+                if (mask != 0) return i + static_cast<unsigned>(__builtin_ctz(mask));
+            }
+            return i + FindCyrillicUpperSse2(text + i, length - i);
+        }
+
+        // -----------------------------------------------------------
+        //  SSE4.2: апаратна інструкція crc32
+        // -----------------------------------------------------------
+
+        /**
+         * @brief Таблиці зсуву стану CRC на kCrcLane нульових байтів.
+         *
+         * Зсув лінійний, тому задається образами 32 базисних станів і
+         * застосовується, як slicing-by-4: shift[k][b] — образ байта b у
+         * k-й позиції стану.
+         */
+        struct CrcShiftTables {
+            uint32_t shift[4][256];
+        };
+
+        /**
+         * @brief Будує таблиці зсуву (один раз за запуск, скалярною версією).
+         */
+        const CrcShiftTables &ShiftTables() {
+            static const CrcShiftTables tables = [] {
+                static const unsigned char zeros[kCrcLane] = {};
+                uint32_t basis[32];
+                for (int bit = 0; bit < 32; ++bit) basis[bit] = CrcRawScalar(1u << bit, zeros, kCrcLane);
+
+                CrcShiftTables built{};
+                for (int k = 0; k < 4; ++k) {
+                    for (uint32_t b = 0; b < 256; ++b) {
+                        uint32_t image = 0;
+                        for (int bit = 0; bit < 8; ++bit) {
+                            if (b & (1u << bit)) image ^= basis[8 * k + bit];
+                        }
+                        built.shift[k][b] = image;
+                    }
+                }
+                return built;
+            }();
+            return tables;
+        }
+
+        /**
+         * @brief Стан CRC після kCrcLane нульових байтів.
+         */
+        inline uint32_t CrcShiftLane(uint32_t crc) {
+            const auto &s = ShiftTables().shift;
+            return s[0][crc & 0xFF] ^ s[1][(crc >> 8) & 0xFF] ^ s[2][(crc >> 16) & 0xFF] ^ s[3][crc >> 24];
+        }
+
+        /**
+         * @brief Один крок crc32 по 8 байтах (на 32-бітному x86 — двома кроками по 4).
+         */
+        __attribute__((target("sse4.2")))
+        inline uint32_t Crc8Bytes(uint32_t crc, const unsigned char *p) {
+#ifdef __x86_64__
+            uint64_t word;
+            std::memcpy(&word, p, 8);
+            return static_cast<uint32_t>(_mm_crc32_u64(crc, word));
+#else
+            uint32_t low, high;
+            std::memcpy(&low, p, 4);
+            std::memcpy(&high, p + 4, 4);
+            return _mm_crc32_u32(_mm_crc32_u32(crc, low), high);
+#endif
+        }
+
+        /**
+         * @brief CRC32C інструкцією crc32 у три незалежні потоки.
+         *
+         * Одна інструкція має затримку 3 такти, але запускається щотакту,
+         * тому довгий фрагмент ділиться на три смуги по kCrcLane байтів, які
+         * рахуються в одному циклі. Стани смуг потім склеюються: стан першої
+         * зсувається на kCrcLane нулів (CrcShiftLane) і складається з другою,
+         * і так само з третьою.
+         */
+        __attribute__((target("sse4.2")))
+        uint32_t CrcRawSse42(uint32_t crc, const unsigned char *p, size_t length) {
+            for (; length >= 3 * kCrcLane; p += 3 * kCrcLane, length -= 3 * kCrcLane) {
+                uint32_t a = crc, b = 0, c = 0;
+                for (size_t i = 0; i < kCrcLane; i += 8) {
+                    a = Crc8Bytes(a, p + i);
+                    b = Crc8Bytes(b, p + kCrcLane + i);
+                    c = Crc8Bytes(c, p + 2 * kCrcLane + i);
+                }
+                crc = CrcShiftLane(CrcShiftLane(a) ^ b) ^ c;
+            }
+            for (; length >= 8; p += 8, length -= 8) crc = Crc8Bytes(crc, p);
+            for (; length > 0; ++p, --length) crc = _mm_crc32_u8(crc, *p);
+            return crc;
+        }
+
+#endif
+
+#ifdef KURSOVA_CRC_ARM
+
+        // -----------------------------------------------------------
+        //  ARMv8: інструкції crc32c
+        // -----------------------------------------------------------
+
+        /**
+         * @brief CRC32C інструкціями ARMv8 по 8 байтів за крок.
+         */
+        uint32_t CrcRawArm(uint32_t crc, const unsigned char *p, size_t length) {
+            for (; length >= 8; p += 8, length -= 8) {
+                uint64_t word;
+                std::memcpy(&word, p, 8);
+                crc = __crc32cd(crc, word);
+            }
+            for (; length > 0; ++p, --length) crc = __crc32cb(crc, *p);
+            return crc;
+        }
+
+#endif
+
+        // -----------------------------------------------------------
+        //  Вибір реалізації під час виконання
+        // -----------------------------------------------------------
+
+        using FindFn = size_t (*)(const char *, size_t, const std::string &);
+        using EitherFn = size_t (*)(const char *, size_t, char, char);
+        using UpperFn = size_t (*)(const char *, size_t);
+        using CrcFn = uint32_t (*)(uint32_t, const unsigned char *, size_t);
+
+        /**
+         * @brief Набір реалізацій, обраний для поточного процесора.
+         */
+        struct Dispatch {
+            FindFn find;
+            EitherFn either;
+            UpperFn upper;
+            const char *isa;
+            CrcFn crc;
+            const char *crcIsa;
+        };
+
+        /**
+         * @brief Визначає можливості процесора (один раз за запуск).
+         */
+        const Dispatch &Select() {
+            static const Dispatch dispatch = [] {
+                Dispatch selected{FindFoldedScalar, FindEitherScalar, FindCyrillicUpperScalar, "scalar",
+                                  CrcRawScalar, "scalar"};
+#ifdef KURSOVA_SIMD_X86
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx2")) {
+                    selected.find = FindFoldedAvx2;
+                    selected.either = FindEitherAvx2;
+                    selected.upper = FindCyrillicUpperAvx2;
+                    selected.isa = "avx2";
+                } else if (__builtin_cpu_supports("sse2")) {
+                    selected.find = FindFoldedSse2;
+                    selected.either = FindEitherSse2;
+                    selected.upper = FindCyrillicUpperSse2;
+                    selected.isa = "sse2";
+                }
+                // SSE4.2 не випливає з SSE2, тож перевіряється окремо
+                if (__builtin_cpu_supports("sse4.2")) {
+                    selected.crc = CrcRawSse42;
+                    selected.crcIsa = "sse4.2";
+                }
+#endif
+#ifdef KURSOVA_CRC_ARM
+                selected.crc = CrcRawArm;
+                selected.crcIsa = "armv8";
+#endif
+                return selected;
+            }();
+            return dispatch;
+        }
+
+    }
+
+    // -----------------------------------------------------------
+    //  Публічний інтерфейс
+    // -----------------------------------------------------------
+
+    /**
+     * @brief Назва обраного набору інструкцій.
+     */
+    const char *ActiveIsa() {
+        return Select().isa;
+    }
+
+    /**
+     * @brief Регістронезалежний пошук підрядка (див. Simd.h).
+     */
+    size_t FindFolded(const char *text, size_t length, const std::string &foldedNeedle) {
+        return Select().find(text, length, foldedNeedle);
+    }
+
+    /**
+     * @brief Пошук першого з двох байтів (див. Simd.h).
+     */
+    size_t FindEither(const char *text, size_t length, char a, char b) {
+        return Select().either(text, length, a, b);
+    }
+
+    /**
+     * @brief Пошук великої кириличної літери (див. Simd.h).
+     */
+    size_t FindCyrillicUpper(const char *text, size_t length) {
+        return Select().upper(text, length);
+    }
+
+    /**
+     * @brief Назва реалізації CRC32C.
+     */
+    const char *ActiveCrcIsa() {
+        return Select().crcIsa;
+    }
+
+    /**
+     * @brief CRC32C з продовженням (див. Simd.h): інверсії знімаються і ставляться тут.
+     */
+    uint32_t Crc32c(uint32_t crc, const char *data, size_t length) {
+        return ~Select().crc(~crc, reinterpret_cast<const unsigned char *>(data), length);
+    }
+
+}
@@ -0,0 +1,98 @@
+/**
+ * @file Simd.h
+ * @brief Оголошення векторизованих (SIMD) ядер для обробки тексту.
+ */
+
+#ifndef KURSOVA_SIMD_H
+#define KURSOVA_SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @namespace Simd
+ * @brief Простір імен для низькорівневих векторних функцій.
+ *
+ * Функції пошуку мають три реалізації: AVX2 (32 байти за крок), SSE2
+ * (16 байтів) та скалярну; CRC32C — апаратну (SSE4.2 або ARMv8) і
+ * табличну. Потрібна версія вибирається один раз під час виконання
+ * залежно від можливостей процесора, тому програма працює і на машинах
+ * без AVX2, і на інших архітектурах (наприклад, ARM).
+ */
+namespace Simd {
+
+    /**
+     * @brief Значення "не знайдено" (аналог std::string::npos).
+     */
+    constexpr size_t npos = static_cast<size_t>(-1);
+
+    /**
+     * @brief Назва набору інструкцій, що використовується ("avx2", "sse2" або "scalar").
+     */
+    const char *ActiveIsa();
+
+    /**
+     * @brief Шукає підрядок без урахування регістру латинських літер.
+     *
+     * Байти тексту приводяться до нижнього регістру "на льоту" (тільки A-Z),
+     * без створення копії. Байти UTF-8 (>= 0x80) порівнюються точно, тому для
+     * кирилиці текст має бути заздалегідь приведений до нижнього регістру
+     * (див. Utils::FoldShadow).
+     *
+     * @param text Текст, у якому шукаємо.
+     * @param length Довжина тексту в байтах.
+     * @param foldedNeedle Шуканий рядок у нижньому регістрі.
+     * @return Позиція першого входження або Simd::npos.
+     */
+    size_t FindFolded(const char *text, size_t length, const std::string &foldedNeedle);
+
+    /**
+     * @brief Шукає перший байт, що дорівнює a або b.
+     *
+     * Використовується для розбору CSV: між знайденими роздільниками
+     * та символами екранування текст копіюється цілими фрагментами.
+     *
+     * @param text Початок тексту.
+     * @param length Довжина тексту в байтах.
+     * @param a Перший шуканий байт.
+     * @param b Другий шуканий байт.
+     * @return Позиція першого збігу або length, якщо збігів немає.
+     */
+    size_t FindEither(const char *text, size_t length, char a, char b);
+
+    /**
+     * @brief Шукає першу велику кириличну літеру (U+0400–U+042F або "Ґ").
+     *
+     * У UTF-8 це пари 0xD0 0x80–0xAF і 0xD2 0x90. Вектор перевіряє пару в
+     * кожній позиції одразу, тож текст без великих літер проглядається
+     * цілими блоками (див. Utils::FoldCyrillicInPlace).
+     *
+     * @param text Початок тексту (UTF-8).
+     * @param length Довжина тексту в байтах.
+     * @return Позиція першого байта літери або length, якщо таких немає.
+     */
+    size_t FindCyrillicUpper(const char *text, size_t length);
+
+    /**
+     * @brief Назва реалізації CRC32C ("sse4.2", "armv8" або "scalar").
+     */
+    const char *ActiveCrcIsa();
+
+    /**
+     * @brief Обчислює CRC32C (поліном Кастаньолі, як в iSCSI та ext4).
+     *
+     * Дані можна подавати частинами: Crc32c(Crc32c(0, a), b) дорівнює
+     * CRC32C від a і b разом. Апаратна версія рахує довгі фрагменти у
+     * три потоки і наближається до пропускної здатності пам'яті.
+     *
+     * @param crc CRC попередніх даних (0 для початку).
+     * @param data Початок даних.
+     * @param length Довжина в байтах.
+     * @return CRC32C усіх даних.
+     */
+    uint32_t Crc32c(uint32_t crc, const char *data, size_t length);
+
+}
+
+#endif //KURSOVA_SIMD_H
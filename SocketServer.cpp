@@ -0,0 +1,273 @@
+/**
+ * @file SocketServer.cpp
+ * @brief Реалізація базового однопотокового сервера на epoll.
+ */
+
+#include "SocketServer.h"
+
+#include <iostream>
+#include <vector>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+
+/**
+ * @brief Конструктор.
+ */
+SocketServer::SocketServer() : stopFd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {}
+
+#else
+
+/**
+ * @brief Конструктор.
+ */
+SocketServer::SocketServer() = default;
+
+#endif
+
+/**
+ * @brief За замовчуванням додаткових налаштувань немає.
+ */
+void SocketServer::ConfigureConnection(int) {}
+
+#ifdef __linux__
+
+// -------------------------------------------------------------
+//                     DESTRUCTOR
+// -------------------------------------------------------------
+
+/**
+ * @brief Закриває всі дескриптори.
+ */
+SocketServer::~SocketServer() {
+    for (auto &entry : connections) ::close(entry.first);
+    if (listenFd >= 0) ::close(listenFd);
+    if (epollFd >= 0) ::close(epollFd);
+    if (stopFd >= 0) ::close(stopFd);
+}
+
+// -------------------------------------------------------------
+//                     EVENT LOOP
+// -------------------------------------------------------------
+
+/**
+ * @brief Цикл epoll: приймання з'єднань, читання запитів, відправлення відповідей.
+ * @return false, якщо сервер не вдалося запустити.
+ */
+bool SocketServer::Run() {
+    epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0 || stopFd < 0) {
+        std::cerr << "[ERROR] epoll/eventfd: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    listenFd = OpenListener();
+    if (listenFd < 0) return false;
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = listenFd;
+    ::epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &ev);
+    ev.data.fd = stopFd;
+    ::epoll_ctl(epollFd, EPOLL_CTL_ADD, stopFd, &ev);
+
+    std::vector<epoll_event> events(256);
+    bool running = true;
+    while (running) {
+        int count = ::epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "[ERROR] epoll_wait: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+            uint32_t flags = events[i].events;
+
+            if (fd == stopFd) {
+                running = false;
+                continue;
+            }
+            if (fd == listenFd) {
+                Accept();
+                continue;
+            }
+
+            auto it = connections.find(fd);
+            if (it == connections.end()) continue;
+            Connection &conn = it->second;
+
+            bool keep = !(flags & EPOLLERR);
+            if (keep && (flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP))) keep = OnReadable(fd, conn);
+            if (keep && (flags & EPOLLOUT)) keep = Pump(fd, conn);
+            if (!keep) Close(fd);
+        }
+    }
+
+    std::cout << "[INFO] Сервер зупинено." << std::endl;
+    return true;
+}
+
+/**
+ * @brief Будить цикл через eventfd (write — async-signal-safe).
+ */
+void SocketServer::Stop() {
+    if (stopFd < 0) return;
+    uint64_t one = 1;
+    ssize_t ignored = ::write(stopFd, &one, sizeof(one));
+    (void) ignored;
+}
+
+// -------------------------------------------------------------
+//                     CONNECTIONS
+// -------------------------------------------------------------
+
+/**
+ * @brief Приймає всі з'єднання з черги.
+ */
+void SocketServer::Accept() {
+    while (true) {
+        int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;  // EAGAIN або тимчасова помилка — чекаємо наступної події
+        }
+        ConfigureConnection(fd);
+
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.fd = fd;
+        if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            ::close(fd);
+            continue;
+        }
+        connections[fd].events = ev.events;
+    }
+}
+
+/**
+ * @brief Читає все доступне і обробляє запити.
+ * @return false, якщо з'єднання треба закрити.
+ */
+bool SocketServer::OnReadable(int fd, Connection &conn) {
+    // При зворотному тиску не читаємо: запити залишаються в буфері ядра
+    if (!CanAcceptMore(conn)) return true;
+
+    char chunk[64 * 1024];
+    while (!conn.closing) {
+        ssize_t n = ::read(fd, chunk, sizeof(chunk));
+        if (n > 0) {
+            conn.in.append(chunk, static_cast<size_t>(n));
+            // Решта чекає в ядрі, доки повні запити не буде оброблено
+            if (conn.in.size() > MaxRequestBytes()) break;
+            continue;
+        }
+        if (n == 0) {
+            conn.closing = true;
+            break;
+        }
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+        return false;
+    }
+    return Pump(fd, conn);
+}
+
+/**
+ * @brief Обробляє запити і відправляє відповіді, доки є що робити.
+ * @return false, якщо з'єднання треба закрити.
+ */
+bool SocketServer::Pump(int fd, Connection &conn) {
+    while (true) {
+        size_t before = conn.in.size();
+        if (!ProcessRequests(conn)) return false;
+        if (!Flush(fd, conn)) return false;
+
+        // Продовжуємо, лише якщо все відправлено, а обробка ще просувається
+        if (!conn.out.empty() || conn.in.empty() || conn.in.size() == before) break;
+    }
+
+    if (conn.closing && conn.out.empty()) return false;
+    UpdateInterest(fd, conn);
+    return true;
+}
+
+/**
+ * @brief Відправляє відповіді, доки сокет приймає дані.
+ * @return false при помилці запису.
+ */
+bool SocketServer::Flush(int fd, Connection &conn) {
+    while (conn.sent < conn.out.size()) {
+        ssize_t n = ::send(fd, conn.out.data() + conn.sent, conn.out.size() - conn.sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            conn.sent += static_cast<size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+        return false;
+    }
+    // Усе відправлено: буфер очищується, але його ємність лишається для наступних відповідей
+    conn.out.clear();
+    conn.sent = 0;
+    return true;
+}
+
+/**
+ * @brief Підписує з'єднання на потрібні події.
+ *
+ * EPOLLOUT — лише коли є невідправлені дані; EPOLLIN вимикається
+ * при зворотному тиску і після закриття читання.
+ */
+void SocketServer::UpdateInterest(int fd, Connection &conn) {
+    uint32_t wanted = conn.closing ? 0u : static_cast<uint32_t>(EPOLLRDHUP);
+    if (!conn.closing && CanAcceptMore(conn)) wanted |= EPOLLIN;
+    if (!conn.out.empty()) wanted |= EPOLLOUT;
+    if (wanted == conn.events) return;
+
+    epoll_event ev{};
+    ev.events = wanted;
+    ev.data.fd = fd;
+    ::epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev);
+    conn.events = wanted;
+}
+
+/**
+ * @brief Закриває з'єднання і забуває його стан.
+ */
+void SocketServer::Close(int fd) {
+    ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    connections.erase(fd);
+}
+
+#else
+
+/**
+ * @brief На платформах без epoll нічого закривати.
+ */
+SocketServer::~SocketServer() = default;
+
+/**
+ * @brief Сервер потребує Linux (epoll).
+ */
+bool SocketServer::Run() {
+    std::cerr << "[ERROR] Режим сервера доступний лише в Linux." << std::endl;
+    return false;
+}
+
+/**
+ * @brief Нічого не робить без epoll.
+ */
+void SocketServer::Stop() {}
+
+#endif
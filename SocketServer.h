@@ -0,0 +1,149 @@
+/**
+ * @file SocketServer.h
+ * @brief Оголошення базового однопотокового сервера на epoll.
+ */
+
+#ifndef KURSOVA_SOCKETSERVER_H
+#define KURSOVA_SOCKETSERVER_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @class SocketServer
+ * @brief Спільний цикл подій для серверів запитів (Unix-сокет, HTTP).
+ *
+ * Один потік обслуговує всі з'єднання через epoll (неблокувальні сокети).
+ * Кожне з'єднання має власні вхідний і вихідний буфери, які
+ * перевикористовуються між запитами. Похідний клас відкриває слухаючий
+ * сокет і розбирає запити свого протоколу, дописуючи відповіді в out.
+ *
+ * Якщо клієнт не встигає читати відповіді, сервер припиняє читати та
+ * обробляти його запити, доки невідправлених даних не стане менше
+ * kMaxPendingBytes (зворотний тиск).
+ */
+class SocketServer {
+public:
+    /**
+     * @brief Конструктор. Створює eventfd, щоб Stop працював ще до Run.
+     */
+    SocketServer();
+
+    /**
+     * @brief Закриває всі дескриптори.
+     */
+    virtual ~SocketServer();
+
+    SocketServer(const SocketServer &) = delete;
+    SocketServer &operator=(const SocketServer &) = delete;
+
+    /**
+     * @brief Запускає цикл обробки подій (блокує до виклику Stop).
+     * @return false, якщо сервер не вдалося запустити.
+     */
+    bool Run();
+
+    /**
+     * @brief Просить цикл завершитись. Безпечно викликати з обробника сигналу.
+     */
+    void Stop();
+
+protected:
+    /** @brief Обсяг невідправлених відповідей, після якого читання призупиняється. */
+    static constexpr size_t kMaxPendingBytes = 4 * 1024 * 1024;
+
+    /**
+     * @brief Стан одного з'єднання.
+     */
+    struct Connection {
+        /** @brief Прочитані, але ще не оброблені байти. */
+        std::string in;
+        /** @brief Відповіді, що чекають відправлення (буфер перевикористовується). */
+        std::string out;
+        /** @brief Скільки байтів з out уже відправлено. */
+        size_t sent = 0;
+        /** @brief Номер наступного запиту. */
+        uint64_t nextId = 1;
+        /** @brief Події epoll, на які зараз підписано з'єднання. */
+        uint32_t events = 0;
+        /** @brief Більше не читати; закрити після відправлення відповідей. */
+        bool closing = false;
+    };
+
+    /**
+     * @brief Чи можна обробляти ще запити з'єднання (зворотний тиск).
+     */
+    static bool CanAcceptMore(const Connection &conn) {
+        return conn.out.size() - conn.sent < kMaxPendingBytes;
+    }
+
+    /**
+     * @brief Створює неблокувальний слухаючий сокет.
+     * @return Дескриптор або -1 (помилку вже виведено).
+     */
+    virtual int OpenListener() = 0;
+
+    /**
+     * @brief Налаштовує щойно прийняте з'єднання (наприклад, TCP_NODELAY).
+     */
+    virtual void ConfigureConnection(int fd);
+
+    /**
+     * @brief Обробляє повні запити з conn.in, поки CanAcceptMore(conn).
+     *
+     * Оброблені байти видаляються з conn.in, відповіді дописуються в conn.out.
+     * @return false, якщо з'єднання треба негайно закрити.
+     */
+    virtual bool ProcessRequests(Connection &conn) = 0;
+
+    /**
+     * @brief Найбільша довжина одного запиту в байтах.
+     *
+     * Читання зупиняється, щойно вхідний буфер її перевищить; якщо після
+     * обробки в буфері лишається довший незавершений запит,
+     * ProcessRequests закриває з'єднання.
+     */
+    virtual size_t MaxRequestBytes() const = 0;
+
+private:
+    /**
+     * @brief Приймає всі очікувані з'єднання.
+     */
+    void Accept();
+
+    /**
+     * @brief Читає дані з'єднання і обробляє повні запити.
+     * @return false, якщо з'єднання треба закрити.
+     */
+    bool OnReadable(int fd, Connection &conn);
+
+    /**
+     * @brief Чергує обробку запитів і відправлення, доки є прогрес.
+     * @return false, якщо з'єднання треба закрити.
+     */
+    bool Pump(int fd, Connection &conn);
+
+    /**
+     * @brief Відправляє накопичені відповіді.
+     * @return false, якщо з'єднання треба закрити.
+     */
+    bool Flush(int fd, Connection &conn);
+
+    /**
+     * @brief Оновлює підписку на події (EPOLLIN/EPOLLOUT) за станом буферів.
+     */
+    void UpdateInterest(int fd, Connection &conn);
+
+    /**
+     * @brief Закриває з'єднання.
+     */
+    void Close(int fd);
+
+    int listenFd = -1;
+    int epollFd = -1;
+    int stopFd = -1;
+    std::unordered_map<int, Connection> connections;
+};
+
+#endif //KURSOVA_SOCKETSERVER_H
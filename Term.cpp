@@ -105,26 +105,31 @@ bool Term::IsPrimitive() const {
 }
 
 /**
- * @brief Серіалізує об'єкт у рядок формату CSV.
+ * @brief Створює копію терміна через конструктор копіювання.
+ * @return Вказівник на новий об'єкт Term.
+ */
+std::shared_ptr<TermBase> Term::Clone() const {
+    return std::make_shared<Term>(*this);
+}
+
+/**
+ * @brief Дописує об'єкт у буфер у форматі CSV.
  *
  * Формує рядок вигляду: TERM;Назва;Визначення;Посил1,Посил2,Посил3
- * Використовує екранування для полів та об'єднання списку посилань через кому.
+ * Поля і посилання екрануються прямо в буфері, посилання розділяються комою.
  *
- * @return std::string Серіалізовані дані.
+ * @param out Буфер викликача.
  */
-std::string Term::Serialize() const {
+void Term::SerializeTo(std::string &out) const {
     // Формат: TYPE;name;definition;ref1,ref2,...
-    std::string escapedName = Utils::Escape(name);
-    std::string escapedDef = Utils::Escape(definition);
-    
-    std::vector<std::string> escapedRefs;
-    escapedRefs.reserve(references.size());
-    for (const auto &r : references) {
-        escapedRefs.push_back(Utils::Escape(r));
+    out.append("TERM;");
+    Utils::EscapeTo(out, name);
+    out.push_back(';');
+    EscapeDefinitionTo(out);
+    out.push_back(';');
+
+    for (size_t i = 0; i < references.size(); ++i) {
+        if (i) out.push_back(',');
+        Utils::EscapeTo(out, references[i]);
     }
-    
-    // Об'єднуємо посилання через кому (вже екрановані)
-    std::string refsJoined = Utils::Join(escapedRefs, ',');
-    
-    return GetType() + ";" + escapedName + ";" + escapedDef + ";" + refsJoined;
 }
\ No newline at end of file
@@ -98,10 +98,16 @@ public:
     bool IsPrimitive() const override;
 
     /**
-     * @brief Серіалізує об'єкт у рядок.
-     * @return Рядок формату: TERM;Назва;Визначення;Посил1,Посил2...
+     * @brief Створює копію терміна.
+     * @return Новий об'єкт Term.
      */
-    std::string Serialize() const override;
+    std::shared_ptr<TermBase> Clone() const override;
+
+    /**
+     * @brief Дописує об'єкт у форматі CSV.
+     * @param out Буфер; дописується рядок формату TERM;Назва;Визначення;Посил1,Посил2...
+     */
+    void SerializeTo(std::string &out) const override;
 };
 
 #endif //KURSOVA_TERM_H
\ No newline at end of file
@@ -7,8 +7,39 @@
  */
 
 #include "TermBase.h"
+#include "Simd.h"
+#include "Utils.h"
 #include <iostream>
 
+namespace {
+    /**
+     * @brief Шукає фрагмент у щойно прочитаному визначенні.
+     *
+     * Копія в нижньому регістрі будується в буфері потоку і лише тоді, коли
+     * в тексті є великі кириличні літери (латиницю зводить FindFolded).
+     */
+    bool ContainsFolded(const char *text, size_t size, const std::string &foldedNeedle) {
+        if (!Utils::HasCyrillicUpper(text, size)) {
+            return Simd::FindFolded(text, size, foldedNeedle) != Simd::npos;
+        }
+        thread_local std::string folded;
+        folded.clear();
+        Utils::FoldTo(folded, text, size);
+        return Simd::FindFolded(folded.data(), folded.size(), foldedNeedle) != Simd::npos;
+    }
+}
+
+/**
+ * @brief Блокування відкладеного визначення терміна.
+ *
+ * М'ютекс на кожен термін коштував би більше за саме визначення, тому
+ * терміни ділять невеликий набір м'ютексів за адресою.
+ */
+std::mutex &TermBase::DefinitionLock(const TermBase *term) {
+    static std::mutex locks[64];
+    return locks[(reinterpret_cast<uintptr_t>(term) >> 6) % 64];
+}
+
 /**
  * @brief Конструктор за замовчуванням.
  */
@@ -20,21 +51,35 @@ TermBase::TermBase() = default;
  * @param definition Текстове визначення терміна.
  */
 TermBase::TermBase(const std::string &name, const std::string &definition)
-        : name(name), definition(definition) {}
+        : name(name), definition(definition), foldedDefinition(Utils::FoldShadow(definition)) {}
 
 /**
  * @brief Конструктор копіювання.
+ *
+ * Копія завжди тримає визначення в пам'яті: її створюють для редагування.
  * @param other Об'єкт, з якого копіюються дані.
  */
 TermBase::TermBase(const TermBase &other)
-        : name(other.name), definition(other.definition) {}
+        : name(other.name) {
+    AssignDefinition(other);
+}
 
 /**
  * @brief Конструктор переміщення.
+ *
+ * Відкладене визначення переноситься як посилання на файл; прочитана
+ * копія лишається в other (її може облікувати кеш).
  * @param other Об'єкт, дані якого переміщуються (r-value).
  */
 TermBase::TermBase(TermBase &&other) noexcept
-        : name(std::move(other.name)), definition(std::move(other.definition)) {}
+        : name(std::move(other.name)),
+          definition(std::move(other.definition)),
+          foldedDefinition(std::move(other.foldedDefinition)),
+          definitionSource(other.definitionSource),
+          definitionOffset(other.definitionOffset),
+          definitionLength(other.definitionLength),
+          definitionCodec(other.definitionCodec),
+          definitionCache(other.definitionCache) {}
 
 /**
  * @brief Віртуальний деструктор.
@@ -45,6 +90,7 @@ TermBase::TermBase(TermBase &&other) noexcept
  */
 TermBase::~TermBase() {
     std::cout << "[DEBUG] Знищення терміна: " << name << std::endl;
+    ReleaseCached();
 }
 
 /**
@@ -55,7 +101,8 @@ TermBase::~TermBase() {
 TermBase &TermBase::operator=(const TermBase &other) {
     if (this != &other) {
         name = other.name;
-        definition = other.definition;
+        ReleaseCached();
+        AssignDefinition(other);
     }
     return *this;
 }
@@ -68,7 +115,14 @@ TermBase &TermBase::operator=(const TermBase &other) {
 TermBase &TermBase::operator=(TermBase &&other) noexcept {
     if (this != &other) {
         name = std::move(other.name);
+        ReleaseCached();
         definition = std::move(other.definition);
+        foldedDefinition = std::move(other.foldedDefinition);
+        definitionSource = other.definitionSource;
+        definitionOffset = other.definitionOffset;
+        definitionLength = other.definitionLength;
+        definitionCodec = other.definitionCodec;
+        definitionCache = other.definitionCache;
     }
     return *this;
 }
@@ -91,10 +145,45 @@ void TermBase::SetName(const std::string &value) {
 
 /**
  * @brief Отримує визначення терміна.
+ *
+ * Відкладене чи стиснене визначення береться з кешу або читається з
+ * файлу (розкодовується) і позначається як видане назовні
+ * (див. CachedDefinition::exposed).
  * @return Константне посилання на рядок з визначенням.
  */
 const std::string &TermBase::GetDefinition() const {
-    return definition;
+    if (!IsDeferred()) return definition;
+
+    std::lock_guard<std::mutex> lock(DefinitionLock(this));
+    const CachedDefinition *loaded = AcquireLocked();
+    // Посилання йде назовні: після витіснення рядок має дочекатися читачів
+    loaded->exposed = true;
+    return loaded->text;
+}
+
+/**
+ * @brief Викликає reader з визначенням з кешу або з буфера потоку.
+ *
+ * Визначення, якого немає в кеші, розекрановується чи розкодовується без
+ * блокування: файл і закодовані байти після публікації терміна не змінюються.
+ * @param reader Функція викликача.
+ */
+void TermBase::ReadDefinition(const std::function<void(const std::string &)> &reader) const {
+    if (!IsDeferred()) {
+        reader(definition);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(DefinitionLock(this));
+        if (const CachedDefinition *loaded = cached.load(std::memory_order_relaxed)) {
+            reader(loaded->text);
+            return;
+        }
+    }
+    thread_local std::string text;
+    text.clear();
+    DecodeDefinitionTo(text);
+    reader(text);
 }
 
 /**
@@ -102,5 +191,214 @@ const std::string &TermBase::GetDefinition() const {
  * @param value Новий текст визначення.
  */
 void TermBase::SetDefinition(const std::string &value) {
+    ReleaseCached();
+    definitionSource.reset();
+    definitionCodec.reset();
+    definitionCache = nullptr;
     definition = value;
+    foldedDefinition = Utils::FoldShadow(value);
+}
+
+/**
+ * @brief Запам'ятовує, де у файлі лежить визначення; сам текст не читається.
+ * @param source Відображений файл.
+ * @param offset Зміщення поля визначення.
+ * @param length Довжина поля визначення.
+ * @param cache Кеш для обліку прочитаного визначення.
+ */
+void TermBase::SetLazyDefinition(std::shared_ptr<const MappedFile> source, size_t offset, size_t length,
+                                 DefinitionCache *cache) {
+    ReleaseCached();
+    definition.clear();
+    foldedDefinition.clear();
+    definitionSource = std::move(source);
+    definitionOffset = offset;
+    definitionLength = length;
+    definitionCodec.reset();
+    definitionCache = cache;
+}
+
+/**
+ * @brief Кодує поточне визначення і замінює ним текст у пам'яті.
+ *
+ * Закодовані байти копіюються в рядок точного розміру, щоб не лишати
+ * запасу ємності від тексту, який вони замінюють.
+ * @param codec Кодек бази.
+ * @param cache Кеш для обліку розкодованої копії.
+ * @return Розміри визначення до і після стиснення.
+ */
+std::pair<size_t, size_t> TermBase::CompressDefinition(std::shared_ptr<const DefinitionCodec> codec,
+                                                       DefinitionCache *cache) {
+    thread_local std::string text;
+    thread_local std::string encoded;
+    text.clear();
+    if (IsDeferred()) DecodeDefinitionTo(text);
+    else text.append(definition);
+    encoded.clear();
+    codec->Encode(text.data(), text.size(), encoded);
+
+    ReleaseCached();
+    definition = std::string(encoded);
+    std::string().swap(foldedDefinition);
+    definitionSource.reset();
+    definitionOffset = 0;
+    definitionLength = 0;
+    definitionCodec = std::move(codec);
+    definitionCache = cache;
+    return {text.size(), definition.size()};
+}
+
+/**
+ * @brief Визначення у файлі або стиснене.
+ */
+bool TermBase::IsDeferred() const {
+    return definitionSource || definitionCodec;
+}
+
+/**
+ * @brief Розекрановує визначення з файлу або розкодовує стиснене.
+ * @param out Буфер викликача.
+ */
+void TermBase::DecodeDefinitionTo(std::string &out) const {
+    if (definitionCodec) {
+        definitionCodec->Decode(definition.data(), definition.size(), out);
+    } else {
+        Utils::UnescapeTo(out, definitionSource->Data() + definitionOffset, definitionLength);
+    }
+}
+
+/**
+ * @brief Повертає прочитане визначення; відсутнє читається з файлу.
+ *
+ * Біт звернення пишеться лише тоді, коли він скинутий, щоб паралельні
+ * перегляди бази не змагалися за рядок кешу процесора. Admit не витісняє
+ * терміни, чий м'ютекс зайнятий, тож щойно прочитане визначення доживе
+ * до кінця звернення.
+ */
+const CachedDefinition *TermBase::AcquireLocked() const {
+    const CachedDefinition *loaded = cached.load(std::memory_order_relaxed);
+    if (loaded) {
+        if (!recentlyUsed.load(std::memory_order_relaxed)) recentlyUsed.store(true, std::memory_order_relaxed);
+        if (definitionCache) definitionCache->CountHit();
+        return loaded;
+    }
+
+    auto fresh = std::make_unique<CachedDefinition>();
+    DecodeDefinitionTo(fresh->text);
+    fresh->folded = Utils::FoldShadow(fresh->text);
+    loaded = fresh.release();
+    recentlyUsed.store(true, std::memory_order_relaxed);
+    cached.store(loaded, std::memory_order_relaxed);
+    if (definitionCache) definitionCache->Admit(this);
+    return loaded;
+}
+
+/**
+ * @brief Виходить з обліку кешу і звільняє прочитане визначення.
+ */
+void TermBase::ReleaseCached() {
+    if (definitionCache) definitionCache->Forget(this);
+    delete cached.exchange(nullptr);
+}
+
+/**
+ * @brief Копіює визначення (відкладене читається) у власні поля.
+ * @param other Термін-джерело.
+ */
+void TermBase::AssignDefinition(const TermBase &other) {
+    definitionSource.reset();
+    definitionCodec.reset();
+    definitionCache = nullptr;
+    if (other.IsDeferred()) {
+        std::lock_guard<std::mutex> lock(DefinitionLock(&other));
+        const CachedDefinition *loaded = other.AcquireLocked();
+        definition = loaded->text;
+        foldedDefinition = loaded->folded;
+    } else {
+        definition = other.definition;
+        foldedDefinition = other.foldedDefinition;
+    }
+}
+
+/**
+ * @brief Екранує визначення в буфер; непрочитане береться з файлу без кешування.
+ *
+ * Стиснене визначення розкодовується в буфер потоку і екранується.
+ *
+ * Поле у файлі вже екрановане, і якщо в ньому немає '\' та ',', воно
+ * дописується як є. Інакше воно розекрановується в локальний буфер
+ * потоку і екранується заново — результат той самий, що й для
+ * прочитаного визначення.
+ * @param out Буфер викликача.
+ */
+void TermBase::EscapeDefinitionTo(std::string &out) const {
+    if (!IsDeferred()) {
+        Utils::EscapeTo(out, definition);
+        return;
+    }
+    thread_local std::string scratch;
+    if (definitionCodec) {
+        scratch.clear();
+        definitionCodec->Decode(definition.data(), definition.size(), scratch);
+        Utils::EscapeTo(out, scratch);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(DefinitionLock(this));
+    if (const CachedDefinition *loaded = cached.load(std::memory_order_relaxed)) {
+        Utils::EscapeTo(out, loaded->text);
+        return;
+    }
+
+    const char *raw = definitionSource->Data() + definitionOffset;
+    if (Simd::FindEither(raw, definitionLength, '\\', ',') == definitionLength) {
+        out.append(raw, definitionLength);
+        return;
+    }
+    scratch.clear();
+    Utils::UnescapeTo(scratch, raw, definitionLength);
+    Utils::EscapeTo(out, scratch);
+}
+
+/**
+ * @brief Регістронезалежний пошук фрагмента у визначенні.
+ *
+ * Не створює тимчасових рядків: латиниця приводиться до нижнього регістру
+ * всередині SIMD-ядра, а кирилиця береться з тіньової копії. Стиснене
+ * визначення і визначення, ще не прочитане з файлу, розкодовуються в
+ * буфери потоку, які переходять від терміна до терміна, і в кеш
+ * визначень не потрапляють, тож перегляд бази не виділяє пам'ять і не
+ * витісняє визначення, що читаються зараз.
+ * @param foldedNeedle Фрагмент у нижньому регістрі.
+ * @return true, якщо фрагмент знайдено.
+ */
+bool TermBase::DefinitionContains(const std::string &foldedNeedle) const {
+    if (definitionCodec) {
+        // Буфер лише росте: розкодування не заповнює його нулями щоразу
+        thread_local std::string text;
+        const size_t need = definition.size() * DefinitionCodec::kMaxSymbolLength;
+        if (text.size() < need) text.resize(need);
+        size_t length = definitionCodec->DecodeTo(definition.data(), definition.size(), &text[0]);
+        Utils::FoldCyrillicInPlace(&text[0], length);
+        return Simd::FindFolded(text.data(), length, foldedNeedle) != Simd::npos;
+    }
+    if (definitionSource) {
+        // Під блокуванням кеш не витіснить визначення, і кладовище не потрібне
+        std::lock_guard<std::mutex> lock(DefinitionLock(this));
+        if (const CachedDefinition *loaded = cached.load(std::memory_order_relaxed)) {
+            const std::string &text = loaded->folded.empty() ? loaded->text : loaded->folded;
+            return Simd::FindFolded(text.data(), text.size(), foldedNeedle) != Simd::npos;
+        }
+        // Непрочитане визначення не додається в кеш: перегляд бази не витісняє робочий набір
+        const char *raw = definitionSource->Data() + definitionOffset;
+        if (Simd::FindEither(raw, definitionLength, '\\', '\\') == definitionLength) {
+            return ContainsFolded(raw, definitionLength, foldedNeedle);
+        }
+        thread_local std::string text;
+        text.clear();
+        Utils::UnescapeTo(text, raw, definitionLength);
+        Utils::FoldCyrillicInPlace(&text[0], text.size());
+        return Simd::FindFolded(text.data(), text.size(), foldedNeedle) != Simd::npos;
+    }
+    const std::string &text = foldedDefinition.empty() ? definition : foldedDefinition;
+    return Simd::FindFolded(text.data(), text.size(), foldedNeedle) != Simd::npos;
 }
\ No newline at end of file
@@ -7,7 +7,15 @@
 #define KURSOVA_TERMBASE_H
 
 #include <string>
+#include <memory>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <utility>
 #include "ITermSerializable.h"
+#include "MappedFile.h"
+#include "DefinitionCache.h"
+#include "DefinitionCodec.h"
 
 /**
  * @class TermBase
@@ -31,10 +39,101 @@ protected:
 
     /**
      * @brief Текстове визначення терміна.
-     * Доступна для класів-спадкоємців (protected).
+     *
+     * Порожнє для відкладеного; для стисненого (definitionCodec) тут лежать
+     * закодовані байти.
      */
     std::string definition;
 
+    /**
+     * @brief Тіньова копія визначення у нижньому регістрі (для пошуку).
+     * Порожня, якщо у визначенні немає великих кириличних літер.
+     */
+    std::string foldedDefinition;
+
+    /**
+     * @brief Файл, у якому лежить відкладене визначення (nullptr — визначення в полі definition).
+     */
+    std::shared_ptr<const MappedFile> definitionSource;
+
+    /** @brief Зміщення екранованого визначення у definitionSource. */
+    size_t definitionOffset = 0;
+
+    /** @brief Довжина екранованого визначення у definitionSource. */
+    size_t definitionLength = 0;
+
+    /**
+     * @brief Кодек стисненого визначення (nullptr — визначення не стиснене).
+     */
+    std::shared_ptr<const DefinitionCodec> definitionCodec;
+
+    /**
+     * @brief Дописує екрановане визначення в буфер (для SerializeTo нащадків).
+     *
+     * Відкладене чи стиснене визначення, якого немає в пам'яті, береться
+     * прямо з файлу (або розкодовується в буфер потоку) і не кешується:
+     * збереження не повинне підтягувати в пам'ять усі визначення.
+     * @param out Буфер викликача.
+     */
+    void EscapeDefinitionTo(std::string &out) const;
+
+private:
+    friend class DefinitionCache;
+
+    /**
+     * @brief Кеш, що обліковує прочитане відкладене визначення (може бути nullptr).
+     */
+    DefinitionCache *definitionCache = nullptr;
+
+    /**
+     * @brief Чи зберігається визначення поза полем definition (у файлі або стиснене).
+     */
+    bool IsDeferred() const;
+
+    /**
+     * @brief Дописує текст визначення, що зберігається поза пам'яттю (розекранований або розкодований).
+     */
+    void DecodeDefinitionTo(std::string &out) const;
+
+    /**
+     * @brief Прочитане відкладене визначення або nullptr.
+     *
+     * Читається і змінюється під DefinitionLock(this): з nullptr на значення —
+     * при першому зверненні (AcquireLocked), назад — при витісненні
+     * (DefinitionCache), яке захоплює той самий м'ютекс через try_lock.
+     */
+    mutable std::atomic<const CachedDefinition *> cached{nullptr};
+
+    /** @brief Біт звернення для CLOCK: ставиться читачами, скидається стрілкою. */
+    mutable std::atomic<bool> recentlyUsed{false};
+
+    /** @brief Позиція в колі DefinitionCache (змінюється лише під його м'ютексом). */
+    mutable size_t cacheSlot = static_cast<size_t>(-1);
+
+    /**
+     * @brief М'ютекс, що захищає відкладене визначення терміна (спільний для кількох термінів).
+     */
+    static std::mutex &DefinitionLock(const TermBase *term);
+
+    /**
+     * @brief Прочитане відкладене визначення; читає його з файлу, якщо його немає в пам'яті.
+     *
+     * Викликати під DefinitionLock(this); вказівник дійсний, поки м'ютекс утримується.
+     */
+    const CachedDefinition *AcquireLocked() const;
+
+    /**
+     * @brief Скидає облік у кеші і звільняє прочитане визначення.
+     *
+     * Лише для терміна, який ще не опубліковано або який знищується.
+     */
+    void ReleaseCached();
+
+    /**
+     * @brief Копіює визначення іншого терміна в поля definition і foldedDefinition.
+     */
+    void AssignDefinition(const TermBase &other);
+
 public:
     /**
      * @brief Конструктор за замовчуванням.
@@ -90,16 +189,68 @@ public:
 
     /**
      * @brief Отримує визначення терміна.
+     *
+     * Відкладене визначення читається з файлу, а стиснене розкодовується при
+     * першому зверненні. Його може бути витіснено (DefinitionCache), тому посилання дійсне, доки
+     * викликач тримає знімок, отриманий з TermManager::Snapshot().
      * @return Константне посилання на рядок.
      */
     const std::string &GetDefinition() const;
 
+    /**
+     * @brief Передає визначення функції, не видаючи посилання назовні.
+     *
+     * Для переглядів усієї бази: визначення, якого немає в кеші, читається
+     * в буфер потоку і в кеш не потрапляє, тож перегляд не витісняє
+     * визначень, з якими працюють інші. Функція не повинна звертатися до
+     * визначень інших термінів.
+     * @param reader Отримує визначення на час виклику.
+     */
+    void ReadDefinition(const std::function<void(const std::string &)> &reader) const;
+
     /**
      * @brief Встановлює нове визначення.
      * @param value Новий текст визначення.
      */
     void SetDefinition(const std::string &value);
 
+    /**
+     * @brief Робить визначення відкладеним: воно буде прочитане з файлу при першому зверненні.
+     *
+     * Викликається завантажувачем до того, як термін потрапить у знімок.
+     * @param source Відображений файл бази.
+     * @param offset Зміщення екранованого визначення у файлі.
+     * @param length Довжина екранованого визначення.
+     * @param cache Кеш, що обмежує пам'ять прочитаних визначень (nullptr — без обліку).
+     */
+    void SetLazyDefinition(std::shared_ptr<const MappedFile> source, size_t offset, size_t length,
+                           DefinitionCache *cache = nullptr);
+
+    /**
+     * @brief Стискає визначення кодеком; розкодована копія з'являється лише при зверненні.
+     *
+     * Відкладене визначення спершу читається з файлу, після чого зв'язок
+     * з файлом розривається. Як і SetLazyDefinition, викликається
+     * завантажувачем до публікації терміна.
+     * @param codec Навчений кодек, спільний для всієї бази.
+     * @param cache Кеш, що обмежує пам'ять розкодованих копій (nullptr — без обліку).
+     * @return Пара {байтів до стиснення, байтів після}.
+     */
+    std::pair<size_t, size_t> CompressDefinition(std::shared_ptr<const DefinitionCodec> codec,
+                                                  DefinitionCache *cache = nullptr);
+
+    /**
+     * @brief Перевіряє, чи містить визначення підрядок (без урахування регістру).
+     *
+     * Використовує векторизоване ядро Simd::FindFolded; для визначень з великими
+     * кириличними літерами пошук іде по тіньовій копії foldedDefinition.
+     * Стиснене визначення, якого немає в кеші, розкодовується в буфер
+     * потоку і в кеш не потрапляє.
+     * @param foldedNeedle Шуканий фрагмент, приведений через Utils::FoldUTF8.
+     * @return true, якщо фрагмент знайдено.
+     */
+    bool DefinitionContains(const std::string &foldedNeedle) const;
+
     /**
      * @brief Повертає рядковий ідентифікатор типу терміна.
      * @return "PRIM" або "TERM" (реалізується у нащадках).
@@ -112,7 +263,16 @@ public:
      */
     virtual bool IsPrimitive() const = 0;
 
-    // Метод Serialize() тут не оголошується повторно,
+    /**
+     * @brief Створює копію терміна того ж типу.
+     *
+     * Використовується TermManager для редагування: опубліковані терміни не змінюються,
+     * замість цього змінюється копія, яка потім замінює оригінал.
+     * @return Новий об'єкт-копія.
+     */
+    virtual std::shared_ptr<TermBase> Clone() const = 0;
+
+    // Метод SerializeTo() тут не оголошується повторно,
     // оскільки він успадкований від ITermSerializable
     // і повинен бути реалізований у конкретних класах.
 };
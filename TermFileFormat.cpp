@@ -0,0 +1,287 @@
+/**
+ * @file TermFileFormat.cpp
+ * @brief Реалізація службових рядків файлу термінів та їх перевірки.
+ */
+
+#include "TermFileFormat.h"
+#include "Simd.h"
+#include "Utils.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+namespace {
+    /** @brief Початок підсумку блоку. */
+    constexpr const char *kBlockTag = "#BLOCK";
+
+    /** @brief Початок підсумку файлу. */
+    constexpr const char *kEndTag = "#END";
+
+    /**
+     * @brief Чи починається рядок з tag, за яким іде ';' або кінець рядка.
+     */
+    bool HasTag(const char *data, size_t size, const char *tag) {
+        size_t length = std::strlen(tag);
+        return size >= length && std::memcmp(data, tag, length) == 0 && (size == length || data[length] == ';');
+    }
+
+    /**
+     * @brief Розбирає невід'ємне число в системі base; усе поле має бути числом.
+     */
+    bool ParseNumber(const std::string &field, int base, unsigned long long &value) {
+        if (field.empty()) return false;
+        char *end = nullptr;
+        value = std::strtoull(field.c_str(), &end, base);
+        return end == field.c_str() + field.size() && field[0] != '-' && field[0] != '+';
+    }
+}
+
+// -------------------------------------------------------------
+//                     LINES
+// -------------------------------------------------------------
+
+/**
+ * @brief "#KURSOVA-TERMS;2\n".
+ */
+std::string TermFileFormat::Header() {
+    return std::string(kMagic) + ";" + std::to_string(kVersion) + "\n";
+}
+
+/**
+ * @brief "#END;<блоків>;<рядків>\n".
+ */
+std::string TermFileFormat::Footer(size_t blocks, size_t lines) {
+    return std::string(kEndTag) + ";" + std::to_string(blocks) + ";" + std::to_string(lines) + "\n";
+}
+
+/**
+ * @brief Є хоч одне пошкодження.
+ */
+bool TermFileFormat::Report::Damaged() const {
+    return !problems.empty();
+}
+
+// -------------------------------------------------------------
+//                     BLOCK WRITER
+// -------------------------------------------------------------
+
+/**
+ * @brief Дораховує CRC блоку по новому рядку.
+ */
+bool TermFileFormat::BlockWriter::AddLine(std::string &buffer, size_t from) {
+    const size_t length = buffer.size() - from;
+    crc = Simd::Crc32c(crc, buffer.data() + from, length);
+    bytes += length;
+    lines++;
+    if (bytes < kBlockBytes) return false;
+    Seal(buffer);
+    return true;
+}
+
+/**
+ * @brief Дописує "#BLOCK;<рядків>;<CRC32C>" і починає новий блок.
+ */
+void TermFileFormat::BlockWriter::Seal(std::string &buffer) {
+    if (lines == 0) return;
+    char trailer[64];
+    int length = std::snprintf(trailer, sizeof(trailer), "%s;%zu;%08x\n", kBlockTag, lines,
+                               static_cast<unsigned>(crc));
+    buffer.append(trailer, static_cast<size_t>(length));
+    blocks++;
+    sealedLines += lines;
+    crc = 0;
+    bytes = 0;
+    lines = 0;
+}
+
+/**
+ * @brief Кількість закритих блоків.
+ */
+size_t TermFileFormat::BlockWriter::GetBlocks() const {
+    return blocks;
+}
+
+/**
+ * @brief Кількість рядків у закритих блоках.
+ */
+size_t TermFileFormat::BlockWriter::GetLines() const {
+    return sealedLines;
+}
+
+// -------------------------------------------------------------
+//                     VERIFIER
+// -------------------------------------------------------------
+
+/**
+ * @brief Запам'ятовує шлях і спосіб підрахунку.
+ */
+TermFileFormat::Verifier::Verifier(std::string path, bool contiguous)
+        : contiguous(contiguous) {
+    report.path = std::move(path);
+}
+
+/**
+ * @brief Заголовок, службовий рядок або рядок терміна.
+ *
+ * Файл версії 1 не перевіряється: кожен рядок — рядок терміна.
+ */
+bool TermFileFormat::Verifier::Line(const char *data, size_t size) {
+    ++lineNumber;
+    if (!readable) return false;
+
+    const size_t magicLength = std::strlen(kMagic);
+    if (lineNumber == 1 && size >= magicLength && std::memcmp(data, kMagic, magicLength) == 0) {
+        unsigned long long version = 0;
+        auto fields = Utils::Split(std::string(data, size), ';');
+        report.version = kVersion;
+        if (fields.size() != 2 || !ParseNumber(fields[1], 10, version) || version == 0) {
+            report.problems.push_back("рядок 1: пошкоджений заголовок");
+        } else if (version > static_cast<unsigned long long>(kVersion)) {
+            report.version = static_cast<int>(version);
+            report.problems.push_back("версія формату " + std::to_string(version) +
+                                      " новіша за підтримувану " + std::to_string(kVersion));
+            readable = false;
+        }
+        return false;
+    }
+    if (report.version < 2) return true;
+
+    if (size > 0 && data[0] == '#' && Directive(data, size)) return false;
+    if (ended && !afterEnd) {
+        report.problems.push_back("рядок " + std::to_string(lineNumber) + ": дані після підсумку #END");
+        afterEnd = true;
+    }
+
+    if (blockLines == 0) blockFirstLine = lineNumber;
+    blockLines++;
+    if (contiguous) {
+        if (!blockBegin) blockBegin = data;
+        blockEnd = data + size;
+    } else {
+        crc = Simd::Crc32c(crc, data, size);
+        crc = Simd::Crc32c(crc, "\n", 1);
+    }
+    return true;
+}
+
+/**
+ * @brief #BLOCK закриває блок, #END — файл; інші рядки з '#' вважаються даними.
+ */
+bool TermFileFormat::Verifier::Directive(const char *data, size_t size) {
+    const bool block = HasTag(data, size, kBlockTag);
+    const bool end = HasTag(data, size, kEndTag);
+    if (!block && !end) return false;
+
+    auto fields = Utils::Split(std::string(data, size), ';');
+    unsigned long long first = 0, second = 0;
+    bool parsed = fields.size() == 3 && ParseNumber(fields[1], 10, first) &&
+                  ParseNumber(fields[2], block ? 16 : 10, second);
+
+    if (block) {
+        if (parsed && fields[2].size() == 8) {
+            CloseBlock(static_cast<size_t>(first), static_cast<uint32_t>(second));
+        } else {
+            report.blocks++;
+            report.damagedBlocks++;
+            report.problems.push_back("блок " + std::to_string(report.blocks) + " (" + BlockLines() +
+                                      "): пошкоджений підсумок блоку у рядку " + std::to_string(lineNumber));
+            totalLines += blockLines;
+            crc = 0;
+            blockBegin = nullptr;
+            blockLines = 0;
+        }
+        return true;
+    }
+
+    if (blockLines > 0) {
+        report.problems.push_back(BlockLines() + ": немає підсумку блоку перед #END");
+        totalLines += blockLines;
+        blockLines = 0;
+        crc = 0;
+        blockBegin = nullptr;
+    }
+    if (!parsed) {
+        report.problems.push_back("рядок " + std::to_string(lineNumber) + ": пошкоджений підсумок файлу");
+    } else if (first != report.blocks || second != totalLines) {
+        report.problems.push_back("підсумок файлу: блоків " + std::to_string(first) + ", рядків " +
+                                  std::to_string(second) + "; прочитано блоків " + std::to_string(report.blocks) +
+                                  ", рядків " + std::to_string(totalLines));
+    }
+    ended = true;
+    return true;
+}
+
+/**
+ * @brief Звіряє кількість рядків і CRC32C блоку з його підсумком.
+ */
+void TermFileFormat::Verifier::CloseBlock(size_t expectedLines, uint32_t expectedCrc) {
+    uint32_t actual = crc;
+    if (contiguous) {
+        // '\n' між рядками лежать усередині діапазону, останній дораховується окремо:
+        // після останнього рядка файлу його може не бути
+        actual = blockBegin ? Simd::Crc32c(0, blockBegin, static_cast<size_t>(blockEnd - blockBegin)) : 0;
+        if (blockBegin) actual = Simd::Crc32c(actual, "\n", 1);
+    }
+    report.blocks++;
+
+    if (blockLines != expectedLines) {
+        report.damagedBlocks++;
+        report.problems.push_back("блок " + std::to_string(report.blocks) + " (" + BlockLines() + "): рядків " +
+                                  std::to_string(blockLines) + ", у підсумку " + std::to_string(expectedLines));
+    } else if (actual != expectedCrc) {
+        char sums[64];
+        std::snprintf(sums, sizeof(sums), "CRC32C %08x, у підсумку %08x", static_cast<unsigned>(actual),
+                      static_cast<unsigned>(expectedCrc));
+        report.damagedBlocks++;
+        report.problems.push_back("блок " + std::to_string(report.blocks) + " (" + BlockLines() + "): " + sums);
+    }
+
+    totalLines += blockLines;
+    crc = 0;
+    blockBegin = nullptr;
+    blockLines = 0;
+}
+
+/**
+ * @brief "рядки 12–530", "рядок 12" або "без рядків".
+ */
+std::string TermFileFormat::Verifier::BlockLines() const {
+    if (blockLines == 0) return "без рядків";
+    if (blockLines == 1) return "рядок " + std::to_string(blockFirstLine);
+    return "рядки " + std::to_string(blockFirstLine) + "–" + std::to_string(blockFirstLine + blockLines - 1);
+}
+
+/**
+ * @brief Номер щойно прочитаного рядка потрапляє у звіт.
+ */
+void TermFileFormat::Verifier::Skipped() {
+    report.skippedLines.push_back(lineNumber);
+}
+
+/**
+ * @brief Файл версії 2 має закінчуватися підсумком #END.
+ */
+void TermFileFormat::Verifier::Finish() {
+    if (report.version < 2 || !readable || ended) return;
+    if (blockLines > 0) {
+        report.problems.push_back(BlockLines() + ": немає підсумку блоку, файл обрізано");
+    } else {
+        report.problems.push_back("немає підсумку #END, файл обрізано після блоку " + std::to_string(report.blocks));
+    }
+}
+
+/**
+ * @brief Чи підтримується версія файлу.
+ */
+bool TermFileFormat::Verifier::Readable() const {
+    return readable;
+}
+
+/**
+ * @brief Підсумок перевірки.
+ */
+const TermFileFormat::Report &TermFileFormat::Verifier::GetReport() const {
+    return report;
+}
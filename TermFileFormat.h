@@ -0,0 +1,209 @@
+/**
+ * @file TermFileFormat.h
+ * @brief Оголошення формату файлу термінів з версією та контрольними сумами блоків.
+ */
+
+#ifndef KURSOVA_TERMFILEFORMAT_H
+#define KURSOVA_TERMFILEFORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class TermFileFormat
+ * @brief Службові рядки файлу термінів (terms.csv і шардів) та їх перевірка.
+ *
+ * Версія 2 формату:
+ * @code
+ * #KURSOVA-TERMS;2
+ * <рядки термінів>
+ * #BLOCK;<рядків>;<CRC32C, 8 шістнадцяткових цифр>
+ * <рядки термінів>
+ * #BLOCK;<рядків>;<CRC32C>
+ * #END;<блоків>;<рядків>
+ * @endcode
+ * CRC32C блоку (Simd::Crc32c) рахується по байтах його рядків разом з '\n'.
+ * Блок закривається на межах блоків знімка (TermSnapshot::kChunkSize
+ * термінів; у шарді — kShardBlockChunks таких блоків) і додатково, щойно
+ * набере kBlockBytes. Межі не залежать від кількості потоків запису, тож
+ * послідовний і паралельний запис дають однакові файли. Рядок терміна
+ * починається з типу (PRIM/TERM), тому службові рядки з '#' з ним не
+ * плутаються. Підсумок #END виявляє обрізаний файл.
+ *
+ * Файл без заголовка читається як версія 1: без перевірки, як раніше.
+ */
+class TermFileFormat {
+public:
+    /** @brief Початок заголовка. */
+    static constexpr const char *kMagic = "#KURSOVA-TERMS";
+
+    /** @brief Версія формату, яку пише програма. */
+    static constexpr int kVersion = 2;
+
+    /** @brief Розмір, після якого блок закривається. */
+    static constexpr size_t kBlockBytes = 64 * 1024;
+
+    /** @brief Скільки блоків знімка покриває один блок файлу шарду (шард бере лише частину їхніх термінів). */
+    static constexpr size_t kShardBlockChunks = 16;
+
+    /**
+     * @brief Рядок заголовка разом з '\n'.
+     */
+    static std::string Header();
+
+    /**
+     * @brief Підсумковий рядок файлу разом з '\n'.
+     * @param blocks Кількість блоків у файлі.
+     * @param lines Кількість рядків термінів у файлі.
+     */
+    static std::string Footer(size_t blocks, size_t lines);
+
+    /**
+     * @class BlockWriter
+     * @brief Закриває блоки в буфері, куди дописуються рядки термінів.
+     *
+     * Кожен буфер паралельного запису має власний BlockWriter; буфер
+     * починається і закінчується на межі блоку.
+     */
+    class BlockWriter {
+    public:
+        /**
+         * @brief Враховує рядок, щойно дописаний у кінець buffer (разом з '\n').
+         * @param buffer Буфер запису.
+         * @param from Позиція початку рядка в буфері.
+         * @return true, якщо блок набрав kBlockBytes і його закрито.
+         */
+        bool AddLine(std::string &buffer, size_t from);
+
+        /**
+         * @brief Закриває поточний блок, якщо в ньому є рядки.
+         */
+        void Seal(std::string &buffer);
+
+        /**
+         * @brief Закритих блоків.
+         */
+        size_t GetBlocks() const;
+
+        /**
+         * @brief Рядків у закритих блоках.
+         */
+        size_t GetLines() const;
+
+    private:
+        uint32_t crc = 0;
+        size_t bytes = 0;
+        size_t lines = 0;
+        size_t blocks = 0;
+        size_t sealedLines = 0;
+    };
+
+    /**
+     * @brief Підсумок перевірки одного файлу.
+     */
+    struct Report {
+        /** @brief Шлях до файлу. */
+        std::string path;
+        /** @brief Версія формату (1 — без заголовка). */
+        int version = 1;
+        /** @brief Блоків, чию суму перевірено. */
+        size_t blocks = 0;
+        /** @brief Блоків з помилкою. */
+        size_t damagedBlocks = 0;
+        /** @brief Описи пошкоджень; непорожній список означає, що файлу не можна довіряти. */
+        std::vector<std::string> problems;
+        /** @brief Номери рядків, пропущених як нерозібрані (менше чотирьох полів). */
+        std::vector<size_t> skippedLines;
+
+        /**
+         * @brief Чи знайдено пошкодження.
+         */
+        bool Damaged() const;
+    };
+
+    /**
+     * @class Verifier
+     * @brief Перевіряє файл рядок за рядком під час читання.
+     *
+     * Читач передає кожен рядок файлу (без '\n') у Line і розбирає лише
+     * ті, для яких Line повернула true; наприкінці викликає Finish.
+     * Терміни з пошкодженого блоку вже розібрані, коли сума блоку не
+     * зійдеться: вони лишаються в базі, а Report показує, які саме рядки
+     * їм не відповідають.
+     */
+    class Verifier {
+    public:
+        /**
+         * @brief Починає перевірку файлу.
+         * @param path Шлях (для повідомлень).
+         * @param contiguous true, якщо рядки лежать у пам'яті підряд через '\n'
+         *        (відображений файл): тоді сума блоку рахується одним викликом
+         *        по всьому блоку, а не по рядках.
+         */
+        explicit Verifier(std::string path, bool contiguous = false);
+
+        /**
+         * @brief Обробляє черговий рядок файлу.
+         * @param data Початок рядка.
+         * @param size Довжина без '\n'.
+         * @return true, якщо це рядок терміна і його треба розібрати.
+         */
+        bool Line(const char *data, size_t size);
+
+        /**
+         * @brief Запам'ятовує, що останній рядок терміна не вдалося розібрати.
+         */
+        void Skipped();
+
+        /**
+         * @brief Завершує перевірку після останнього рядка.
+         */
+        void Finish();
+
+        /**
+         * @brief Чи можна читати файл далі (false — версія новіша за підтримувану).
+         */
+        bool Readable() const;
+
+        /**
+         * @brief Підсумок перевірки (повний після Finish).
+         */
+        const Report &GetReport() const;
+
+    private:
+        /**
+         * @brief Розбирає службовий рядок; false — це не службовий рядок.
+         */
+        bool Directive(const char *data, size_t size);
+
+        /**
+         * @brief Порівнює підсумок блоку з прочитаними рядками.
+         */
+        void CloseBlock(size_t expectedLines, uint32_t expectedCrc);
+
+        /**
+         * @brief Діапазон рядків поточного блоку для повідомлень.
+         */
+        std::string BlockLines() const;
+
+        Report report;
+        bool contiguous;
+
+        /** @brief Номер поточного рядка файлу (з 1). */
+        size_t lineNumber = 0;
+        bool readable = true;
+        bool ended = false;
+        bool afterEnd = false;
+
+        uint32_t crc = 0;
+        const char *blockBegin = nullptr;
+        const char *blockEnd = nullptr;
+        size_t blockLines = 0;
+        size_t blockFirstLine = 0;
+        size_t totalLines = 0;
+    };
+};
+
+#endif //KURSOVA_TERMFILEFORMAT_H
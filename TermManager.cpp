@@ -7,12 +7,20 @@
  */
 
 #include "TermManager.h"
+#include "TermQuery.h"
 #include "Term.h"
 #include "PrimitiveTerm.h"
 #include "Utils.h"
+#include "LineReader.h"
+#include "MappedFile.h"
+#include "Simd.h"
+#include "Metrics.h"
 
-#include <fstream>
 #include <iostream>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <iterator>
 #include <algorithm>
 #include <stdexcept>
 #include <iomanip> // Для форматування виводу (std::setw)
@@ -23,66 +31,500 @@
 
 /**
  * @brief Конструктор менеджера.
- * @param filePath Шлях до файлу CSV, де зберігається база термінів.
+ * @param filePath Шлях до файлу CSV або каталогу з шардами, де зберігається база термінів.
  */
 TermManager::TermManager(const std::string &filePath)
-        : filePath(filePath) {}
+        : definitionCache(std::make_unique<DefinitionCache>()),
+          current(std::make_shared<TermSnapshot>()),
+          scanner(std::make_unique<ScanExecutor>()),
+          filePath(filePath) {
+    if (ShardStore::IsDirectory(filePath)) shardStore = std::make_unique<ShardStore>(filePath);
+}
+
+/**
+ * @brief Деструктор: зупиняє фоновий потік збереження.
+ *
+ * Якщо збереження виконувались у фоні, незаписані зміни дописуються
+ * синхронно, щоб вихід з програми не загубив останню серію правок.
+ */
+TermManager::~TermManager() {
+    {
+        std::lock_guard<std::mutex> lock(saverMutex);
+        stopSaver = true;
+    }
+    saverWake.notify_one();
+    if (saver.joinable()) {
+        saver.join();
+        Flush();
+    }
+}
 
 // -------------------------------------------------------------
-//                     LOAD
+//                     SNAPSHOTS
 // -------------------------------------------------------------
 
 /**
- * @brief Завантажує список термінів з файлу.
+ * @brief Атомарно читає поточну версію бази.
+ * @return Незмінний знімок.
+ */
+std::shared_ptr<const TermSnapshot> TermManager::Snapshot() const {
+    if (!pinReads.load(std::memory_order_acquire)) return std::atomic_load(&current);
+
+    // Кладовище закріплюється раніше за знімок: усе, що витіснять після
+    // цього, переживе читача (див. DefinitionCache)
+    struct Pinned {
+        std::shared_ptr<const void> graveyard;
+        std::shared_ptr<const TermSnapshot> snapshot;
+    };
+    auto pinned = std::make_shared<Pinned>();
+    pinned->graveyard = definitionCache->Pin();
+    pinned->snapshot = std::atomic_load(&current);
+    return std::shared_ptr<const TermSnapshot>(pinned, pinned->snapshot.get());
+}
+
+/**
+ * @brief Замінює кожен термін вказівником, що володіє знімком (лише для pinReads).
+ */
+void TermManager::PinTerms(const std::shared_ptr<const TermSnapshot> &snapshot,
+                           std::vector<TermSnapshot::TermPtr> &terms) const {
+    if (!pinReads.load(std::memory_order_acquire)) return;
+    for (auto &term : terms) term = TermSnapshot::TermPtr(snapshot, term.get());
+}
+
+/**
+ * @brief Копіює поточний знімок для зміни.
  *
- * Читає файл рядково, розбиває CSV (враховуючи екранування),
- * визначає тип терміна (PRIM або TERM) та створює відповідні об'єкти.
+ * Копіюються лише вказівники на блоки та сегменти індексів, самі дані
+ * залишаються спільними, доки їх не буде змінено.
+ * @return Неопублікована версія.
  */
-void TermManager::Load() {
-    terms.clear();
-    std::ifstream in(filePath);
-    if (!in.is_open()) {
-        std::cout << "[INFO] Файл термінів не знайдено, буде створено новий." << std::endl;
-        return;
+std::shared_ptr<TermSnapshot> TermManager::BeginWrite() const {
+    return std::make_shared<TermSnapshot>(*Snapshot());
+}
+
+/**
+ * @brief Публікує нову версію.
+ *
+ * Після атомарної заміни нові читачі бачать тільки нову версію, а стара
+ * звільняється, коли її відпустить останній читач.
+ * @param next Підготовлена версія.
+ */
+void TermManager::Publish(const std::shared_ptr<TermSnapshot> &next) {
+    next->BumpVersion();
+    if (shardStore) {
+        for (const auto &name : touched) {
+            shardStore->MarkChanged(shardStore->ShardOf(Utils::FoldUTF8(name)), next->GetVersion());
+        }
     }
+    touched.clear();
+    std::atomic_store(&current, std::shared_ptr<const TermSnapshot>(next));
+}
 
-    try {
-        std::string line;
-        while (std::getline(in, line)) {
-            if (line.empty()) continue;
+/**
+ * @brief Перебудовує копію в новому порядку і публікує її.
+ *
+ * Rebuild перенумеровує терміни, що змінили місце; їхні шарди
+ * позначаються зміненими, інакше збереження не записало б новий порядок.
+ * Номери живуть у знімку, тож опубліковані версії (і збереження, що
+ * якраз пише одну з них) нових номерів не бачать.
+ * @param next Неопублікована копія.
+ * @param terms Усі терміни копії в новому порядку.
+ */
+void TermManager::PublishReordered(const std::shared_ptr<TermSnapshot> &next,
+                                   const std::vector<TermSnapshot::TermPtr> &terms) {
+    std::vector<uint64_t> before(terms.size());
+    for (size_t i = 0; i < terms.size(); ++i) before[i] = next->SequenceOf(terms[i].get());
+    next->Rebuild(terms, before);
+    for (size_t i = 0; i < terms.size(); ++i) {
+        if (next->SequenceOf(terms[i].get()) != before[i]) Touch(terms[i]->GetName());
+    }
+    Publish(next);
+}
 
-            // Використовуємо наш покращений Utils::Split, що враховує екранування ';'
-            auto parts = Utils::Split(line, ';');
-            
-            // Очікуємо мінімум 4 поля: TYPE;Name;Def;Refs
-            if (parts.size() < 4) continue;
+/**
+ * @brief Запам'ятовує назву зміненого терміна до найближчого Publish.
+ * @param name Назва терміна.
+ */
+void TermManager::Touch(const std::string &name) {
+    if (shardStore) touched.push_back(name);
+}
 
-            std::string type = parts[0];
-            std::string name = Utils::Unescape(parts[1]);
-            std::string definition = Utils::Unescape(parts[2]);
-            std::string refsStr = parts[3];
+// -------------------------------------------------------------
+//                     LOAD
+// -------------------------------------------------------------
 
-            if (type == "PRIM") {
-                terms.push_back(std::make_shared<PrimitiveTerm>(name, definition));
+/**
+ * @brief Створює термін за типом з уже розекранованих полів.
+ * @param type PRIM або TERM.
+ * @param refsStr Поле посилань як у файлі (екрановане).
+ * @return Термін або nullptr для невідомого типу.
+ */
+static std::shared_ptr<TermBase> MakeTerm(const std::string &type, const std::string &name,
+                                          const std::string &definition, const std::string &refsStr) {
+    if (type == "PRIM") {
+        return std::make_shared<PrimitiveTerm>(name, definition);
+
+    } else if (type == "TERM") {
+        std::vector<std::string> refs;
+
+        if (!refsStr.empty()) {
+            auto rawRefs = Utils::Split(refsStr, ',');
+            for (auto &r : rawRefs) {
+                auto trimmed = Utils::Trim(Utils::Unescape(r));
+                if (!trimmed.empty()) refs.push_back(trimmed);
+            }
+        }
 
-            } else if (type == "TERM") {
-                std::vector<std::string> refs;
+        return std::make_shared<Term>(name, definition, refs);
+    }
+    return nullptr;
+}
 
-                if (!refsStr.empty()) {
-                    auto rawRefs = Utils::Split(refsStr, ',');
-                    for (auto &r : rawRefs) {
-                        auto trimmed = Utils::Trim(Utils::Unescape(r));
-                        if (!trimmed.empty()) refs.push_back(trimmed);
-                    }
-                }
+/**
+ * @brief Розбирає п'яте поле рядка шарду — порядковий номер терміна.
+ * @return Номер або 0, якщо поле не є додатним числом.
+ */
+static uint64_t ParseSequence(const char *data, size_t size) {
+    uint64_t value = 0;
+    auto result = std::from_chars(data, data + size, value);
+    return result.ec == std::errc() && result.ptr == data + size ? value : 0;
+}
+
+/**
+ * @brief Дописує до рядка шарду поле ";<номер>" без проміжних рядків.
+ */
+static void AppendSequence(std::string &out, uint64_t sequence) {
+    char digits[24];
+    digits[0] = ';';
+    auto end = std::to_chars(digits + 1, digits + sizeof(digits), sequence).ptr;
+    out.append(digits, static_cast<size_t>(end - digits));
+}
+
+/**
+ * @brief Розбирає рядок CSV бази і додає термін до списку.
+ *
+ * Розбиває рядок з урахуванням екранування, визначає тип терміна
+ * (PRIM або TERM) та створює відповідний об'єкт.
+ * @param sequences Куди додати порядковий номер терміна (0 — у рядку його немає).
+ * @return false, якщо рядок не вдалося розібрати.
+ */
+static bool ParseTermLine(const std::string &line, std::vector<TermSnapshot::TermPtr> &terms,
+                          std::vector<uint64_t> &sequences) {
+    // Використовуємо наш покращений Utils::Split, що враховує екранування ';'
+    auto parts = Utils::Split(line, ';');
+
+    // Очікуємо мінімум 4 поля: TYPE;Name;Def;Refs (у шардах далі йде порядковий номер)
+    if (parts.size() < 4) return false;
+
+    auto term = MakeTerm(parts[0], Utils::Unescape(parts[1]), Utils::Unescape(parts[2]), parts[3]);
+    if (!term) return false;
+    sequences.push_back(parts.size() > 4 ? ParseSequence(parts[4].data(), parts[4].size()) : 0);
+    terms.push_back(std::move(term));
+    return true;
+}
+
+/**
+ * @brief Читає один файл CSV бази (весь terms.csv або один шард).
+ *
+ * Кожен рядок проходить через TermFileFormat::Verifier, тож суми блоків
+ * рахуються під час того ж проходу, що й розбір.
+ * @param sequences Порядкові номери, паралельно до terms (див. ParseTermLine).
+ * @param report Результат перевірки файлу.
+ * @return false, якщо файл не вдалося відкрити.
+ */
+static bool ReadTermFile(const std::string &path, IoBackend backend, std::vector<TermSnapshot::TermPtr> &terms,
+                         std::vector<uint64_t> &sequences, TermFileFormat::Report &report) {
+    LineReader in(path, backend);
+    if (!in.IsOpen()) return false;
 
-                terms.push_back(std::make_shared<Term>(name, definition, refs));
+    TermFileFormat::Verifier verifier(path);
+    try {
+        std::string line;
+        while (in.Next(line)) {
+            if (!verifier.Line(line.data(), line.size())) {
+                if (!verifier.Readable()) break;
+                continue;
             }
+            if (!line.empty() && !ParseTermLine(line, terms, sequences)) verifier.Skipped();
         }
     }
     catch (const std::exception &ex) {
         std::cerr << "[ERROR] Помилка читання файлу: " << ex.what() << std::endl;
     }
+    if (!in.Error().empty()) {
+        std::cerr << "[ERROR] Помилка читання файлу: " << in.Error() << std::endl;
+    }
+    verifier.Finish();
+    report = verifier.GetReport();
+    return true;
+}
+
+/**
+ * @brief Читає файл CSV бази, не розбираючи визначень.
+ *
+ * Файл відображається в пам'ять; у кожному рядку шукаються межі полів
+ * (з урахуванням екранування), назва і посилання розбираються як
+ * зазвичай, а для визначення запам'ятовуються лише зміщення і довжина
+ * (TermBase::SetLazyDefinition). Рядки з менш ніж чотирма полями
+ * пропускаються, як і в ParseTermLine. Рядки лежать у відображенні
+ * підряд, тож сума блоку рахується одним викликом Simd::Crc32c.
+ * @param cache Кеш, що обліковуватиме прочитані визначення.
+ * @param sequences Порядкові номери, паралельно до terms.
+ * @param report Результат перевірки файлу.
+ * @return false, якщо файл не вдалося відкрити.
+ */
+static bool ReadTermFileLazy(const std::string &path, DefinitionCache *cache,
+                             std::vector<TermSnapshot::TermPtr> &terms, std::vector<uint64_t> &sequences,
+                             TermFileFormat::Report &report) {
+    auto file = std::make_shared<const MappedFile>(path);
+    if (!file->IsOpen()) return false;
+
+    TermFileFormat::Verifier verifier(path, true);
+
+    const char *data = file->Data();
+    const size_t size = file->Size();
+    std::string name;
+    size_t pos = 0;
+    while (pos < size) {
+        const char *eol = static_cast<const char *>(std::memchr(data + pos, '\n', size - pos));
+        size_t end = eol ? static_cast<size_t>(eol - data) : size;
+        const char *line = data + pos;
+        const size_t length = end - pos;
+        if (!verifier.Line(line, length)) {
+            if (!verifier.Readable()) break;
+            pos = end + 1;
+            continue;
+        }
+
+        size_t bounds[3];
+        size_t field = 0;
+        size_t start = 0;
+        for (; field < 3; ++field) {
+            size_t at = start + Utils::FindUnescaped(line + start, length - start, ';');
+            if (at >= length) break;
+            bounds[field] = at;
+            start = at + 1;
+        }
+
+        if (field == 3) {
+            size_t refsEnd = start + Utils::FindUnescaped(line + start, length - start, ';');
+            if (refsEnd > length) refsEnd = length;
+
+            std::string type(line, bounds[0]);
+            name.clear();
+            Utils::UnescapeTo(name, line + bounds[0] + 1, bounds[1] - bounds[0] - 1);
+            auto term = MakeTerm(type, name, std::string(), std::string(line + start, refsEnd - start));
+            if (term) {
+                term->SetLazyDefinition(file, pos + bounds[1] + 1, bounds[2] - bounds[1] - 1, cache);
+                sequences.push_back(refsEnd < length ? ParseSequence(line + refsEnd + 1, length - refsEnd - 1) : 0);
+                terms.push_back(std::move(term));
+            } else {
+                verifier.Skipped();
+            }
+        } else if (length > 0) {
+            verifier.Skipped();
+        }
+        pos = end + 1;
+    }
+    verifier.Finish();
+    report = verifier.GetReport();
+    return true;
+}
+
+/**
+ * @brief Завантажує список термінів з файлу або каталогу шардів.
+ *
+ * Шарди читаються паралельно, кожен у власний список; у базі терміни
+ * йдуть шард за шардом, у межах шарду — у порядку файлу.
+ */
+void TermManager::Load() {
+    Metrics::Timer timer(Metrics::Op::Load);
+    std::lock_guard<std::mutex> lock(writeMutex);
+    // Збереження не повинне підміняти файли шардів, поки вони читаються
+    std::lock_guard<std::mutex> saveLock(saveMutex);
+    std::vector<TermSnapshot::TermPtr> terms;
+    std::vector<uint64_t> sequences;
+    auto next = BeginWrite();
+    const bool lazy = lazyDefinitions.load();
+    const bool compressed = compressedDefinitions.load();
+    // Стиснення бере визначення прямо з відображеного файлу, не розкладаючи їх у купі
+    const bool mapped = lazy || compressed;
+    // Індекс слів прочитав би всі відкладені визначення ще під час завантаження;
+    // стиснені для нього розкодовуються в буфер потоку
+    next->SetWordIndex(!lazy);
+
+    bool found;
+    std::vector<TermFileFormat::Report> reports;
+    if (shardStore) {
+        if (!shardStore->Error().empty()) {
+            std::cerr << "[ERROR] Маніфест шардів пошкоджено: " << shardStore->Error() << std::endl;
+        }
+        found = shardStore->HasManifest();
+        if (found) LoadShards(terms, sequences, mapped, reports);
+    } else {
+        reports.emplace_back();
+        found = mapped ? ReadTermFileLazy(filePath, definitionCache.get(), terms, sequences, reports.back())
+                       : ReadTermFile(filePath, ioBackend.load(), terms, sequences, reports.back());
+        if (!found) reports.clear();
+    }
+    ReportIntegrity(std::move(reports));
+    // Лишається ввімкненим: старі знімки з відкладеними визначеннями ще можуть читати
+    if (mapped) pinReads.store(true);
+
+    if (!found) {
+        if (!shardStore || shardStore->Error().empty()) {
+            std::cout << "[INFO] Файл термінів не знайдено, буде створено новий." << std::endl;
+        }
+        next->Rebuild(terms);
+        Publish(next);
+        return;
+    }
+
+    if (compressed) CompressDefinitions(terms);
+    next->Rebuild(terms, sequences);
+    Publish(next);
+    savedVersion = next->GetVersion();
+}
+
+/**
+ * @brief Вибірка -> DefinitionCodec::Train -> паралельне стиснення.
+ *
+ * У вибірку йдуть визначення kCodecSampleTerms термінів через рівні
+ * проміжки, поки не набереться kCodecSampleBytes. Терміни стискаються
+ * блоками на потоках ScanExecutor.
+ */
+void TermManager::CompressDefinitions(const std::vector<TermSnapshot::TermPtr> &terms) {
+    if (terms.empty()) return;
+    auto started = std::chrono::steady_clock::now();
+
+    std::vector<std::string> sample;
+    size_t sampleBytes = 0;
+    const size_t stride = std::max<size_t>(1, terms.size() / kCodecSampleTerms);
+    for (size_t i = 0; i < terms.size() && sampleBytes < kCodecSampleBytes; i += stride) {
+        terms[i]->ReadDefinition([&](const std::string &definition) {
+            sample.push_back(definition);
+            sampleBytes += definition.size();
+        });
+    }
+    auto codec = DefinitionCodec::Train(sample);
+
+    const size_t blocks = std::min<size_t>(terms.size(), 64);
+    std::vector<std::pair<size_t, size_t>> sizes(blocks);
+    scanner->ParallelFor(blocks, [&](size_t block) {
+        size_t begin = terms.size() * block / blocks;
+        size_t end = terms.size() * (block + 1) / blocks;
+        for (size_t i = begin; i < end; ++i) {
+            // Терміни створено завантажувачем як змінні і ще не опубліковано
+            auto result = const_cast<TermBase &>(*terms[i]).CompressDefinition(codec, definitionCache.get());
+            sizes[block].first += result.first;
+            sizes[block].second += result.second;
+        }
+    });
+
+    auto stats = std::make_shared<DefinitionCodec::Stats>();
+    stats->symbols = codec->GetSymbolCount();
+    stats->terms = terms.size();
+    for (const auto &size : sizes) {
+        stats->plainBytes += size.first;
+        stats->encodedBytes += size.second;
+    }
+    stats->elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    std::atomic_store(&compression, std::shared_ptr<const DefinitionCodec::Stats>(stats));
+}
+
+/**
+ * @brief Кожен шард читається окремим завданням ScanExecutor у власний список.
+ *
+ * Кожен список упорядковано за порядковими номерами, тож спільний порядок
+ * бази відновлюється попарним злиттям. Якщо хоч один шард записано без
+ * номерів (старішою версією програми), терміни йдуть шард за шардом.
+ */
+void TermManager::LoadShards(std::vector<TermSnapshot::TermPtr> &terms, std::vector<uint64_t> &sequences, bool lazy,
+                             std::vector<TermFileFormat::Report> &reports) const {
+    const size_t count = shardStore->GetShardCount();
+    const IoBackend backend = ioBackend.load();
+    std::vector<std::vector<TermSnapshot::TermPtr>> parts(count);
+    std::vector<std::vector<uint64_t>> partSequences(count);
+    std::vector<TermFileFormat::Report> shardReports(count);
+    std::vector<char> opened(count, 0);
+
+    scanner->ParallelFor(count, [&](size_t shard) {
+        std::string path = shardStore->CurrentPath(shard);
+        if (path.empty()) return;
+        opened[shard] = lazy ? ReadTermFileLazy(path, definitionCache.get(), parts[shard], partSequences[shard],
+                                                shardReports[shard])
+                             : ReadTermFile(path, backend, parts[shard], partSequences[shard], shardReports[shard]);
+        if (!opened[shard]) {
+            std::cerr << "[ERROR] Не вдалося відкрити шард: " << path << std::endl;
+        }
+    });
+
+    bool sequenced = true;
+    // Номер разом з терміном, щоб злиття переставляло їх разом
+    std::vector<std::pair<uint64_t, TermSnapshot::TermPtr>> ordered;
+    std::vector<size_t> bounds{0};
+    for (size_t shard = 0; shard < count; ++shard) {
+        for (size_t i = 0; i < parts[shard].size(); ++i) {
+            sequenced = sequenced && partSequences[shard][i] != 0;
+            ordered.emplace_back(partSequences[shard][i], std::move(parts[shard][i]));
+        }
+        bounds.push_back(ordered.size());
+    }
+    const auto bySequence = [](const std::pair<uint64_t, TermSnapshot::TermPtr> &a,
+                               const std::pair<uint64_t, TermSnapshot::TermPtr> &b) {
+        return a.first < b.first;
+    };
+    // Сусідні відрізки зливаються попарно, доки не лишиться один
+    while (sequenced && bounds.size() > 2) {
+        std::vector<size_t> merged{bounds[0]};
+        for (size_t i = 2; i < bounds.size(); i += 2) {
+            std::inplace_merge(ordered.begin() + static_cast<std::ptrdiff_t>(bounds[i - 2]),
+                               ordered.begin() + static_cast<std::ptrdiff_t>(bounds[i - 1]),
+                               ordered.begin() + static_cast<std::ptrdiff_t>(bounds[i]), bySequence);
+            merged.push_back(bounds[i]);
+        }
+        if (bounds.size() % 2 == 0) merged.push_back(bounds.back());
+        bounds = std::move(merged);
+    }
+    terms.reserve(terms.size() + ordered.size());
+    sequences.reserve(sequences.size() + ordered.size());
+    for (auto &entry : ordered) {
+        // Без спільного порядку номери шардів не зростають і лише заважали б Rebuild
+        sequences.push_back(sequenced ? entry.first : 0);
+        terms.push_back(std::move(entry.second));
+    }
+    for (size_t shard = 0; shard < count; ++shard) {
+        if (opened[shard]) reports.push_back(std::move(shardReports[shard]));
+    }
+}
+
+/**
+ * @brief Виводить пошкодження, знайдені при читанні, і запам'ятовує звіти.
+ *
+ * Для кожного пошкодженого блоку називається файл, номер блоку і його
+ * рядки. Терміни з таких блоків уже в базі; щоб збереження не закріпило
+ * їх поверх файлу, який ще можна відновити, SaveSnapshot після цього
+ * відмовляється перезаписувати базу (експорт у інший файл дозволено).
+ */
+void TermManager::ReportIntegrity(std::vector<TermFileFormat::Report> reports) {
+    bool damaged = false;
+    for (const auto &report : reports) {
+        for (const auto &problem : report.problems) {
+            std::cerr << "[ERROR] " << report.path << ": " << problem << std::endl;
+        }
+        if (!report.skippedLines.empty()) {
+            std::cerr << "[WARN] " << report.path << ": пропущено нерозібраних рядків: "
+                      << report.skippedLines.size() << " (перший — рядок " << report.skippedLines.front() << ")"
+                      << std::endl;
+        }
+        damaged = damaged || report.Damaged();
+    }
+    if (damaged) {
+        std::cerr << "[ERROR] Базу завантажено з пошкоджених файлів; збереження поверх них вимкнено, "
+                     "експортуйте базу в інший файл." << std::endl;
+    }
+    baseDamaged = damaged;
+    std::atomic_store(&integrity, std::make_shared<const std::vector<TermFileFormat::Report>>(std::move(reports)));
 }
 
 // -------------------------------------------------------------
@@ -92,18 +534,438 @@ void TermManager::Load() {
 /**
  * @brief Зберігає всі терміни у файл.
  *
- * Викликає метод Serialize() для кожного об'єкта та записує результат у файл.
+ * Викликає метод SerializeTo() для кожного об'єкта і атомарно замінює файл
+ * (див. AtomicFile). Виміри запису і fsync доступні через GetLastSave().
  */
 void TermManager::Save() const {
-    std::ofstream out(filePath);
-    if (!out.is_open()) {
-        std::cerr << "[ERROR] Не вдалося зберегти файл термінів." << std::endl;
-        return;
+    std::lock_guard<std::mutex> lock(saveMutex);
+    SaveSnapshot(*Snapshot());
+}
+
+/**
+ * @brief Зберігає знімок, якщо опублікована версія ще не у файлі.
+ *
+ * Запит, що чекав у фоновому потоці, покривається цим записом і знімається.
+ * @return true, якщо база вже збережена або запис вдався.
+ */
+bool TermManager::Flush() {
+    {
+        std::lock_guard<std::mutex> lock(saverMutex);
+        savePending = false;
     }
 
-    for (const auto &t : terms) {
-        out << t->Serialize() << "\n";
+    std::lock_guard<std::mutex> lock(saveMutex);
+    auto snapshot = Snapshot();
+    if (snapshot->GetVersion() == savedVersion) return true;
+    return SaveSnapshot(*snapshot);
+}
+
+/**
+ * @brief Порівнює опубліковану версію зі збереженою.
+ */
+bool TermManager::IsDirty() const {
+    std::lock_guard<std::mutex> lock(saveMutex);
+    return Snapshot()->GetVersion() != savedVersion;
+}
+
+/**
+ * @brief Реєструє зміну для фонового збереження.
+ *
+ * Потік запускається при першому виклику, тож режими без змін
+ * (сервери запитів) його не створюють.
+ */
+void TermManager::ScheduleSave() {
+    {
+        std::lock_guard<std::mutex> lock(saverMutex);
+        auto now = std::chrono::steady_clock::now();
+        if (!savePending) {
+            savePending = true;
+            firstRequest = now;
+        }
+        lastRequest = now;
+        if (!saver.joinable()) saver = std::thread(&TermManager::SaverLoop, this);
+    }
+    saverWake.notify_one();
+}
+
+/**
+ * @brief Фоновий цикл збереження.
+ *
+ * Після першого запиту серії чекає, доки зміни не стихнуть на
+ * kSaveQuietPeriod, але не довше kMaxSaveDelay від першого запиту,
+ * і зберігає одну останню версію замість кожної проміжної.
+ */
+void TermManager::SaverLoop() {
+    std::unique_lock<std::mutex> lock(saverMutex);
+    while (true) {
+        saverWake.wait(lock, [&] { return stopSaver || savePending; });
+        if (stopSaver) return;
+
+        while (!stopSaver && savePending) {
+            auto due = std::min(lastRequest + kSaveQuietPeriod, firstRequest + kMaxSaveDelay);
+            if (std::chrono::steady_clock::now() >= due) break;
+            saverWake.wait_until(lock, due);
+        }
+        if (stopSaver) return;
+        if (!savePending) continue;  // серію вже записав Flush()
+
+        lock.unlock();
+        Flush();
+        lock.lock();
+    }
+}
+
+/**
+ * @brief Записує знімок у файл бази і оновлює savedVersion.
+ *
+ * У каталозі шардів переписуються лише шарди, змінені після savedVersion.
+ * Позначки читаються після отримання знімка, тож зміна, яку знімок уже
+ * містить, не може залишитися непозначеною.
+ */
+bool TermManager::SaveSnapshot(const TermSnapshot &snapshot) const {
+    Metrics::Timer timer(Metrics::Op::Save);
+    if (baseDamaged) {
+        std::cerr << "[ERROR] Не вдалося зберегти файл термінів: файл бази пошкоджено, перезапис скасовано"
+                  << std::endl;
+        return false;
+    }
+    AtomicFile::Stats stats;
+    std::string error;
+    bool ok = shardStore
+              ? WriteShards(snapshot, *shardStore, shardStore->ChangedSince(savedVersion), stats, error)
+              : WriteTo(snapshot, filePath, stats, error);
+    if (!ok) {
+        std::cerr << "[ERROR] Не вдалося зберегти файл термінів: " << error << std::endl;
+        return false;
     }
+    lastSave = stats;
+    savedVersion = snapshot.GetVersion();
+    return true;
+}
+
+/**
+ * @brief Записує поточну версію бази у заданий файл.
+ * @param path Шлях до файлу.
+ * @return true, якщо файл записано.
+ */
+bool TermManager::Export(const std::string &path) const {
+    std::lock_guard<std::mutex> lock(saveMutex);
+    AtomicFile::Stats stats;
+    std::string error;
+    if (!WriteTo(*Snapshot(), path, stats, error)) {
+        std::cerr << "[ERROR] " << error << std::endl;
+        return false;
+    }
+    lastSave = stats;
+    return true;
+}
+
+/**
+ * @brief Записує всі шарди поточної версії в новий каталог.
+ *
+ * Каталог, де вже є маніфест, не перезаписується: там інша база.
+ */
+bool TermManager::ExportShards(const std::string &directory, size_t shards) const {
+    std::lock_guard<std::mutex> lock(saveMutex);
+    std::string error;
+    if (!ShardStore::MakeDirectory(directory, error)) {
+        std::cerr << "[ERROR] " << error << std::endl;
+        return false;
+    }
+
+    ShardStore store(directory, shards);
+    if (store.HasManifest() || !store.Error().empty()) {
+        std::cerr << "[ERROR] У каталозі " << directory << " уже є база шардів." << std::endl;
+        return false;
+    }
+
+    std::vector<size_t> all(store.GetShardCount());
+    for (size_t i = 0; i < all.size(); ++i) all[i] = i;
+
+    AtomicFile::Stats stats;
+    if (!WriteShards(*Snapshot(), store, all, stats, error)) {
+        std::cerr << "[ERROR] " << error << std::endl;
+        return false;
+    }
+    lastSave = stats;
+    return true;
+}
+
+/**
+ * @brief Серіалізує знімок у тимчасовий файл і фіксує його.
+ *
+ * Мала база (або один потік) серіалізується послідовно: терміни
+ * дописуються (SerializeTo) в один блок, який передається файлу після
+ * заповнення й очищається без звільнення пам'яті.
+ *
+ * Велика база пишеться хвилями: неперервні діапазони блоків знімка
+ * серіалізуються паралельно (ScanExecutor), кожен у власний буфер, і буфери
+ * хвилі записуються по порядку одним writev. Вміст файлу такий самий, як
+ * при послідовному записі, а пам'ять обмежена однією хвилею.
+ *
+ * Файл пишеться у форматі TermFileFormat: заголовок, блоки з сумами CRC32C
+ * і підсумок. Суми рахуються тим самим потоком, що серіалізує блок, поки
+ * байти ще в кеші. Блок файлу закривається в кінці кожного блоку знімка
+ * в обох гілках, тож межі блоків не залежать від кількості потоків.
+ */
+bool TermManager::WriteTo(const TermSnapshot &snapshot, const std::string &path,
+                          AtomicFile::Stats &stats, std::string &error) const {
+    constexpr size_t kBlockSize = 64 * 1024;
+    constexpr size_t kMaxChunksPerRange = 16;
+    AtomicFile out(path, ioBackend.load());
+    const auto &chunks = snapshot.GetChunks();
+
+    out.Write(TermFileFormat::Header());
+    if (chunks.size() < ScanExecutor::kMinParallelChunks || scanner->GetThreadCount() == 1) {
+        std::string block;
+        block.reserve(kBlockSize * 2);
+        TermFileFormat::BlockWriter sums;
+        for (const auto &chunk : chunks) {
+            for (const auto &t : *chunk) {
+                size_t from = block.size();
+                t->SerializeTo(block);
+                block.push_back('\n');
+                if (sums.AddLine(block, from) || block.size() >= kBlockSize) {
+                    out.Write(block);
+                    block.clear();
+                }
+            }
+            sums.Seal(block);
+        }
+        block += TermFileFormat::Footer(sums.GetBlocks(), sums.GetLines());
+        out.Write(block);
+    } else {
+        // Кілька діапазонів на потік вирівнюють навантаження; буфери живуть між хвилями
+        const size_t ranges = scanner->GetThreadCount() * 4;
+        const size_t perRange = std::min(kMaxChunksPerRange, (chunks.size() + ranges - 1) / ranges);
+        std::vector<std::string> buffers(ranges);
+        std::vector<TermFileFormat::BlockWriter> sums(ranges);
+        size_t blocks = 0, lines = 0;
+
+        for (size_t first = 0; first < chunks.size() && out.IsOpen(); first += ranges * perRange) {
+            size_t last = std::min(chunks.size(), first + ranges * perRange);
+            size_t count = (last - first + perRange - 1) / perRange;
+
+            scanner->ParallelFor(count, [&](size_t r) {
+                std::string &buffer = buffers[r];
+                buffer.clear();
+                sums[r] = TermFileFormat::BlockWriter();
+                size_t begin = first + r * perRange;
+                size_t end = std::min(last, begin + perRange);
+                for (size_t c = begin; c < end; ++c) {
+                    for (const auto &t : *chunks[c]) {
+                        size_t from = buffer.size();
+                        t->SerializeTo(buffer);
+                        buffer.push_back('\n');
+                        sums[r].AddLine(buffer, from);
+                    }
+                    sums[r].Seal(buffer);
+                }
+            });
+            for (size_t r = 0; r < count; ++r) {
+                blocks += sums[r].GetBlocks();
+                lines += sums[r].GetLines();
+            }
+            out.WriteBuffers(buffers.data(), count);
+        }
+        out.Write(TermFileFormat::Footer(blocks, lines));
+    }
+
+    bool ok = out.Commit();
+    stats = out.GetStats();
+    error = out.Error();
+    return ok;
+}
+
+/**
+ * @brief Записує вибрані шарди знімка і фіксує їх маніфестом.
+ *
+ * Діапазони блоків знімка обходяться паралельно: кожен термін
+ * змінених шардів серіалізується в буфер свого шарду й діапазону, тож порядок
+ * термінів у файлі шарду збігається з порядком бази. Далі файли шардів
+ * записуються і синхронізуються паралельно (кожен — AtomicFile), і лише
+ * після них атомарно замінюється маніфест.
+ *
+ * Кожен файл шарду пишеться у форматі TermFileFormat; блоки шардів
+ * закриваються після кожних TermFileFormat::kShardBlockChunks блоків
+ * знімка, а діапазони вирівнюються на ці межі. Після полів терміна рядок шарду має
+ * п'яте поле — порядковий номер (TermSnapshot::SequenceOf), за яким
+ * LoadShards відновлює порядок бази.
+ *
+ * Виміри: bytes — усі файли разом з маніфестом, writeMs — час до
+ * завершення всіх шардів, fileSyncMs — найдовший fsync шарду,
+ * renameMs — запис і фіксація маніфесту.
+ */
+bool TermManager::WriteShards(const TermSnapshot &snapshot, ShardStore &store, const std::vector<size_t> &changed,
+                              AtomicFile::Stats &stats, std::string &error) const {
+    if (!store.Error().empty()) {
+        error = "маніфест шардів пошкоджено (" + store.Error() + "), запис скасовано";
+        return false;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const IoBackend backend = ioBackend.load();
+    const auto &chunks = snapshot.GetChunks();
+
+    // Позиція шарду в changed; kSkip — шард не переписується
+    constexpr size_t kSkip = static_cast<size_t>(-1);
+    std::vector<size_t> position(store.GetShardCount(), kSkip);
+    for (size_t i = 0; i < changed.size(); ++i) position[changed[i]] = i;
+
+    constexpr size_t kGroup = TermFileFormat::kShardBlockChunks;
+    size_t ranges = std::max<size_t>(1, std::min(chunks.size(), scanner->GetThreadCount() * 4));
+    const size_t perRange = std::max<size_t>(1, ((chunks.size() + ranges - 1) / ranges + kGroup - 1) / kGroup) * kGroup;
+    ranges = std::max<size_t>(1, (chunks.size() + perRange - 1) / perRange);
+    std::vector<std::vector<std::string>> parts(changed.size(), std::vector<std::string>(ranges));
+    // Суми блоків для кожного буфера parts[i][r] (див. TermFileFormat)
+    std::vector<std::vector<TermFileFormat::BlockWriter>> sums(ranges,
+                                                               std::vector<TermFileFormat::BlockWriter>(changed.size()));
+
+    if (!changed.empty()) {
+        scanner->ParallelFor(ranges, [&](size_t r) {
+            size_t end = std::min(chunks.size(), (r + 1) * perRange);
+            for (size_t c = r * perRange; c < end; ++c) {
+                for (const auto &t : *chunks[c]) {
+                    size_t i = position[store.ShardOf(Utils::FoldUTF8(t->GetName()))];
+                    if (i == kSkip) continue;
+                    size_t from = parts[i][r].size();
+                    t->SerializeTo(parts[i][r]);
+                    AppendSequence(parts[i][r], snapshot.SequenceOf(t.get()));
+                    parts[i][r].push_back('\n');
+                    sums[r][i].AddLine(parts[i][r], from);
+                }
+                if ((c + 1) % kGroup == 0 || c + 1 == end) {
+                    for (size_t i = 0; i < changed.size(); ++i) sums[r][i].Seal(parts[i][r]);
+                }
+            }
+        });
+    }
+
+    std::vector<size_t> termCounts(changed.size());
+    std::vector<size_t> blockCounts(changed.size());
+    for (size_t r = 0; r < ranges; ++r) {
+        for (size_t i = 0; i < changed.size(); ++i) {
+            termCounts[i] += sums[r][i].GetLines();
+            blockCounts[i] += sums[r][i].GetBlocks();
+        }
+    }
+
+    std::vector<AtomicFile::Stats> written(changed.size());
+    std::vector<std::string> errors(changed.size());
+    scanner->ParallelFor(changed.size(), [&](size_t i) {
+        AtomicFile out(store.NextPath(changed[i]), backend);
+        out.Write(TermFileFormat::Header());
+        out.WriteBuffers(parts[i].data(), parts[i].size());
+        out.Write(TermFileFormat::Footer(blockCounts[i], termCounts[i]));
+        if (!out.Commit()) errors[i] = out.Error();
+        written[i] = out.GetStats();
+        std::vector<std::string>().swap(parts[i]);
+    });
+
+    stats = AtomicFile::Stats();
+    stats.files = changed.size() + 1;
+    for (size_t i = 0; i < changed.size(); ++i) {
+        if (!errors[i].empty()) {
+            error = errors[i];
+            return false;
+        }
+        stats.bytes += written[i].bytes;
+        stats.fileSyncMs = std::max(stats.fileSyncMs, written[i].fileSyncMs);
+    }
+    const auto shardsDone = std::chrono::steady_clock::now();
+    stats.writeMs = std::chrono::duration<double, std::milli>(shardsDone - start).count();
+
+    AtomicFile::Stats manifest;
+    if (!store.Commit(changed, termCounts, backend, manifest, error)) return false;
+    stats.bytes += manifest.bytes;
+    stats.renameMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - shardsDone).count();
+    return true;
+}
+
+/**
+ * @brief Повертає виміри останнього збереження.
+ */
+AtomicFile::Stats TermManager::GetLastSave() const {
+    std::lock_guard<std::mutex> lock(saveMutex);
+    return lastSave;
+}
+
+/**
+ * @brief Запам'ятовує спосіб вводу-виводу; його підхоплять наступні операції з файлом.
+ */
+void TermManager::SetIoBackend(IoBackend backend) {
+    ioBackend.store(backend);
+}
+
+/**
+ * @brief Повертає обраний спосіб вводу-виводу.
+ */
+IoBackend TermManager::GetIoBackend() const {
+    return ioBackend.load();
+}
+
+/**
+ * @brief Запам'ятовує, чи стискати визначення при наступних Load.
+ */
+void TermManager::SetCompressedDefinitions(bool enabled) {
+    compressedDefinitions.store(enabled);
+}
+
+/**
+ * @brief Повертає режим стиснення визначень.
+ */
+bool TermManager::GetCompressedDefinitions() const {
+    return compressedDefinitions.load();
+}
+
+/**
+ * @brief Повертає підсумок стиснення останнього Load.
+ */
+DefinitionCodec::Stats TermManager::GetCompressionStats() const {
+    auto stats = std::atomic_load(&compression);
+    return stats ? *stats : DefinitionCodec::Stats();
+}
+
+/**
+ * @brief Запам'ятовує режим читання визначень для наступних Load.
+ */
+void TermManager::SetLazyDefinitions(bool enabled) {
+    lazyDefinitions.store(enabled);
+}
+
+/**
+ * @brief Повертає режим читання визначень.
+ */
+bool TermManager::GetLazyDefinitions() const {
+    return lazyDefinitions.load();
+}
+
+/**
+ * @brief Повертає звіти перевірки файлів останнього Load.
+ */
+std::vector<TermFileFormat::Report> TermManager::GetLoadReports() const {
+    auto reports = std::atomic_load(&integrity);
+    return reports ? *reports : std::vector<TermFileFormat::Report>();
+}
+
+/**
+ * @brief Передає бюджет кешу визначень; зайве витісняється одразу.
+ */
+void TermManager::SetMemoryBudget(size_t bytes) {
+    definitionCache->SetBudget(bytes);
+}
+
+/**
+ * @brief Повертає бюджет кешу визначень.
+ */
+size_t TermManager::GetMemoryBudget() const {
+    return definitionCache->GetBudget();
+}
+
+/**
+ * @brief Повертає стан кешу визначень.
+ */
+DefinitionCache::Stats TermManager::GetDefinitionCacheStats() const {
+    return definitionCache->GetStats();
 }
 
 // -------------------------------------------------------------
@@ -115,15 +977,70 @@ void TermManager::Save() const {
  * @param name Назва шуканого терміна.
  * @return Розумний вказівник на термін або nullptr, якщо не знайдено.
  */
-std::shared_ptr<TermBase> TermManager::FindByName(const std::string &name) const {
-    std::string target = Utils::ToLowerUTF8(name);
+std::shared_ptr<const TermBase> TermManager::FindByName(const std::string &name) const {
+    Metrics::Timer timer(Metrics::Op::FindByName);
+    auto snapshot = Snapshot();
+    auto term = snapshot->FindByName(Utils::FoldUTF8(name));
+    if (!term || !pinReads.load(std::memory_order_acquire)) return term;
+    return TermSnapshot::TermPtr(snapshot, term.get());
+}
 
-    for (const auto &t : terms) {
-       if (Utils::ToLowerUTF8(t->GetName()) == target) {
-            return t;
-        }
+/**
+ * @brief Повертає до limit назв, що починаються з prefix.
+ *
+ * Назви беруться з відсортованого індексу знімка і повертаються у тому
+ * написанні, з яким їх було додано.
+ * @param prefix Початок назви.
+ * @param limit Максимальна кількість підказок.
+ * @return Назви в алфавітному порядку.
+ */
+std::vector<std::string> TermManager::CompleteName(const std::string &prefix, size_t limit) const {
+    auto snapshot = Snapshot();
+    std::vector<std::string> names;
+    for (const auto &folded : snapshot->CompleteName(Utils::FoldUTF8(prefix), limit)) {
+        if (auto term = snapshot->FindByName(folded)) names.push_back(term->GetName());
     }
-    return nullptr;
+    return names;
+}
+
+/**
+ * @brief Нечіткий пошук назв для підказок.
+ *
+ * Кандидати беруться з BK-дерева знімка, тож відстань рахується лише для
+ * малої частини назв. Популярність — кількість термінів, що посилаються
+ * на назву (зворотний індекс). Рівні за обома ознаками йдуть за алфавітом.
+ * @param name Назва, яку не вдалося знайти.
+ * @param limit Максимальна кількість підказок.
+ * @return Назви у написанні, з яким їх було додано.
+ */
+std::vector<std::string> TermManager::SuggestNames(const std::string &name, size_t limit) const {
+    auto snapshot = Snapshot();
+    std::string folded = Utils::FoldUTF8(name);
+    uint32_t maxDistance = Utils::DecodeUTF8(folded).size() <= 4 ? 1 : 2;
+
+    struct Candidate {
+        std::string folded;
+        uint32_t distance;
+        size_t popularity;
+    };
+    std::vector<Candidate> candidates;
+    for (auto &match : snapshot->FindSimilarNames(folded, maxDistance)) {
+        const auto *referrers = snapshot->FindReferrers(match.word);
+        candidates.push_back({std::move(match.word), match.distance, referrers ? referrers->size() : 0});
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b) {
+        if (a.distance != b.distance) return a.distance < b.distance;
+        if (a.popularity != b.popularity) return a.popularity > b.popularity;
+        return a.folded < b.folded;
+    });
+
+    std::vector<std::string> names;
+    for (const auto &c : candidates) {
+        if (names.size() == limit) break;
+        if (auto term = snapshot->FindByName(c.folded)) names.push_back(term->GetName());
+    }
+    return names;
 }
 
 // -------------------------------------------------------------
@@ -136,7 +1053,11 @@ std::shared_ptr<TermBase> TermManager::FindByName(const std::string &name) const
  * @note Для збереження на диску потрібно викликати Save().
  */
 void TermManager::AddTerm(const std::shared_ptr<TermBase> &term) {
-    terms.push_back(term);
+    std::lock_guard<std::mutex> lock(writeMutex);
+    auto next = BeginWrite();
+    next->Append(term);
+    Touch(term->GetName());
+    Publish(next);
 }
 
 // -------------------------------------------------------------
@@ -151,22 +1072,8 @@ void TermManager::AddTerm(const std::shared_ptr<TermBase> &term) {
  * @return true, якщо термін згадується у посиланнях інших термінів.
  */
 bool TermManager::IsReferenced(const std::string &name) const {
-    std::string target = Utils::ToLowerUTF8(name);
-
-    for (const auto &t : terms) {
-        // Первинні терміни не мають посилань, пропускаємо їх
-        if (!t->IsPrimitive()) {
-            auto termPtr = std::dynamic_pointer_cast<Term>(t);
-            if (!termPtr) continue;
-
-            for (const auto &ref : termPtr->GetReferences()) {
-                if (Utils::ToLowerUTF8(ref) == target) {
-                    return true;
-                }
-            }
-        }
-    }
-    return false;
+    // Зворотний індекс знімка зберігає, хто на кого посилається
+    return Snapshot()->IsReferenced(Utils::FoldUTF8(name));
 }
 
 // -------------------------------------------------------------
@@ -181,24 +1088,22 @@ bool TermManager::IsReferenced(const std::string &name) const {
  * @return true, якщо видалення успішне, false — якщо не знайдено або заборонено.
  */
 bool TermManager::RemoveTerm(const std::string &name) {
-    if (IsReferenced(name)) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    std::string target = Utils::FoldUTF8(name);
+
+    // Перевірка і видалення виконуються над однією версією бази
+    auto next = BeginWrite();
+    if (next->IsReferenced(target)) {
         std::cout << "[ПОМИЛКА] Неможливо видалити термін \"" << name
                   << "\", оскільки інші терміни містять на нього посилання." << std::endl;
         return false;
     }
 
-    std::string target = Utils::ToLowerUTF8(name);
-
-    auto it = std::remove_if(
-        terms.begin(),
-        terms.end(),
-        [&](const std::shared_ptr<TermBase> &t) {
-            return Utils::ToLowerUTF8(t->GetName()) == target;
-        }
-    );
-
-    bool removed = it != terms.end();
-    terms.erase(it, terms.end());
+    bool removed = next->RemoveByName(target) > 0;
+    if (removed) {
+        Touch(target);
+        Publish(next);
+    }
     return removed;
 }
 
@@ -213,10 +1118,17 @@ bool TermManager::RemoveTerm(const std::string &name) {
  * @return true, якщо успішно оновлено.
  */
 bool TermManager::EditDefinition(const std::string &name, const std::string &newDefinition) {
-    auto term = FindByName(name);
+    std::lock_guard<std::mutex> lock(writeMutex);
+    auto next = BeginWrite();
+    auto term = next->FindByName(Utils::FoldUTF8(name));
     if (!term) return false;
 
-    term->SetDefinition(newDefinition);
+    // Опублікований термін незмінний: редагуємо копію і підміняємо її у новій версії
+    auto edited = term->Clone();
+    edited->SetDefinition(newDefinition);
+    next->Replace(term, edited);
+    Touch(name);
+    Publish(next);
     return true;
 }
 
@@ -228,26 +1140,42 @@ bool TermManager::EditDefinition(const std::string &name, const std::string &new
  * @brief Сортує терміни за назвою в алфавітному порядку.
  */
 void TermManager::SortByName() {
+    Metrics::Timer timer(Metrics::Op::SortByName);
+    std::lock_guard<std::mutex> lock(writeMutex);
+    auto next = BeginWrite();
+    auto terms = next->ToVector();
     std::sort(terms.begin(), terms.end(),
-              [](const std::shared_ptr<TermBase> &a,
-                 const std::shared_ptr<TermBase> &b)
+              [](const TermSnapshot::TermPtr &a,
+                 const TermSnapshot::TermPtr &b)
               {
-                  return Utils::ToLowerUTF8(a->GetName()) <
-                         Utils::ToLowerUTF8(b->GetName());
+                  return Utils::FoldUTF8(a->GetName()) <
+                         Utils::FoldUTF8(b->GetName());
               });
+    PublishReordered(next, terms);
 }
 
 /**
  * @brief Сортує терміни за текстом визначення.
  */
 void TermManager::SortByDefinition() {
-    std::sort(terms.begin(), terms.end(),
-              [](const std::shared_ptr<TermBase> &a,
-                 const std::shared_ptr<TermBase> &b)
-              {
-                  return Utils::ToLowerUTF8(a->GetDefinition()) <
-                         Utils::ToLowerUTF8(b->GetDefinition());
-              });
+    Metrics::Timer timer(Metrics::Op::SortByDefinition);
+    std::lock_guard<std::mutex> lock(writeMutex);
+    auto next = BeginWrite();
+    auto terms = next->ToVector();
+
+    // Відкладене чи стиснене визначення читається і зводиться один раз на
+    // термін, а не двічі на кожне порівняння; сортуються пари (ключ, номер)
+    std::vector<std::pair<std::string, size_t>> keys(terms.size());
+    for (size_t i = 0; i < terms.size(); ++i) {
+        keys[i].second = i;
+        terms[i]->ReadDefinition([&](const std::string &d) { Utils::FoldTo(keys[i].first, d); });
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<TermSnapshot::TermPtr> ordered;
+    ordered.reserve(terms.size());
+    for (const auto &key : keys) ordered.push_back(std::move(terms[key.second]));
+    PublishReordered(next, ordered);
 }
 
 
@@ -259,17 +1187,18 @@ void TermManager::SortByDefinition() {
  * @brief Виводить короткий список термінів (тільки назви).
  */
 void TermManager::PrintAllShort() const {
-    if (terms.empty()) {
+    auto snapshot = Snapshot();
+    if (snapshot->Empty()) {
         std::cout << "База термінів порожня." << std::endl;
         return;
     }
 
     std::cout << "=== Список термінів ===" << std::endl;
-    for (const auto &t : terms) {
+    snapshot->ForEach([](const TermSnapshot::TermPtr &t) {
         std::cout << "- " << t->GetName();
         if (t->IsPrimitive()) std::cout << " [первинний]";
         std::cout << std::endl;
-    }
+    });
 }
 
 // -------------------------------------------------------------
@@ -280,20 +1209,24 @@ void TermManager::PrintAllShort() const {
  * @brief Виводить повну інформацію про всі терміни.
  */
 void TermManager::PrintAllFull() const {
-    if (terms.empty()) {
+    // Весь вивід іде з однієї версії, навіть якщо паралельно виконуються записи
+    auto snapshot = Snapshot();
+    if (snapshot->Empty()) {
         std::cout << "База термінів порожня." << std::endl;
         return;
     }
 
     std::cout << "=== Повний список термінів ===\n";
 
-    for (const auto &basePtr : terms) {
+    snapshot->ForEach([](const TermSnapshot::TermPtr &basePtr) {
         std::cout << "Термін: " << basePtr->GetName() << std::endl;
-        std::cout << "Визначення: " << basePtr->GetDefinition() << std::endl;
+        basePtr->ReadDefinition([](const std::string &definition) {
+            std::cout << "Визначення: " << definition << std::endl;
+        });
 
         if (!basePtr->IsPrimitive()) {
             // Безпечне приведення типу для доступу до посилань
-            auto termPtr = std::dynamic_pointer_cast<Term>(basePtr);
+            auto termPtr = std::dynamic_pointer_cast<const Term>(basePtr);
             std::cout << "Посилання: ";
             
             if (termPtr) {
@@ -311,7 +1244,23 @@ void TermManager::PrintAllFull() const {
         }
 
         std::cout << "\n-----------------------------\n";
-    }
+    });
+}
+
+// -------------------------------------------------------------
+//                   PARALLEL SCAN
+// -------------------------------------------------------------
+
+/**
+ * @brief Відбирає терміни з поточної версії бази на пулі потоків.
+ * @param predicate Умова відбору.
+ * @return Знайдені терміни у порядку бази.
+ */
+std::vector<TermSnapshot::TermPtr> TermManager::Scan(const ScanExecutor::Predicate &predicate) const {
+    auto snapshot = Snapshot();
+    auto found = scanner->Filter(*snapshot, predicate);
+    PinTerms(snapshot, found);
+    return found;
 }
 
 // -------------------------------------------------------------
@@ -328,23 +1277,84 @@ void TermManager::SearchByDefinition(const std::string &substring) const {
         return;
     }
 
-    std::string needle = Utils::ToLowerUTF8(substring);
-    bool found = false;
+    auto found = SearchDefinitions(substring);
 
     std::cout << "Результати пошуку:\n";
 
-    for (const auto &t : terms) {
-        if (Utils::ToLowerUTF8(t->GetDefinition()).find(needle) != std::string::npos) {
-            std::cout << "- " << t->GetName() << ": " << t->GetDefinition() << std::endl;
-            found = true;
-        }
+    for (const auto &t : found) {
+        std::cout << "- " << t->GetName() << ": " << t->GetDefinition() << std::endl;
     }
 
-    if (!found) {
+    if (found.empty()) {
         std::cout << "Нічого не знайдено.\n";
     }
 }
 
+/**
+ * @brief Відбирає терміни, визначення яких містить фрагмент.
+ * @param substring Фрагмент тексту.
+ * @return Знайдені терміни.
+ */
+std::vector<TermSnapshot::TermPtr> TermManager::SearchDefinitions(const std::string &substring) const {
+    Metrics::Timer timer(Metrics::Op::SearchByDefinition);
+    if (substring.empty()) return {};
+
+    // Фрагмент приводиться до нижнього регістру один раз, визначення — ні
+    std::string needle = Utils::FoldUTF8(substring);
+    return Scan([&needle](const TermBase &t) {
+        return t.DefinitionContains(needle);
+    });
+}
+
+// -------------------------------------------------------------
+//                   QUERY LANGUAGE
+// -------------------------------------------------------------
+
+/**
+ * @brief Розбирає і виконує запит на поточній версії бази.
+ * @param text Запит.
+ * @param results Знайдені терміни.
+ * @param error Опис помилки розбору.
+ * @param plan План виконання або nullptr.
+ * @return false при синтаксичній помилці.
+ */
+bool TermManager::Query(const std::string &text, std::vector<TermSnapshot::TermPtr> &results,
+                        std::string &error, std::string *plan) const {
+    TermQuery query;
+    if (!query.Parse(text, error)) return false;
+
+    auto snapshot = Snapshot();
+    results = query.Execute(*snapshot, *scanner, plan);
+    PinTerms(snapshot, results);
+    return true;
+}
+
+/**
+ * @brief Виконує запит і друкує результати (та план для "explain ...").
+ * @param text Текст запиту.
+ */
+void TermManager::PrintQuery(const std::string &text) const {
+    std::string body = Utils::Trim(text);
+    bool explain = Utils::ToLower(body.substr(0, 8)) == "explain ";
+    if (explain) body = body.substr(8);
+
+    std::vector<TermSnapshot::TermPtr> found;
+    std::string error;
+    std::string plan;
+    if (!Query(body, found, error, explain ? &plan : nullptr)) {
+        std::cout << "Помилка в запиті: " << error << std::endl;
+        return;
+    }
+
+    if (explain) std::cout << plan << std::endl;
+
+    std::cout << "Результати запиту (" << found.size() << "):\n";
+    for (const auto &t : found) {
+        std::cout << "- [" << t->GetType() << "] " << t->GetName() << ": " << t->GetDefinition() << std::endl;
+    }
+    if (found.empty()) std::cout << "Нічого не знайдено.\n";
+}
+
 // -------------------------------------------------------------
 //                   FILTER BY TYPE
 // -------------------------------------------------------------
@@ -354,16 +1364,15 @@ void TermManager::SearchByDefinition(const std::string &substring) const {
  * @param primitiveOnly Якщо true - виводить тільки первинні, інакше - тільки складні.
  */
 void TermManager::PrintFilteredByPrimitive(bool primitiveOnly) const {
-    bool any = false;
+    auto matches = Scan([primitiveOnly](const TermBase &t) {
+        return t.IsPrimitive() == primitiveOnly;
+    });
 
-    for (const auto &t : terms) {
-        if (t->IsPrimitive() == primitiveOnly) {
-            std::cout << "- " << t->GetName() << ": " << t->GetDefinition() << std::endl;
-            any = true;
-        }
+    for (const auto &t : matches) {
+        std::cout << "- " << t->GetName() << ": " << t->GetDefinition() << std::endl;
     }
 
-    if (!any) std::cout << "Нічого не знайдено.\n";
+    if (matches.empty()) std::cout << "Нічого не знайдено.\n";
 }
 
 // -------------------------------------------------------------
@@ -371,55 +1380,59 @@ void TermManager::PrintFilteredByPrimitive(bool primitiveOnly) const {
 // -------------------------------------------------------------
 
 /**
- * @brief Рекурсивно виводить ланцюжок залежностей терміна.
+ * @brief Рекурсивно збирає ланцюжок залежностей терміна.
  * * Це ключова функція для індивідуального завдання. Вона будує дерево
  * понять від складного до простих.
  *
+ * @param snapshot Версія бази, з якою працює весь обхід.
  * @param name Назва поточного терміна.
  * @param visited Множина відвіданих термінів (для захисту від циклічних посилань).
- * @param level Рівень вкладеності (для відступів).
+ * @param level Рівень вкладеності.
+ * @param out Зібрані кроки.
  */
-void TermManager::PrintChainRecursive(const std::string &name,
-                                      std::unordered_set<std::string> &visited,
-                                      int level) const {
-
-    // Форматування відступу залежно від рівня рекурсії
-    for (int i = 0; i < level; i++) std::cout << "  ";
-    std::cout << "-> " << name << std::endl;
+void TermManager::CollectChainRecursive(const TermSnapshot &snapshot,
+                                        const std::string &name,
+                                        std::unordered_set<std::string> &visited,
+                                        int level,
+                                        std::vector<ChainStep> &out) const {
+    ChainStep step;
+    step.level = level;
+    step.name = name;
 
-    std::string key = Utils::ToLowerUTF8(name);
+    std::string key = Utils::FoldUTF8(name);
 
     // Захист від нескінченної рекурсії (циклів)
     if (visited.count(key)) {
-        for (int i = 0; i < level; i++) std::cout << "  ";
-        std::cout << "[ЦИКЛ У ПОСИЛАННЯХ]\n";
+        step.kind = ChainStep::Kind::Cycle;
+        out.push_back(std::move(step));
         return;
     }
 
     visited.insert(key);
 
-    auto ptr = FindByName(name);
+    auto ptr = snapshot.FindByName(key);
     if (!ptr) {
-        for (int i = 0; i < level + 1; i++) std::cout << "  ";
-        std::cout << "[!] Термін не знайдено в базі.\n";
+        step.kind = ChainStep::Kind::Missing;
+        out.push_back(std::move(step));
         return;
     }
 
     // Базовий випадок рекурсії: первинне поняття
     if (ptr->IsPrimitive()) {
-        for (int i = 0; i < level + 1; i++) std::cout << "  ";
-        std::cout << "(первинне поняття)\n";
+        step.kind = ChainStep::Kind::Primitive;
+        out.push_back(std::move(step));
         return;
     }
 
     // Рекурсивний випадок: складний термін
-    auto t = std::dynamic_pointer_cast<Term>(ptr);
-    
+    out.push_back(std::move(step));
+    auto t = std::dynamic_pointer_cast<const Term>(ptr);
+
     // Додана перевірка безпеки
-    if (!t) return; 
+    if (!t) return;
 
     for (const auto &r : t->GetReferences()) {
-        PrintChainRecursive(r, visited, level + 1);
+        CollectChainRecursive(snapshot, r, visited, level + 1, out);
     }
 }
 
@@ -428,19 +1441,60 @@ void TermManager::PrintChainRecursive(const std::string &name,
 // -------------------------------------------------------------
 
 /**
- * @brief Публічна обгортка для запуску побудови ланцюжка.
+ * @brief Збирає ланцюжок з однієї версії бази.
+ * @param name Назва початкового терміна.
+ * @return Кроки обходу або порожній вектор.
+ */
+std::vector<ChainStep> TermManager::CollectChain(const std::string &name) const {
+    Metrics::Timer timer(Metrics::Op::Chain);
+    std::vector<ChainStep> steps;
+    auto snapshot = Snapshot();
+    if (!snapshot->FindByName(Utils::FoldUTF8(name))) return steps;
+
+    std::unordered_set<std::string> visited;
+    CollectChainRecursive(*snapshot, name, visited, 0, steps);
+    return steps;
+}
+
+/**
+ * @brief Публічна обгортка для побудови і виводу ланцюжка.
  * @param name Назва початкового терміна.
  */
 void TermManager::PrintChainFrom(const std::string &name) const {
-    if (!FindByName(name)) {
+    auto steps = CollectChain(name);
+    if (steps.empty()) {
         std::cout << "Термін \"" << name << "\" не знайдено.\n";
         return;
     }
 
-    std::unordered_set<std::string> visited;
-
     std::cout << "\n=== Ланцюжок терміна \"" << name << "\" ===\n";
-    PrintChainRecursive(name, visited, 0);
+
+    auto indent = [](int level) {
+        for (int i = 0; i < level; i++) std::cout << "  ";
+    };
+
+    for (const auto &step : steps) {
+        // Форматування відступу залежно від рівня рекурсії
+        indent(step.level);
+        std::cout << "-> " << step.name << std::endl;
+
+        switch (step.kind) {
+            case ChainStep::Kind::Cycle:
+                indent(step.level);
+                std::cout << "[ЦИКЛ У ПОСИЛАННЯХ]\n";
+                break;
+            case ChainStep::Kind::Missing:
+                indent(step.level + 1);
+                std::cout << "[!] Термін не знайдено в базі.\n";
+                break;
+            case ChainStep::Kind::Primitive:
+                indent(step.level + 1);
+                std::cout << "(первинне поняття)\n";
+                break;
+            case ChainStep::Kind::Composite:
+                break;
+        }
+    }
 }
 
 // -------------------------------------------------------------
@@ -451,26 +1505,33 @@ void TermManager::PrintChainFrom(const std::string &name) const {
  * @brief Заповнює базу тестовими даними, якщо вона порожня.
  */
 void TermManager::EnsureDefaultTerms() {
-    if (!terms.empty()) return;
-
-    std::cout << "[INFO] База порожня — створюються стандартні терміни." << std::endl;
-
-    terms.push_back(std::make_shared<PrimitiveTerm>("Клас", "Основне поняття ООП."));
-    terms.push_back(std::make_shared<PrimitiveTerm>("Об’єкт", "Екземпляр класу."));
-    terms.push_back(std::make_shared<PrimitiveTerm>("Метод", "Опис поведінки."));
-    terms.push_back(std::make_shared<PrimitiveTerm>("Алгоритм", "Послідовність дій."));
-
-    terms.push_back(std::make_shared<Term>(
-            "Компіляція",
-            "Процес перетворення коду.",
-            std::vector<std::string>{"Алгоритм"}
-    ));
-
-    terms.push_back(std::make_shared<Term>(
-            "Інкапсуляція",
-            "Приховування реалізації.",
-            std::vector<std::string>{"Клас", "Об’єкт"}
-    ));
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        auto next = BeginWrite();
+        if (!next->Empty()) return;
+
+        std::cout << "[INFO] База порожня — створюються стандартні терміни." << std::endl;
+
+        next->Append(std::make_shared<PrimitiveTerm>("Клас", "Основне поняття ООП."));
+        next->Append(std::make_shared<PrimitiveTerm>("Об’єкт", "Екземпляр класу."));
+        next->Append(std::make_shared<PrimitiveTerm>("Метод", "Опис поведінки."));
+        next->Append(std::make_shared<PrimitiveTerm>("Алгоритм", "Послідовність дій."));
+
+        next->Append(std::make_shared<Term>(
+                "Компіляція",
+                "Процес перетворення коду.",
+                std::vector<std::string>{"Алгоритм"}
+        ));
+
+        next->Append(std::make_shared<Term>(
+                "Інкапсуляція",
+                "Приховування реалізації.",
+                std::vector<std::string>{"Клас", "Об’єкт"}
+        ));
+
+        next->ForEach([&](const TermSnapshot::TermPtr &t) { Touch(t->GetName()); });
+        Publish(next);
+    }
 
     Save();
 }
@@ -483,17 +1544,55 @@ void TermManager::EnsureDefaultTerms() {
  * @brief Виводить загальну статистику по базі даних.
  */
 void TermManager::PrintStats() const {
-    int total = terms.size();
-    int prim = 0;
-    int comp = 0;
+    TermStats stats = GetStats();
+
+    std::cout << "\n===== Статистика бази =====\n";
+    std::cout << "Загальна кількість: " << stats.total << std::endl;
+    std::cout << "Первинних:          " << stats.primitive << std::endl;
+    std::cout << "Складних:           " << stats.composite << std::endl;
 
-    for (const auto &t : terms) {
-        if (t->IsPrimitive()) prim++;
-        else comp++;
+    AtomicFile::Stats save = GetLastSave();
+    if (save.bytes > 0) {
+        std::cout << "Останнє збереження: " << save.Describe() << std::endl;
     }
 
-    std::cout << "\n===== Статистика бази =====\n";
-    std::cout << "Загальна кількість: " << total << std::endl;
-    std::cout << "Первинних:          " << prim << std::endl;
-    std::cout << "Складних:           " << comp << std::endl;
-}
\ No newline at end of file
+    DefinitionCodec::Stats codec = GetCompressionStats();
+    if (codec.terms > 0) {
+        std::cout << "Стиснення визначень: " << codec.Describe() << std::endl;
+    }
+
+    std::vector<TermFileFormat::Report> reports = GetLoadReports();
+    if (!reports.empty()) {
+        size_t blocks = 0, damaged = 0, skipped = 0, unchecked = 0;
+        for (const auto &report : reports) {
+            blocks += report.blocks;
+            damaged += report.problems.size();
+            skipped += report.skippedLines.size();
+            if (report.version < 2) unchecked++;
+        }
+        std::cout << "Перевірка файлів:   файлів " << reports.size() << ", блоків " << blocks << " (CRC32C, "
+                  << Simd::ActiveCrcIsa() << "), пошкоджень " << damaged << ", пропущено рядків " << skipped;
+        if (unchecked > 0) std::cout << ", без сум (версія 1) " << unchecked;
+        std::cout << std::endl;
+    }
+
+    if (pinReads.load()) {
+        std::cout << "Визначення в пам'яті: " << GetDefinitionCacheStats().Describe() << std::endl;
+    }
+}
+
+/**
+ * @brief Рахує терміни за типами в одній версії бази.
+ * @return Статистика.
+ */
+TermStats TermManager::GetStats() const {
+    auto snapshot = Snapshot();
+    TermStats stats;
+    stats.total = snapshot->Size();
+
+    snapshot->ForEach([&](const TermSnapshot::TermPtr &t) {
+        if (t->IsPrimitive()) stats.primitive++;
+        else stats.composite++;
+    });
+    return stats;
+}
@@ -10,7 +10,52 @@
 #include <memory>
 #include <string>
 #include <unordered_set>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
 #include "TermBase.h"
+#include "TermSnapshot.h"
+#include "ScanExecutor.h"
+#include "AtomicFile.h"
+#include "ShardStore.h"
+#include "DefinitionCache.h"
+#include "DefinitionCodec.h"
+#include "TermFileFormat.h"
+
+/**
+ * @struct ChainStep
+ * @brief Один крок ланцюжка залежностей (для виводу без форматування).
+ */
+struct ChainStep {
+    /**
+     * @brief Що знайдено на цьому кроці.
+     */
+    enum class Kind {
+        Composite,  ///< Складний термін, далі йдуть його посилання.
+        Primitive,  ///< Первинне поняття (лист дерева).
+        Missing,    ///< Посилання на відсутній термін.
+        Cycle       ///< Повторний візит — цикл у посиланнях.
+    };
+
+    /** @brief Рівень вкладеності (0 — початковий термін). */
+    int level = 0;
+    /** @brief Назва терміна, як вона записана у посиланні. */
+    std::string name;
+    /** @brief Тип кроку. */
+    Kind kind = Kind::Composite;
+};
+
+/**
+ * @struct TermStats
+ * @brief Кількість термінів різних типів.
+ */
+struct TermStats {
+    size_t total = 0;
+    size_t primitive = 0;
+    size_t composite = 0;
+};
 
 /**
  * @class TermManager
@@ -22,16 +67,49 @@
  * - Виконання операцій CRUD (Create, Read, Update, Delete).
  * - Пошук, сортування та фільтрацію.
  * - Побудову ланцюжків залежностей термінів (ключовий функціонал).
+ *
+ * Дані зберігаються у вигляді незмінних знімків (TermSnapshot). Читачі атомарно
+ * беруть поточний знімок і працюють з ним без блокувань, тому довге читання
+ * (наприклад, PrintAllFull) не заважає записам і ніколи не бачить половину зміни.
+ * Письменники по черзі (під writeMutex) будують нову версію і атомарно її публікують.
  */
 class TermManager {
 private:
     /**
-     * @brief Основний контейнер для зберігання термінів.
+     * @brief Облік і витіснення відкладених визначень (див. SetMemoryBudget).
      *
-     * Використовується поліморфізм: зберігаються вказівники на базовий клас TermBase,
+     * Оголошений перед current: терміни знімка звертаються до кешу у
+     * своїх деструкторах, тому кеш має пережити знімки.
+     */
+    std::unique_ptr<DefinitionCache> definitionCache;
+
+    /**
+     * @brief Знімки видаються разом із закріпленим кладовищем кешу.
+     *
+     * Вмикається, коли база завантажена з відкладеними або стисненими
+     * визначеннями: лише тоді визначення можуть бути витіснені під час читання.
+     */
+    std::atomic<bool> pinReads{false};
+
+    /**
+     * @brief Поточна опублікована версія бази термінів.
+     *
+     * Використовується поліморфізм: знімок зберігає вказівники на базовий клас TermBase,
      * що дозволяє тримати в одному списку і PrimitiveTerm, і Term.
+     * Доступ лише через std::atomic_load / std::atomic_store.
      */
-    std::vector<std::shared_ptr<TermBase>> terms;
+    std::shared_ptr<const TermSnapshot> current;
+
+    /**
+     * @brief М'ютекс, що впорядковує письменників між собою.
+     * Читачі його не беруть.
+     */
+    std::mutex writeMutex;
+
+    /**
+     * @brief Пул потоків для повного перегляду бази (пошук у визначеннях, фільтри).
+     */
+    std::unique_ptr<ScanExecutor> scanner;
 
     /**
      * @brief Шлях до файлу бази даних (CSV).
@@ -39,25 +117,248 @@ private:
     std::string filePath;
 
     /**
-     * @brief Рекурсивний метод для виведення ланцюжка залежностей.
+     * @brief Спосіб файлового вводу-виводу для Load і збережень.
+     */
+    std::atomic<IoBackend> ioBackend{IoBackend::Posix};
+
+    /**
+     * @brief Чи читати визначення відкладено (див. SetLazyDefinitions).
+     */
+    std::atomic<bool> lazyDefinitions{false};
+
+    /**
+     * @brief Чи стискати визначення при завантаженні (див. SetCompressedDefinitions).
+     */
+    std::atomic<bool> compressedDefinitions{false};
+
+    /**
+     * @brief Підсумок стиснення останнього Load (nullptr — не стискалося).
+     *
+     * Доступ лише через std::atomic_load / std::atomic_store.
+     */
+    std::shared_ptr<const DefinitionCodec::Stats> compression;
+
+    /**
+     * @brief Звіти перевірки файлів останнього Load (по одному на файл).
+     *
+     * Доступ лише через std::atomic_load / std::atomic_store.
+     */
+    std::shared_ptr<const std::vector<TermFileFormat::Report>> integrity;
+
+    /**
+     * @brief Останній Load знайшов пошкодження; SaveSnapshot не перезаписує базу (під saveMutex).
+     */
+    bool baseDamaged = false;
+
+    /**
+     * @brief Сховище з шардів, якщо filePath — каталог (інакше nullptr).
+     */
+    std::unique_ptr<ShardStore> shardStore;
+
+    /**
+     * @brief Назви термінів, змінених у версії, що готується (під writeMutex).
+     *
+     * Publish позначає їхні шарди зміненими.
+     */
+    std::vector<std::string> touched;
+
+    /**
+     * @brief Впорядковує збереження між собою (тимчасовий файл у них спільний).
+     */
+    mutable std::mutex saveMutex;
+
+    /**
+     * @brief Виміри останнього успішного збереження (під saveMutex).
+     */
+    mutable AtomicFile::Stats lastSave;
+
+    /**
+     * @brief Версія знімка, що зараз лежить у filePath (під saveMutex).
+     *
+     * База "брудна", якщо опублікована версія від неї відрізняється.
+     */
+    mutable uint64_t savedVersion = 0;
+
+    /**
+     * @brief Фоновий потік збереження (запускається першим ScheduleSave).
+     */
+    std::thread saver;
+
+    /**
+     * @brief Захищає стан запитів на збереження (savePending, firstRequest, ...).
+     */
+    std::mutex saverMutex;
+
+    /**
+     * @brief Будить фоновий потік збереження.
+     */
+    std::condition_variable saverWake;
+
+    /** @brief Є запит на збереження, який потік ще не виконав. */
+    bool savePending = false;
+    /** @brief Потік має завершитись. */
+    bool stopSaver = false;
+    /** @brief Час першого і останнього запиту в поточній серії. */
+    std::chrono::steady_clock::time_point firstRequest, lastRequest;
+
+    /**
+     * @brief Атомарно записує знімок у файл (викликати під saveMutex).
+     * @param snapshot Версія бази для запису.
+     * @param path Шлях до файлу.
+     * @param stats Виміри запису.
+     * @param error Опис помилки.
+     * @return false, якщо запис не вдався (старий файл лишається цілим).
+     */
+    bool WriteTo(const TermSnapshot &snapshot, const std::string &path,
+                 AtomicFile::Stats &stats, std::string &error) const;
+
+    /**
+     * @brief Записує знімок у filePath і запам'ятовує його версію (викликати під saveMutex).
+     * @return false, якщо запис не вдався.
+     */
+    bool SaveSnapshot(const TermSnapshot &snapshot) const;
+
+    /**
+     * @brief Записує шарди знімка і фіксує їх маніфестом (викликати під saveMutex).
+     * @param snapshot Версія бази для запису.
+     * @param store Сховище.
+     * @param changed Шарди, які треба переписати.
+     * @param stats Сумарні виміри запису.
+     * @param error Опис помилки.
+     * @return false, якщо запис не вдався (маніфест і старі шарди лишаються цілими).
+     */
+    bool WriteShards(const TermSnapshot &snapshot, ShardStore &store, const std::vector<size_t> &changed,
+                     AtomicFile::Stats &stats, std::string &error) const;
+
+    /**
+     * @brief Читає всі шарди паралельно (викликати під writeMutex і saveMutex).
+     * @param terms Куди додати терміни (у порядку бази за їхніми порядковими номерами).
+     * @param sequences Куди додати прочитані номери, паралельно до terms.
+     * @param lazy Читати визначення відкладено.
+     * @param reports Куди додати звіти перевірки відкритих шардів.
+     */
+    void LoadShards(std::vector<TermSnapshot::TermPtr> &terms, std::vector<uint64_t> &sequences, bool lazy,
+                    std::vector<TermFileFormat::Report> &reports) const;
+
+    /**
+     * @brief Виводить пошкодження файлів і вирішує, чи можна зберігати базу (викликати під saveMutex).
+     * @param reports Звіти всіх прочитаних файлів.
+     */
+    void ReportIntegrity(std::vector<TermFileFormat::Report> reports);
+
+    /**
+     * @brief Прив'язує знайдені терміни до знімка, щоб їхні визначення не звільнилися.
      *
-     * Це допоміжний приватний метод, який викликається публічним PrintChainFrom.
+     * Потрібно, коли читач тримає лише терміни, а не знімок (pinReads).
+     * @param snapshot Знімок, з якого взято терміни.
+     * @param terms Терміни; замінюються вказівниками, що володіють знімком.
+     */
+    void PinTerms(const std::shared_ptr<const TermSnapshot> &snapshot,
+                  std::vector<TermSnapshot::TermPtr> &terms) const;
+
+    /**
+     * @brief Навчає кодек на вибірці і стискає визначення щойно прочитаних термінів.
      *
+     * Викликати під writeMutex, поки терміни ще не потрапили в знімок.
+     */
+    void CompressDefinitions(const std::vector<TermSnapshot::TermPtr> &terms);
+
+    /**
+     * @brief Запам'ятовує змінений термін для позначки його шарду (викликати під writeMutex).
+     * @param name Назва терміна.
+     */
+    void Touch(const std::string &name);
+
+    /**
+     * @brief Цикл фонового потоку: чекає серію змін і зберігає її одним записом.
+     */
+    void SaverLoop();
+
+    /**
+     * @brief Рекурсивно збирає ланцюжок залежностей.
+     *
+     * Допоміжний метод для CollectChain / PrintChainFrom.
+     *
+     * @param snapshot Версія бази, з якою працює весь обхід.
      * @param name Назва поточного терміна.
      * @param visited Множина відвіданих термінів (захист від зациклення).
-     * @param level Рівень вкладеності (для відступів у консолі).
+     * @param level Рівень вкладеності.
+     * @param out Зібрані кроки у порядку обходу.
+     */
+    void CollectChainRecursive(const TermSnapshot &snapshot,
+                               const std::string &name,
+                               std::unordered_set<std::string> &visited,
+                               int level,
+                               std::vector<ChainStep> &out) const;
+
+    /**
+     * @brief Створює редаговану копію поточного знімка (викликати під writeMutex).
+     * @return Нова неопублікована версія.
      */
-    void PrintChainRecursive(const std::string &name,
-                             std::unordered_set<std::string> &visited,
-                             int level) const;
+    std::shared_ptr<TermSnapshot> BeginWrite() const;
+
+    /**
+     * @brief Атомарно публікує нову версію бази (викликати під writeMutex).
+     *
+     * Шарди термінів, переданих у Touch, позначаються зміненими до публікації:
+     * збереження, що побачить нову версію, побачить і позначку.
+     * @param next Підготовлена версія.
+     */
+    void Publish(const std::shared_ptr<TermSnapshot> &next);
+
+    /**
+     * @brief Публікує копію з іншим порядком тих самих термінів (викликати під writeMutex).
+     *
+     * Терміни зберігають номери з поточного знімка, якщо ті зростають у новому
+     * порядку; шарди термінів, яким Rebuild дав нові номери, позначаються зміненими.
+     * @param next Неопублікована копія.
+     * @param terms Терміни в новому порядку.
+     */
+    void PublishReordered(const std::shared_ptr<TermSnapshot> &next, const std::vector<TermSnapshot::TermPtr> &terms);
 
 public:
+    /** @brief Кількість підказок назв за замовчуванням. */
+    static constexpr size_t kDefaultCompletions = 10;
+
+    /** @brief Найбільша кількість підказок назв, яку можна запросити. */
+    static constexpr size_t kMaxCompletions = 100;
+
+    /** @brief Скільки часу без нових змін фоновий потік чекає перед записом. */
+    static constexpr std::chrono::milliseconds kSaveQuietPeriod{200};
+
+    /** @brief Найдовше, скільки зміна може лишатися лише в пам'яті (за ScheduleSave). */
+    static constexpr std::chrono::milliseconds kMaxSaveDelay{1000};
+
+    /** @brief Скільки термінів, рівномірно розкиданих по базі, береться у вибірку для кодека. */
+    static constexpr size_t kCodecSampleTerms = 1024;
+
+    /** @brief Найбільший розмір вибірки для кодека в байтах. */
+    static constexpr size_t kCodecSampleBytes = 64 * 1024;
+
     /**
      * @brief Конструктор.
-     * @param filePath Шлях до файлу для завантаження/збереження даних.
+     * @param filePath Шлях до файлу CSV або каталогу з шардами (див. ShardStore).
      */
     explicit TermManager(const std::string &filePath);
 
+    /**
+     * @brief Зупиняє фоновий потік і дописує незбережені зміни, якщо він працював.
+     */
+    ~TermManager();
+
+    TermManager(const TermManager &) = delete;
+    TermManager &operator=(const TermManager &) = delete;
+
+    /**
+     * @brief Повертає поточну версію бази для читання без блокувань.
+     *
+     * Отриманий знімок залишається незмінним і живим, поки на нього є посилання,
+     * навіть якщо тим часом опубліковано нові версії. Поки знімок живий, живі
+     * і всі прочитані через нього визначення, навіть витіснені кешем.
+     * @return Вказівник на незмінний знімок.
+     */
+    std::shared_ptr<const TermSnapshot> Snapshot() const;
+
     /**
      * @brief Завантажує дані з файлу у пам'ять.
      * Парсить CSV-формат, розпізнає типи термінів.
@@ -66,12 +367,143 @@ public:
 
     /**
      * @brief Зберігає поточний стан бази у файл.
+     *
+     * Запис атомарний: після збою на диску лишається попередня або нова версія.
      */
     void Save() const;
 
+    /**
+     * @brief Просить фоновий потік зберегти базу і одразу повертається.
+     *
+     * Серія змін записується одним збереженням: потік чекає kSaveQuietPeriod
+     * тиші, але не довше kMaxSaveDelay від першої незбереженої зміни.
+     */
+    void ScheduleSave();
+
+    /**
+     * @brief Синхронно зберігає базу, якщо вона змінилася з останнього збереження.
+     *
+     * Для завершення роботи та контрольних точок: після повернення на диску
+     * лежить версія, не старша за опубліковану на момент виклику.
+     * @return false, якщо запис не вдався.
+     */
+    bool Flush();
+
+    /**
+     * @brief Чи є зміни, яких ще немає у файлі.
+     */
+    bool IsDirty() const;
+
+    /**
+     * @brief Записує поточну версію бази в інший файл (той самий формат CSV).
+     * @param path Шлях до файлу.
+     * @return false, якщо файл не вдалося записати.
+     */
+    bool Export(const std::string &path) const;
+
+    /**
+     * @brief Записує поточну версію бази в новий каталог із шардами.
+     * @param directory Каталог (створюється, якщо його немає).
+     * @param shards Кількість шардів.
+     * @return false, якщо каталог або файли не вдалося записати.
+     */
+    bool ExportShards(const std::string &directory, size_t shards) const;
+
+    /**
+     * @brief Виміри останнього успішного збереження або експорту.
+     * @return Порожні виміри (bytes == 0), якщо збережень ще не було.
+     */
+    AtomicFile::Stats GetLastSave() const;
+
+    /**
+     * @brief Обмежує пам'ять під прочитані відкладені визначення.
+     *
+     * Діє для бази, завантаженої з SetLazyDefinitions(true). Коли прочитані
+     * визначення перевищують бюджет, давно не використані (CLOCK) знову
+     * стають відкладеними й за потреби читаються з файлу бази. Визначення
+     * термінів, доданих чи змінених після завантаження, лишаються в пам'яті.
+     * @param bytes Бюджет у байтах (0 — без обмеження).
+     */
+    void SetMemoryBudget(size_t bytes);
+
+    /**
+     * @brief Бюджет пам'яті під визначення (0 — без обмеження).
+     */
+    size_t GetMemoryBudget() const;
+
+    /**
+     * @brief Стан кешу визначень: розмір у пам'яті, влучання, витіснення.
+     */
+    DefinitionCache::Stats GetDefinitionCacheStats() const;
+
+    /**
+     * @brief Обирає спосіб вводу-виводу для наступних Load, збережень і експорту.
+     *
+     * Якщо io_uring недоступний, файли все одно читаються і пишуться через POSIX.
+     * @param backend Posix або Uring.
+     */
+    void SetIoBackend(IoBackend backend);
+
+    /**
+     * @brief Обраний спосіб вводу-виводу.
+     */
+    IoBackend GetIoBackend() const;
+
+    /**
+     * @brief Вмикає стиснення визначень у пам'яті для наступних Load.
+     *
+     * Load читає базу через відображений файл, як у SetLazyDefinitions, на
+     * вибірці визначень навчає таблицю символів (DefinitionCodec) і зберігає
+     * кожне визначення закодованим, після чого файл більше не потрібен.
+     * Індекс слів будується, якщо не ввімкнено ще й відкладене читання.
+     * GetDefinition розкодовує визначення в кеш (див. SetMemoryBudget), а
+     * пошук, збереження і перегляди бази розкодовують його в буфер потоку.
+     * Визначення термінів, доданих чи змінених після завантаження, не стискаються.
+     * @param enabled true — стискати.
+     */
+    void SetCompressedDefinitions(bool enabled);
+
+    /**
+     * @brief Чи ввімкнено стиснення визначень.
+     */
+    bool GetCompressedDefinitions() const;
+
+    /**
+     * @brief Підсумок стиснення останнього Load.
+     * @return Порожній підсумок (terms == 0), якщо база не стискалася.
+     */
+    DefinitionCodec::Stats GetCompressionStats() const;
+
+    /**
+     * @brief Звіти перевірки файлів, прочитаних останнім Load.
+     *
+     * Файли версії 2 (див. TermFileFormat) перевіряються за сумами CRC32C
+     * блоків; якщо хоч один звіт містить пошкодження, збереження поверх
+     * бази вимикається до наступного Load, а Export і ExportShards працюють.
+     * @return Порожній список, якщо файлу бази ще немає.
+     */
+    std::vector<TermFileFormat::Report> GetLoadReports() const;
+
+    /**
+     * @brief Вмикає відкладене читання визначень для наступних Load.
+     *
+     * Load відображає файл у пам'ять і запам'ятовує лише зміщення визначень;
+     * текст розекрановується при першому зверненні. Індекс слів у цьому
+     * режимі не будується (він прочитав би всі визначення одразу), і пошук
+     * за словами визначень переглядає базу.
+     * @param enabled true — відкладене читання.
+     */
+    void SetLazyDefinitions(bool enabled);
+
+    /**
+     * @brief Чи ввімкнено відкладене читання визначень.
+     */
+    bool GetLazyDefinitions() const;
+
     /**
      * @brief Додає новий термін до списку.
      * @param term Розумний вказівник на об'єкт терміна.
+     * @note Після додавання об'єкт не можна змінювати: він стає частиною незмінного знімка.
      */
     void AddTerm(const std::shared_ptr<TermBase> &term);
 
@@ -95,7 +527,25 @@ public:
      * @param name Назва.
      * @return Вказівник на знайдений термін або nullptr.
      */
-    std::shared_ptr<TermBase> FindByName(const std::string &name) const;
+    std::shared_ptr<const TermBase> FindByName(const std::string &name) const;
+
+    /**
+     * @brief Підказки для початку назви (автодоповнення).
+     * @param prefix Початок назви в будь-якому регістрі.
+     * @param limit Максимальна кількість підказок.
+     * @return Назви термінів в алфавітному порядку.
+     */
+    std::vector<std::string> CompleteName(const std::string &prefix, size_t limit) const;
+
+    /**
+     * @brief Підказки "можливо, ви мали на увазі" для назви з помилкою.
+     *
+     * Шукає назви на відстані редагування 1 (для назв до 4 символів) або 2.
+     * @param name Назва в будь-якому регістрі.
+     * @param limit Максимальна кількість підказок.
+     * @return Назви, впорядковані за відстанню, потім за популярністю.
+     */
+    std::vector<std::string> SuggestNames(const std::string &name, size_t limit) const;
 
     /**
      * @brief Сортує список термінів за назвою (А-Я).
@@ -117,12 +567,48 @@ public:
      */
     void PrintAllFull() const;
 
+    /**
+     * @brief Паралельно переглядає всю базу і відбирає терміни за умовою.
+     *
+     * Використовується для запитів, які не може обслужити жоден індекс.
+     * @param predicate Умова відбору.
+     * @return Знайдені терміни у порядку бази.
+     */
+    std::vector<TermSnapshot::TermPtr> Scan(const ScanExecutor::Predicate &predicate) const;
+
     /**
      * @brief Шукає терміни, у визначенні яких зустрічається підрядок.
      * @param substring Фрагмент тексту для пошуку.
      */
     void SearchByDefinition(const std::string &substring) const;
 
+    /**
+     * @brief Шукає терміни за фрагментом визначення без виводу.
+     * @param substring Фрагмент (регістр не враховується).
+     * @return Знайдені терміни у порядку бази.
+     */
+    std::vector<TermSnapshot::TermPtr> SearchDefinitions(const std::string &substring) const;
+
+    /**
+     * @brief Виконує запит мовою TermQuery без виводу.
+     * @param text Запит, наприклад "type:PRIM AND def:алгоритм NOT name:клас*".
+     * @param results Знайдені терміни.
+     * @param error Опис синтаксичної помилки.
+     * @param plan Якщо не nullptr — план виконання (explain).
+     * @return false, якщо запит не розібрано.
+     */
+    bool Query(const std::string &text, std::vector<TermSnapshot::TermPtr> &results,
+               std::string &error, std::string *plan = nullptr) const;
+
+    /**
+     * @brief Виконує запит і виводить результати.
+     *
+     * Префікс "explain " додатково виводить вибраний план з оцінками
+     * та фактичною кількістю рядків.
+     * @param text Текст запиту.
+     */
+    void PrintQuery(const std::string &text) const;
+
     /**
      * @brief Виводить список, відфільтрований за типом (первинні або складні).
      * @param primitiveOnly Якщо true - виводить тільки PRIM, інакше - тільки TERM.
@@ -135,6 +621,13 @@ public:
      */
     void PrintChainFrom(const std::string &name) const;
 
+    /**
+     * @brief Збирає ланцюжок залежностей без виводу.
+     * @param name Назва початкового терміна.
+     * @return Кроки обходу в глибину; порожньо, якщо термін не знайдено.
+     */
+    std::vector<ChainStep> CollectChain(const std::string &name) const;
+
     /**
      * @brief Перевіряє, чи є посилання на цей термін в інших термінах.
      * Використовується для заборони видалення важливих понять.
@@ -149,9 +642,14 @@ public:
     void EnsureDefaultTerms();
 
     /**
-     * @brief Виводить статистику (кількість термінів різних типів).
+     * @brief Виводить статистику (кількість термінів різних типів, останнє збереження, кеш визначень).
      */
     void PrintStats() const;
+
+    /**
+     * @brief Повертає статистику без виводу.
+     */
+    TermStats GetStats() const;
 };
 
 #endif //KURSOVA_TERMMANAGER_H
\ No newline at end of file
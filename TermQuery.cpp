@@ -0,0 +1,667 @@
+/**
+ * @file TermQuery.cpp
+ * @brief Реалізація розбору, планування та виконання запитів до бази.
+ */
+
+#include "TermQuery.h"
+#include "Term.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <cctype>
+
+// -------------------------------------------------------------
+//                     TREE
+// -------------------------------------------------------------
+
+/**
+ * @brief Вузол дерева запиту.
+ */
+struct TermQuery::Node {
+    enum class Kind { And, Or, Not, Name, NamePrefix, Word, WordPrefix, Text, Type, Refs };
+
+    Kind kind = Kind::And;
+    /** @brief Значення умови у нижньому регістрі. */
+    std::string value;
+    /** @brief Для type: — чи шукаються первинні терміни. */
+    bool primitive = false;
+    std::vector<std::unique_ptr<Node>> children;
+};
+
+/**
+ * @brief Шлях доступу: звідки беруться кандидати.
+ */
+struct TermQuery::Access {
+    enum class Kind { Scan, Name, NamePrefix, Word, Refs, Union };
+
+    Kind kind = Kind::Scan;
+    /** @brief Умова, що обслуговується індексом. */
+    const Node *node = nullptr;
+    /** @brief Оцінка кількості кандидатів. */
+    size_t estimate = 0;
+    /** @brief Фактична кількість кандидатів (заповнюється під час виконання). */
+    mutable size_t actual = 0;
+    /** @brief Гілки об'єднання. */
+    std::vector<Access> parts;
+};
+
+/**
+ * @brief Термін з лінивими нормалізованими полями для перевірки умов.
+ */
+struct TermQuery::TermView {
+    const TermBase &term;
+    std::string foldedName;
+    std::vector<std::string> words;
+    bool haveName = false;
+    bool haveWords = false;
+
+    /**
+     * @brief Обгортає термін; нормалізація виконується лише за потреби.
+     */
+    explicit TermView(const TermBase &term) : term(term) {}
+
+    /**
+     * @brief Назва у нижньому регістрі (обчислюється один раз).
+     */
+    const std::string &Name() {
+        if (!haveName) {
+            foldedName = Utils::FoldUTF8(term.GetName());
+            haveName = true;
+        }
+        return foldedName;
+    }
+
+    /**
+     * @brief Слова визначення (обчислюються один раз).
+     */
+    const std::vector<std::string> &Words() {
+        if (!haveWords) {
+            term.ReadDefinition([this](const std::string &definition) {
+                words = Utils::SplitWords(definition);
+            });
+            haveWords = true;
+        }
+        return words;
+    }
+};
+
+/**
+ * @brief Створює порожній запит.
+ */
+TermQuery::TermQuery() = default;
+
+/**
+ * @brief Звільняє дерево запиту.
+ */
+TermQuery::~TermQuery() = default;
+
+TermQuery::TermQuery(TermQuery &&) noexcept = default;
+TermQuery &TermQuery::operator=(TermQuery &&) noexcept = default;
+
+// -------------------------------------------------------------
+//                     PARSER
+// -------------------------------------------------------------
+
+namespace {
+
+    /**
+     * @brief Лексема запиту: дужка, оператор або умова.
+     */
+    struct Token {
+        enum class Kind { Open, Close, And, Or, Not, Condition };
+        Kind kind;
+        std::string text;
+    };
+
+    /**
+     * @brief Розбиває запит на лексеми; значення в лапках можуть містити пробіли.
+     *
+     * Слово з лапками завжди є умовою: "AND", "OR" і "NOT" у лапках шукаються як текст.
+     */
+    bool Tokenize(const std::string &text, std::vector<Token> &tokens, std::string &error) {
+        size_t i = 0;
+        while (i < text.size()) {
+            char c = text[i];
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                i++;
+                continue;
+            }
+            if (c == '(' || c == ')') {
+                tokens.push_back({c == '(' ? Token::Kind::Open : Token::Kind::Close, std::string(1, c)});
+                i++;
+                continue;
+            }
+
+            std::string word;
+            bool quoted = false;
+            while (i < text.size() && !std::isspace(static_cast<unsigned char>(text[i])) &&
+                   text[i] != '(' && text[i] != ')') {
+                if (text[i] == '"') {
+                    size_t close = text.find('"', i + 1);
+                    if (close == std::string::npos) {
+                        error = "Незакриті лапки.";
+                        return false;
+                    }
+                    word.append(text, i + 1, close - i - 1);
+                    quoted = true;
+                    i = close + 1;
+                    continue;
+                }
+                word.push_back(text[i++]);
+            }
+
+            std::string upper = word;
+            for (auto &ch : upper) ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+            if (quoted) tokens.push_back({Token::Kind::Condition, word});
+            else if (upper == "AND") tokens.push_back({Token::Kind::And, word});
+            else if (upper == "OR") tokens.push_back({Token::Kind::Or, word});
+            else if (upper == "NOT") tokens.push_back({Token::Kind::Not, word});
+            else tokens.push_back({Token::Kind::Condition, word});
+        }
+        return true;
+    }
+
+    /**
+     * @brief Рекурсивний спуск: OR < AND < NOT < дужки/умова.
+     *
+     * Кожна дужка і кожен NOT додають рівень вкладеності; глибше за
+     * TermQuery::kMaxDepth розбір не йде, тож стек обмежено навіть для
+     * запиту з десятків тисяч дужок.
+     */
+    template <typename Node>
+    class Parser {
+    public:
+        /**
+         * @brief Конструктор.
+         * @param tokens Лексеми запиту.
+         * @param error Куди записати опис помилки.
+         */
+        Parser(const std::vector<Token> &tokens, std::string &error) : tokens(tokens), error(error) {}
+
+        /**
+         * @brief Розбирає весь запит.
+         * @return Корінь дерева або nullptr при помилці.
+         */
+        std::unique_ptr<Node> ParseAll() {
+            auto node = ParseOr();
+            if (node && pos < tokens.size()) {
+                error = "Зайва лексема: " + tokens[pos].text;
+                return nullptr;
+            }
+            return node;
+        }
+
+    private:
+        /**
+         * @brief вираз OR вираз ...
+         */
+        std::unique_ptr<Node> ParseOr() {
+            auto left = ParseAnd();
+            if (!left) return nullptr;
+            while (Peek(Token::Kind::Or)) {
+                pos++;
+                auto right = ParseAnd();
+                if (!right) return nullptr;
+                left = Combine(Node::Kind::Or, std::move(left), std::move(right));
+            }
+            return left;
+        }
+
+        /**
+         * @brief вираз [AND] вираз ... (AND можна пропустити).
+         */
+        std::unique_ptr<Node> ParseAnd() {
+            auto left = ParseNot();
+            if (!left) return nullptr;
+            while (pos < tokens.size() && !Peek(Token::Kind::Or) && !Peek(Token::Kind::Close)) {
+                if (Peek(Token::Kind::And)) pos++;
+                auto right = ParseNot();
+                if (!right) return nullptr;
+                left = Combine(Node::Kind::And, std::move(left), std::move(right));
+            }
+            return left;
+        }
+
+        /**
+         * @brief NOT вираз.
+         */
+        std::unique_ptr<Node> ParseNot() {
+            if (Peek(Token::Kind::Not)) {
+                pos++;
+                if (!Enter()) return nullptr;
+                auto child = ParseNot();
+                depth--;
+                if (!child) return nullptr;
+                auto node = std::make_unique<Node>();
+                node->kind = Node::Kind::Not;
+                node->children.push_back(std::move(child));
+                return node;
+            }
+            return ParsePrimary();
+        }
+
+        /**
+         * @brief Умова або вираз у дужках.
+         */
+        std::unique_ptr<Node> ParsePrimary() {
+            if (pos >= tokens.size()) {
+                error = "Неочікуваний кінець запиту.";
+                return nullptr;
+            }
+            const Token &token = tokens[pos++];
+            if (token.kind == Token::Kind::Open) {
+                if (!Enter()) return nullptr;
+                auto inner = ParseOr();
+                depth--;
+                if (!inner) return nullptr;
+                if (!Peek(Token::Kind::Close)) {
+                    error = "Очікувалась ')'.";
+                    return nullptr;
+                }
+                pos++;
+                return inner;
+            }
+            if (token.kind != Token::Kind::Condition) {
+                error = "Неочікувана лексема: " + token.text;
+                return nullptr;
+            }
+            return ParseCondition(token.text);
+        }
+
+        /**
+         * @brief Умова поле:значення (без поля — def:).
+         */
+        std::unique_ptr<Node> ParseCondition(const std::string &text) {
+            size_t colon = text.find(':');
+            std::string field = colon == std::string::npos ? "def" : Utils::ToLower(text.substr(0, colon));
+            std::string value = Utils::FoldUTF8(colon == std::string::npos ? text : text.substr(colon + 1));
+
+            bool prefix = !value.empty() && value.back() == '*';
+            if (prefix) value.pop_back();
+            if (value.empty()) {
+                error = "Порожнє значення умови: " + text;
+                return nullptr;
+            }
+
+            auto node = std::make_unique<Node>();
+            node->value = value;
+            if (field == "name") {
+                node->kind = prefix ? Node::Kind::NamePrefix : Node::Kind::Name;
+            } else if (field == "def") {
+                node->kind = prefix ? Node::Kind::WordPrefix : Node::Kind::Word;
+            } else if (field == "text" && !prefix) {
+                node->kind = Node::Kind::Text;
+            } else if (field == "refs" && !prefix) {
+                node->kind = Node::Kind::Refs;
+            } else if (field == "type" && (value == "prim" || value == "term")) {
+                node->kind = Node::Kind::Type;
+                node->primitive = value == "prim";
+            } else {
+                error = "Невідома умова: " + text;
+                return nullptr;
+            }
+            return node;
+        }
+
+        /**
+         * @brief Об'єднує вузли одного типу в один список (a AND b AND c).
+         */
+        static std::unique_ptr<Node> Combine(typename Node::Kind kind, std::unique_ptr<Node> left,
+                                             std::unique_ptr<Node> right) {
+            if (left->kind != kind) {
+                auto node = std::make_unique<Node>();
+                node->kind = kind;
+                node->children.push_back(std::move(left));
+                left = std::move(node);
+            }
+            left->children.push_back(std::move(right));
+            return left;
+        }
+
+        /**
+         * @brief Переходить на рівень глибше; false — перевищено TermQuery::kMaxDepth.
+         */
+        bool Enter() {
+            if (++depth <= TermQuery::kMaxDepth) return true;
+            error = "Запит вкладено глибше за " + std::to_string(TermQuery::kMaxDepth) + " рівнів.";
+            return false;
+        }
+
+        /**
+         * @brief Перевіряє тип поточної лексеми.
+         */
+        bool Peek(Token::Kind kind) const {
+            return pos < tokens.size() && tokens[pos].kind == kind;
+        }
+
+        const std::vector<Token> &tokens;
+        std::string &error;
+        size_t pos = 0;
+        /** @brief Поточна вкладеність дужок і NOT. */
+        size_t depth = 0;
+    };
+
+}
+
+/**
+ * @brief Розбирає текст запиту в дерево.
+ * @param text Запит.
+ * @param error Опис помилки.
+ * @return false при помилці.
+ */
+bool TermQuery::Parse(const std::string &text, std::string &error) {
+    root.reset();
+    std::vector<Token> tokens;
+    if (!Tokenize(text, tokens, error)) return false;
+    if (tokens.empty()) {
+        error = "Порожній запит.";
+        return false;
+    }
+
+    Parser<Node> parser(tokens, error);
+    root = parser.ParseAll();
+    // Кожен рівень розбору дає щонайбільше один вузол, плюс оператор верхнього рівня і умова
+    if (root && Depth(*root) > kMaxDepth + 2) {
+        root.reset();
+        error = "Запит вкладено глибше за " + std::to_string(kMaxDepth) + " рівнів.";
+    }
+    return root != nullptr;
+}
+
+/**
+ * @brief Висота дерева: умова — 1, вузол — на 1 більше за найвищу гілку.
+ */
+size_t TermQuery::Depth(const Node &node) {
+    size_t deepest = 0;
+    for (const auto &child : node.children) deepest = std::max(deepest, Depth(*child));
+    return deepest + 1;
+}
+
+// -------------------------------------------------------------
+//                     PRINTING
+// -------------------------------------------------------------
+
+/**
+ * @brief Дописує вузол у нормалізованому вигляді.
+ * @param nested Чи потрібні дужки навколо AND/OR.
+ */
+void TermQuery::Print(const Node &node, std::string &out, bool nested) {
+    switch (node.kind) {
+        case Node::Kind::And:
+        case Node::Kind::Or: {
+            if (nested) out.push_back('(');
+            for (size_t i = 0; i < node.children.size(); ++i) {
+                if (i > 0) out.append(node.kind == Node::Kind::And ? " AND " : " OR ");
+                Print(*node.children[i], out, true);
+            }
+            if (nested) out.push_back(')');
+            return;
+        }
+        case Node::Kind::Not:
+            out.append("NOT ");
+            Print(*node.children[0], out, true);
+            return;
+        case Node::Kind::Name:       out.append("name:" + node.value); return;
+        case Node::Kind::NamePrefix: out.append("name:" + node.value + "*"); return;
+        case Node::Kind::Word:       out.append("def:" + node.value); return;
+        case Node::Kind::WordPrefix: out.append("def:" + node.value + "*"); return;
+        case Node::Kind::Text:       out.append("text:\"" + node.value + "\""); return;
+        case Node::Kind::Refs:       out.append("refs:" + node.value); return;
+        case Node::Kind::Type:       out.append(node.primitive ? "type:PRIM" : "type:TERM"); return;
+    }
+}
+
+/**
+ * @brief Нормалізований запит.
+ */
+std::string TermQuery::ToString() const {
+    std::string out;
+    if (root) Print(*root, out, false);
+    return out;
+}
+
+// -------------------------------------------------------------
+//                     EVALUATION
+// -------------------------------------------------------------
+
+/**
+ * @brief Перевіряє умову на одному терміні.
+ */
+bool TermQuery::Matches(const Node &node, TermView &view) {
+    switch (node.kind) {
+        case Node::Kind::And:
+            for (const auto &child : node.children) {
+                if (!Matches(*child, view)) return false;
+            }
+            return true;
+        case Node::Kind::Or:
+            for (const auto &child : node.children) {
+                if (Matches(*child, view)) return true;
+            }
+            return false;
+        case Node::Kind::Not:
+            return !Matches(*node.children[0], view);
+        case Node::Kind::Name:
+            return view.Name() == node.value;
+        case Node::Kind::NamePrefix:
+            return view.Name().compare(0, node.value.size(), node.value) == 0;
+        case Node::Kind::Word: {
+            const auto &words = view.Words();
+            return std::find(words.begin(), words.end(), node.value) != words.end();
+        }
+        case Node::Kind::WordPrefix:
+            for (const auto &word : view.Words()) {
+                if (word.compare(0, node.value.size(), node.value) == 0) return true;
+            }
+            return false;
+        case Node::Kind::Text:
+            return view.term.DefinitionContains(node.value);
+        case Node::Kind::Type:
+            return view.term.IsPrimitive() == node.primitive;
+        case Node::Kind::Refs: {
+            const auto *term = dynamic_cast<const Term *>(&view.term);
+            if (!term) return false;
+            for (const auto &ref : term->GetReferences()) {
+                if (Utils::FoldUTF8(ref) == node.value) return true;
+            }
+            return false;
+        }
+    }
+    return false;
+}
+
+// -------------------------------------------------------------
+//                     PLANNING
+// -------------------------------------------------------------
+
+/**
+ * @brief Вибирає джерело кандидатів для вузла.
+ *
+ * Листки name:, name:x*, def: і refs: мають точну кількість кандидатів
+ * з індексу (для префікса — кількість різних назв).
+ * Для AND береться найменша оцінка серед індексованих умов, для OR —
+ * об'єднання, якщо індексовані всі гілки. NOT і решта умов потребують
+ * повного перегляду.
+ */
+TermQuery::Access TermQuery::Plan(const Node &node, const TermSnapshot &snapshot) const {
+    Access access;
+    access.node = &node;
+    access.estimate = snapshot.Size();
+
+    switch (node.kind) {
+        case Node::Kind::Name: {
+            const auto *terms = snapshot.FindAllByName(node.value);
+            access.kind = Access::Kind::Name;
+            access.estimate = terms ? terms->size() : 0;
+            break;
+        }
+        case Node::Kind::NamePrefix:
+            access.kind = Access::Kind::NamePrefix;
+            access.estimate = snapshot.CountNamePrefix(node.value);
+            break;
+        case Node::Kind::Word: {
+            bool complete = true;
+            const auto *terms = snapshot.FindByWord(node.value, complete);
+            if (complete) {
+                access.kind = Access::Kind::Word;
+                access.estimate = terms ? terms->size() : 0;
+            }
+            break;
+        }
+        case Node::Kind::Refs: {
+            const auto *referrers = snapshot.FindReferrers(node.value);
+            access.kind = Access::Kind::Refs;
+            access.estimate = referrers ? referrers->size() : 0;
+            break;
+        }
+        case Node::Kind::And: {
+            for (const auto &child : node.children) {
+                Access candidate = Plan(*child, snapshot);
+                if (candidate.kind == Access::Kind::Scan) continue;
+                if (access.kind == Access::Kind::Scan || candidate.estimate < access.estimate) {
+                    access = std::move(candidate);
+                }
+            }
+            break;
+        }
+        case Node::Kind::Or: {
+            size_t total = 0;
+            std::vector<Access> parts;
+            for (const auto &child : node.children) {
+                Access part = Plan(*child, snapshot);
+                if (part.kind == Access::Kind::Scan) return access;
+                total += part.estimate;
+                parts.push_back(std::move(part));
+            }
+            // Об'єднання, що охоплює більше за всю базу, не краще за перегляд
+            if (total < snapshot.Size()) {
+                access.kind = Access::Kind::Union;
+                access.estimate = total;
+                access.parts = std::move(parts);
+            }
+            break;
+        }
+        case Node::Kind::Type:
+            access.estimate = node.primitive ? snapshot.PrimitiveCount()
+                                             : snapshot.Size() - snapshot.PrimitiveCount();
+            break;
+        default:
+            break;
+    }
+    return access;
+}
+
+/**
+ * @brief Заповнює кандидатів з індексів без повторів.
+ */
+void TermQuery::Collect(const Access &access, const TermSnapshot &snapshot, std::vector<TermPtr> &out,
+                        std::unordered_set<const TermBase *> &seen) const {
+    size_t before = out.size();
+    auto add = [&](const TermPtr &term) {
+        if (seen.insert(term.get()).second) out.push_back(term);
+    };
+
+    switch (access.kind) {
+        case Access::Kind::Name:
+            if (const auto *terms = snapshot.FindAllByName(access.node->value)) {
+                for (const auto &t : *terms) add(t);
+            }
+            break;
+        case Access::Kind::NamePrefix:
+            // Оцінка з Plan — точна кількість назв із префіксом
+            for (const auto &name : snapshot.CompleteName(access.node->value, access.estimate)) {
+                if (const auto *terms = snapshot.FindAllByName(name)) {
+                    for (const auto &t : *terms) add(t);
+                }
+            }
+            break;
+        case Access::Kind::Word: {
+            bool complete = true;
+            if (const auto *terms = snapshot.FindByWord(access.node->value, complete)) {
+                for (const auto *t : *terms) {
+                    if (!seen.count(t)) add(snapshot.Resolve(t));
+                }
+            }
+            break;
+        }
+        case Access::Kind::Refs:
+            if (const auto *referrers = snapshot.FindReferrers(access.node->value)) {
+                for (const auto &name : *referrers) {
+                    if (const auto *terms = snapshot.FindAllByName(name)) {
+                        for (const auto &t : *terms) add(t);
+                    }
+                }
+            }
+            break;
+        case Access::Kind::Union:
+            for (const auto &part : access.parts) Collect(part, snapshot, out, seen);
+            break;
+        case Access::Kind::Scan:
+            break;
+    }
+    access.actual = out.size() - before;
+}
+
+/**
+ * @brief Дописує рядок плану з відступом.
+ */
+void TermQuery::Describe(const Access &access, size_t depth, std::string &out) {
+    out.append(2 + depth * 2, ' ');
+    std::string condition;
+    if (access.node) Print(*access.node, condition, false);
+
+    switch (access.kind) {
+        case Access::Kind::Name:  out.append("Індекс назв [" + condition + "]"); break;
+        case Access::Kind::NamePrefix: out.append("Відсортований індекс назв [" + condition + "]"); break;
+        case Access::Kind::Word:  out.append("Індекс слів [" + condition + "]"); break;
+        case Access::Kind::Refs:  out.append("Зворотний індекс посилань [" + condition + "]"); break;
+        case Access::Kind::Union: out.append("Об'єднання індексів"); break;
+        case Access::Kind::Scan:  out.append("Повний перегляд бази"); break;
+    }
+    out.append(" — оцінка: " + std::to_string(access.estimate) +
+               ", фактично: " + std::to_string(access.actual) + "\n");
+    for (const auto &part : access.parts) Describe(part, depth + 1, out);
+}
+
+/**
+ * @brief Виконує запит: кандидати з плану, потім фільтр усім запитом.
+ * @param snapshot Версія бази.
+ * @param scanner Пул для повного перегляду.
+ * @param plan Текст плану (explain) або nullptr.
+ * @return Знайдені терміни.
+ */
+std::vector<TermQuery::TermPtr> TermQuery::Execute(const TermSnapshot &snapshot, ScanExecutor &scanner,
+                                                   std::string *plan) const {
+    std::vector<TermPtr> results;
+    if (!root) return results;
+
+    Access access = Plan(*root, snapshot);
+    if (access.kind == Access::Kind::Scan) {
+        results = scanner.Filter(snapshot, [this](const TermBase &t) {
+            TermView view(t);
+            return Matches(*root, view);
+        });
+        access.actual = snapshot.Size();
+    } else {
+        std::vector<TermPtr> candidates;
+        std::unordered_set<const TermBase *> seen;
+        Collect(access, snapshot, candidates, seen);
+        // Індекси віддають кандидатів у своєму порядку, а перегляд — у порядку бази
+        std::vector<std::pair<uint64_t, TermPtr>> found;
+        for (const auto &t : candidates) {
+            TermView view(*t);
+            if (Matches(*root, view)) found.emplace_back(snapshot.SequenceOf(t.get()), t);
+        }
+        std::sort(found.begin(), found.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+        results.reserve(found.size());
+        for (auto &f : found) results.push_back(std::move(f.second));
+    }
+
+    if (plan) {
+        plan->clear();
+        plan->append("Запит: " + ToString() + "\n");
+        Describe(access, 0, *plan);
+        plan->append("  Фільтр [" + ToString() + "] — результат: " + std::to_string(results.size()) + "\n");
+    }
+    return results;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file TermQuery.h
+ * @brief Оголошення мови запитів до бази термінів і планувальника.
+ */
+
+#ifndef KURSOVA_TERMQUERY_H
+#define KURSOVA_TERMQUERY_H
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "TermSnapshot.h"
+#include "ScanExecutor.h"
+
+/**
+ * @class TermQuery
+ * @brief Булевий запит з умовами на назву, визначення, тип і посилання.
+ *
+ * Синтаксис (оператори — AND, OR, NOT, дужки; пробіл між умовами = AND):
+ *
+ *     name:Клас        точна назва (без урахування регістру)
+ *     name:кла*        назва починається з "кла"
+ *     def:алгоритм     у визначенні є слово "алгоритм" (Utils::SplitWords)
+ *     def:алгоритм*    у визначенні є слово, що починається з "алгоритм"
+ *     text:"два слова" визначення містить фрагмент (як "Пошук у визначеннях")
+ *     type:PRIM        тип терміна (PRIM або TERM)
+ *     refs:Клас        термін посилається на "Клас"
+ *     алгоритм         те саме, що def:алгоритм
+ *
+ * Планувальник вибирає найвибірковіший індекс (назв, префіксів назв, слів,
+ * зворотний індекс посилань) серед умов, які мають виконуватися обов'язково,
+ * отримує з нього кандидатів і перевіряє на них увесь запит як фільтр.
+ * Для OR, усі гілки якого індексовані, кандидати об'єднуються. Інакше
+ * виконується паралельний повний перегляд (ScanExecutor). В обох випадках
+ * результат іде в порядку бази.
+ *
+ * Слово в лапках завжди є умовою, навіть якщо це "AND", "OR" чи "NOT".
+ */
+class TermQuery {
+public:
+    /** @brief Вказівник на термін. */
+    using TermPtr = TermSnapshot::TermPtr;
+
+    /**
+     * @brief Найбільша вкладеність дужок і NOT.
+     *
+     * Розбір, перевірка і планування рекурсивні, тож глибший запит
+     * відхиляється як помилка розбору, ще до виконання.
+     */
+    static constexpr size_t kMaxDepth = 256;
+
+    /**
+     * @brief Створює порожній запит (до виклику Parse нічого не знаходить).
+     */
+    TermQuery();
+
+    /**
+     * @brief Звільняє дерево запиту.
+     */
+    ~TermQuery();
+
+    TermQuery(TermQuery &&) noexcept;
+    TermQuery &operator=(TermQuery &&) noexcept;
+
+    /**
+     * @brief Розбирає текст запиту.
+     * @param text Запит.
+     * @param error Опис помилки, якщо розбір не вдався.
+     * @return false при синтаксичній помилці або вкладеності понад kMaxDepth.
+     */
+    bool Parse(const std::string &text, std::string &error);
+
+    /**
+     * @brief Виконує запит на знімку бази.
+     * @param snapshot Версія бази.
+     * @param scanner Пул для повного перегляду.
+     * @param plan Якщо не nullptr — сюди записується план з оцінками та фактичною кількістю рядків.
+     * @return Знайдені терміни.
+     */
+    std::vector<TermPtr> Execute(const TermSnapshot &snapshot, ScanExecutor &scanner,
+                                 std::string *plan = nullptr) const;
+
+    /**
+     * @brief Запит у нормалізованому вигляді (з дужками).
+     */
+    std::string ToString() const;
+
+private:
+    struct Node;
+    struct Access;
+    struct TermView;
+
+    /**
+     * @brief Висота піддерева (умова має висоту 1).
+     */
+    static size_t Depth(const Node &node);
+
+    /**
+     * @brief Будує шлях доступу для вузла.
+     */
+    Access Plan(const Node &node, const TermSnapshot &snapshot) const;
+
+    /**
+     * @brief Отримує кандидатів з індексів за шляхом доступу.
+     * @param seen Вказівники, що вже є серед кандидатів (для об'єднань).
+     */
+    void Collect(const Access &access, const TermSnapshot &snapshot, std::vector<TermPtr> &out,
+                 std::unordered_set<const TermBase *> &seen) const;
+
+    /**
+     * @brief Перевіряє, чи задовольняє термін умову вузла.
+     */
+    static bool Matches(const Node &node, TermView &view);
+
+    /**
+     * @brief Друкує вузол у нормалізованому вигляді.
+     */
+    static void Print(const Node &node, std::string &out, bool nested);
+
+    /**
+     * @brief Описує шлях доступу в плані.
+     */
+    static void Describe(const Access &access, size_t depth, std::string &out);
+
+    std::unique_ptr<Node> root;
+};
+
+#endif //KURSOVA_TERMQUERY_H
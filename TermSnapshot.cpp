@@ -0,0 +1,530 @@
+/**
+ * @file TermSnapshot.cpp
+ * @brief Реалізація незмінного знімка бази термінів.
+ *
+ * Містить логіку copy-on-write для блоків термінів і сегментів індексів.
+ */
+
+#include "TermSnapshot.h"
+#include "Term.h"
+#include "Utils.h"
+
+#include <algorithm>
+
+// -------------------------------------------------------------
+//                     CONSTRUCTOR
+// -------------------------------------------------------------
+
+/**
+ * @brief Створює порожній знімок з порожніми сегментами індексів.
+ */
+TermSnapshot::TermSnapshot() {
+    for (auto &shard : byName) shard = std::make_shared<NameMap>();
+    for (auto &shard : referencedBy) shard = std::make_shared<RefMap>();
+    for (auto &shard : byWord) shard = std::make_shared<WordMap>();
+    for (auto &shard : termSequences) shard = std::make_shared<SequenceMap>();
+    namePrefixes = std::make_shared<PrefixIndex>();
+}
+
+// -------------------------------------------------------------
+//                     READ ACCESS
+// -------------------------------------------------------------
+
+/**
+ * @brief Кількість термінів у знімку.
+ */
+size_t TermSnapshot::Size() const {
+    return count;
+}
+
+/**
+ * @brief Перевіряє, чи знімок порожній.
+ */
+bool TermSnapshot::Empty() const {
+    return count == 0;
+}
+
+/**
+ * @brief Номер версії знімка.
+ */
+uint64_t TermSnapshot::GetVersion() const {
+    return version;
+}
+
+/**
+ * @brief Обходить терміни блок за блоком у порядку бази.
+ * @param fn Функція-обробник.
+ */
+void TermSnapshot::ForEach(const std::function<void(const TermPtr &)> &fn) const {
+    for (const auto &chunk : chunks) {
+        for (const auto &t : *chunk) {
+            fn(t);
+        }
+    }
+}
+
+/**
+ * @brief Повертає блоки термінів.
+ */
+const std::vector<std::shared_ptr<TermSnapshot::Chunk>> &TermSnapshot::GetChunks() const {
+    return chunks;
+}
+
+/**
+ * @brief Збирає всі терміни в один вектор.
+ */
+std::vector<TermSnapshot::TermPtr> TermSnapshot::ToVector() const {
+    std::vector<TermPtr> result;
+    result.reserve(count);
+    for (const auto &chunk : chunks) {
+        result.insert(result.end(), chunk->begin(), chunk->end());
+    }
+    return result;
+}
+
+/**
+ * @brief Пошук за індексом назв, O(1) у середньому.
+ * @param foldedName Назва у нижньому регістрі.
+ * @return Перший доданий термін із такою назвою або nullptr.
+ */
+TermSnapshot::TermPtr TermSnapshot::FindByName(const std::string &foldedName) const {
+    const auto &shard = *byName[ShardOf(foldedName)];
+    auto it = shard.find(foldedName);
+    if (it == shard.end() || it->second.empty()) return nullptr;
+    return it->second.front();
+}
+
+/**
+ * @brief Усі терміни з назвою через індекс назв.
+ * @param foldedName Назва у нижньому регістрі.
+ */
+const std::vector<TermSnapshot::TermPtr> *TermSnapshot::FindAllByName(const std::string &foldedName) const {
+    const auto &shard = *byName[ShardOf(foldedName)];
+    auto it = shard.find(foldedName);
+    return it == shard.end() ? nullptr : &it->second;
+}
+
+/**
+ * @brief Перевірка посилань через зворотний індекс, O(1) у середньому.
+ * @param foldedName Назва у нижньому регістрі.
+ */
+bool TermSnapshot::IsReferenced(const std::string &foldedName) const {
+    const auto &shard = *referencedBy[ShardOf(foldedName)];
+    auto it = shard.find(foldedName);
+    return it != shard.end() && !it->second.empty();
+}
+
+/**
+ * @brief Назви термінів, що посилаються на foldedName.
+ * @param foldedName Назва у нижньому регістрі.
+ */
+const std::vector<std::string> *TermSnapshot::FindReferrers(const std::string &foldedName) const {
+    const auto &shard = *referencedBy[ShardOf(foldedName)];
+    auto it = shard.find(foldedName);
+    return it == shard.end() ? nullptr : &it->second;
+}
+
+/**
+ * @brief Терміни зі словом у визначенні через індекс слів.
+ * @param foldedWord Слово у нижньому регістрі.
+ * @param complete false, якщо слово не індексується (надто часте).
+ */
+const std::vector<const TermBase *> *TermSnapshot::FindByWord(const std::string &foldedWord,
+                                                             bool &complete) const {
+    if (!wordIndex) {
+        complete = false;
+        return nullptr;
+    }
+    const auto &shard = *byWord[ShardOf(foldedWord)];
+    auto it = shard.find(foldedWord);
+    complete = it == shard.end() || !it->second.saturated;
+    return it == shard.end() || it->second.saturated ? nullptr : &it->second.terms;
+}
+
+/**
+ * @brief Знаходить TermPtr через індекс назв.
+ * @param term Термін зі списку FindByWord.
+ */
+TermSnapshot::TermPtr TermSnapshot::Resolve(const TermBase *term) const {
+    const auto *terms = FindAllByName(Utils::FoldUTF8(term->GetName()));
+    if (!terms) return nullptr;
+    for (const auto &t : *terms) {
+        if (t.get() == term) return t;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Назви з префіксом через відсортований індекс назв.
+ * @param foldedPrefix Префікс у нижньому регістрі.
+ * @param limit Максимальна кількість назв.
+ */
+std::vector<std::string> TermSnapshot::CompleteName(const std::string &foldedPrefix, size_t limit) const {
+    return namePrefixes->Complete(foldedPrefix, limit);
+}
+
+/**
+ * @brief Кількість різних назв із префіксом.
+ * @param foldedPrefix Префікс у нижньому регістрі.
+ */
+size_t TermSnapshot::CountNamePrefix(const std::string &foldedPrefix) const {
+    return namePrefixes->Count(foldedPrefix);
+}
+
+/**
+ * @brief Нечіткий пошук назв через BK-дерево.
+ *
+ * Дерево може містити вже видалені назви, тому кожен збіг перевіряється
+ * за індексом назв.
+ * @param foldedName Назва у нижньому регістрі.
+ * @param maxDistance Радіус пошуку.
+ * @param visited Кількість обчислених відстаней.
+ */
+std::vector<BkTree::Match> TermSnapshot::FindSimilarNames(const std::string &foldedName, uint32_t maxDistance,
+                                                          size_t *visited) const {
+    auto matches = nameTree.Search(foldedName, maxDistance, visited);
+    matches.erase(std::remove_if(matches.begin(), matches.end(),
+                                 [this](const BkTree::Match &m) { return !FindAllByName(m.word); }),
+                  matches.end());
+    return matches;
+}
+
+/**
+ * @brief Кількість первинних термінів.
+ */
+size_t TermSnapshot::PrimitiveCount() const {
+    return primitiveCount;
+}
+
+/**
+ * @brief Номер з індексу номерів, O(1) у середньому.
+ * @param term Термін цього знімка.
+ */
+uint64_t TermSnapshot::SequenceOf(const TermBase *term) const {
+    const auto &shard = *termSequences[ShardOf(term)];
+    auto it = shard.find(term);
+    return it == shard.end() ? 0 : it->second;
+}
+
+// -------------------------------------------------------------
+//                     COPY-ON-WRITE HELPERS
+// -------------------------------------------------------------
+
+/**
+ * @brief Номер сегмента індексу для ключа.
+ */
+size_t TermSnapshot::ShardOf(const std::string &key) {
+    return std::hash<std::string>{}(key) % kIndexShards;
+}
+
+/**
+ * @brief Номер сегмента за адресою терміна (молодші біти однакові через вирівнювання).
+ */
+size_t TermSnapshot::ShardOf(const TermBase *term) {
+    return (reinterpret_cast<uintptr_t>(term) >> 4) % kIndexShards;
+}
+
+/**
+ * @brief Повертає сегмент для зміни.
+ *
+ * Якщо сегмент ще спільний з опублікованою версією (use_count > 1),
+ * спочатку робиться його приватна копія. Неопублікована копія знімка
+ * доступна лише письменнику, тому перевірка use_count тут безпечна.
+ */
+template <typename Map>
+Map &TermSnapshot::MutableShard(std::shared_ptr<Map> &shard) {
+    if (shard.use_count() > 1) {
+        shard = std::make_shared<Map>(*shard);
+    }
+    return *shard;
+}
+
+/**
+ * @brief Повертає блок для зміни (копіює спільний блок).
+ */
+TermSnapshot::Chunk &TermSnapshot::MutableChunk(size_t index) {
+    auto &chunk = chunks[index];
+    if (chunk.use_count() > 1) {
+        chunk = std::make_shared<Chunk>(*chunk);
+    }
+    return *chunk;
+}
+
+/**
+ * @brief Заносить термін до індексів назв, префіксів, слів і зворотного індексу посилань.
+ */
+void TermSnapshot::IndexTerm(const TermPtr &term) {
+    std::string folded = Utils::FoldUTF8(term->GetName());
+    auto &bucket = MutableShard(byName[ShardOf(folded)])[folded];
+    if (bucket.empty()) {
+        MutableShard(namePrefixes).Insert(folded);
+        nameTree.Insert(folded);
+    }
+    bucket.push_back(term);
+    if (wordIndex) IndexWords(term, DefinitionWords(*term));
+
+    if (term->IsPrimitive()) return;
+    auto t = std::dynamic_pointer_cast<const Term>(term);
+    if (!t) return;
+
+    for (const auto &ref : t->GetReferences()) {
+        std::string key = Utils::FoldUTF8(ref);
+        MutableShard(referencedBy[ShardOf(key)])[key].push_back(folded);
+    }
+}
+
+/**
+ * @brief Видаляє по одному входженню назви терміна зі списків посилань.
+ */
+void TermSnapshot::UnindexReferences(const TermPtr &term, const std::string &foldedName) {
+    if (term->IsPrimitive()) return;
+    auto t = std::dynamic_pointer_cast<const Term>(term);
+    if (!t) return;
+
+    for (const auto &ref : t->GetReferences()) {
+        std::string key = Utils::FoldUTF8(ref);
+        auto &shard = MutableShard(referencedBy[ShardOf(key)]);
+        auto it = shard.find(key);
+        if (it == shard.end()) continue;
+
+        auto &names = it->second;
+        auto pos = std::find(names.begin(), names.end(), foldedName);
+        if (pos != names.end()) names.erase(pos);
+        if (names.empty()) shard.erase(it);
+    }
+}
+
+/**
+ * @brief Розбиває визначення на слова, не видаючи посилання на нього.
+ */
+std::vector<std::string> TermSnapshot::DefinitionWords(const TermBase &term) {
+    std::vector<std::string> words;
+    term.ReadDefinition([&words](const std::string &definition) { words = Utils::SplitWords(definition); });
+    return words;
+}
+
+/**
+ * @brief Додає термін до списків слів words.
+ *
+ * Насичені слова пропускаються без копіювання сегмента.
+ */
+void TermSnapshot::IndexWords(const TermPtr &term, const std::vector<std::string> &words) {
+    for (const auto &word : words) {
+        const auto &current = *byWord[ShardOf(word)];
+        auto found = current.find(word);
+        if (found != current.end() && found->second.saturated) continue;
+
+        auto &posting = MutableShard(byWord[ShardOf(word)])[word];
+        if (posting.terms.size() >= kMaxWordPostings) {
+            posting.terms.clear();
+            posting.terms.shrink_to_fit();
+            posting.saturated = true;
+            continue;
+        }
+        posting.terms.push_back(term.get());
+    }
+}
+
+/**
+ * @brief Прибирає термін зі списків слів words.
+ */
+void TermSnapshot::UnindexWords(const TermPtr &term, const std::vector<std::string> &words) {
+    for (const auto &word : words) {
+        const auto &current = *byWord[ShardOf(word)];
+        auto found = current.find(word);
+        if (found == current.end() || found->second.saturated) continue;
+
+        auto &shard = MutableShard(byWord[ShardOf(word)]);
+        auto it = shard.find(word);
+        auto &terms = it->second.terms;
+        auto pos = std::find(terms.begin(), terms.end(), term.get());
+        if (pos != terms.end()) terms.erase(pos);
+        if (terms.empty()) shard.erase(it);
+    }
+}
+
+/**
+ * @brief Переносить індекс слів зі старої версії терміна на нову.
+ *
+ * Слова, що лишилися у визначенні, отримують новий вказівник на місці
+ * старого; прибираються й додаються лише слова, яких стало або не стало.
+ */
+void TermSnapshot::UpdateWords(const TermPtr &oldTerm, const TermPtr &newTerm) {
+    std::vector<std::string> oldWords = DefinitionWords(*oldTerm);
+    std::vector<std::string> newWords = DefinitionWords(*newTerm);
+    std::vector<std::string> removed, added;
+
+    for (auto &word : oldWords) {
+        if (std::find(newWords.begin(), newWords.end(), word) == newWords.end()) {
+            removed.push_back(std::move(word));
+            continue;
+        }
+        const auto &current = *byWord[ShardOf(word)];
+        auto found = current.find(word);
+        if (found == current.end() || found->second.saturated) continue;
+
+        auto &terms = MutableShard(byWord[ShardOf(word)])[word].terms;
+        std::replace(terms.begin(), terms.end(), oldTerm.get(), newTerm.get());
+    }
+    for (auto &word : newWords) {
+        if (std::find(oldWords.begin(), oldWords.end(), word) == oldWords.end()) added.push_back(std::move(word));
+    }
+
+    UnindexWords(oldTerm, removed);
+    IndexWords(newTerm, added);
+}
+
+// -------------------------------------------------------------
+//                     WRITE ACCESS
+// -------------------------------------------------------------
+
+/**
+ * @brief Перебудовує BK-дерево з індексу префіксів, відкидаючи видалені назви.
+ */
+void TermSnapshot::RebuildNameTree() {
+    nameTree = BkTree();
+    for (const auto &name : namePrefixes->Complete("", namePrefixes->Size())) {
+        nameTree.Insert(name);
+    }
+    staleNames = 0;
+}
+
+/**
+ * @brief Додає термін у кінець бази.
+ *
+ * Копіюється тільки останній блок (або створюється новий).
+ * @param term Вказівник на термін.
+ * @param sequence Бажаний номер; 0 або не більший за останній замінюється наступним.
+ */
+void TermSnapshot::Append(const TermPtr &term, uint64_t sequence) {
+    if (chunks.empty() || chunks.back()->size() >= kChunkSize) {
+        chunks.push_back(std::make_shared<Chunk>());
+        chunks.back()->reserve(kChunkSize);
+    }
+    MutableChunk(chunks.size() - 1).push_back(term);
+    lastSequence = sequence > lastSequence ? sequence : lastSequence + 1;
+    MutableShard(termSequences[ShardOf(term.get())])[term.get()] = lastSequence;
+    IndexTerm(term);
+    count++;
+    if (term->IsPrimitive()) primitiveCount++;
+}
+
+/**
+ * @brief Видаляє всі терміни з назвою foldedName.
+ *
+ * Терміни знаходяться через індекс, після чого копіюються лише ті блоки,
+ * в яких вони лежать. Порожні блоки прибираються.
+ * @param foldedName Назва у нижньому регістрі.
+ * @return Кількість видалених термінів.
+ */
+size_t TermSnapshot::RemoveByName(const std::string &foldedName) {
+    auto &nameShard = MutableShard(byName[ShardOf(foldedName)]);
+    auto it = nameShard.find(foldedName);
+    if (it == nameShard.end()) return 0;
+
+    std::vector<TermPtr> victims = std::move(it->second);
+    nameShard.erase(it);
+    MutableShard(namePrefixes).Erase(foldedName);
+    // Дерево не вміє видаляти: коли застарілих назв стає більше, ніж живих, воно перебудовується
+    if (++staleNames > namePrefixes->Size()) RebuildNameTree();
+
+    for (const auto &v : victims) {
+        MutableShard(termSequences[ShardOf(v.get())]).erase(v.get());
+        UnindexReferences(v, foldedName);
+        if (wordIndex) UnindexWords(v, DefinitionWords(*v));
+        if (v->IsPrimitive()) primitiveCount--;
+    }
+
+    size_t removed = 0;
+    for (size_t i = 0; i < chunks.size() && removed < victims.size(); ++i) {
+        const auto &chunk = *chunks[i];
+        bool hit = std::any_of(chunk.begin(), chunk.end(), [&](const TermPtr &t) {
+            return std::find(victims.begin(), victims.end(), t) != victims.end();
+        });
+        if (!hit) continue;
+
+        auto &mutableChunk = MutableChunk(i);
+        auto newEnd = std::remove_if(mutableChunk.begin(), mutableChunk.end(), [&](const TermPtr &t) {
+            return std::find(victims.begin(), victims.end(), t) != victims.end();
+        });
+        removed += static_cast<size_t>(mutableChunk.end() - newEnd);
+        mutableChunk.erase(newEnd, mutableChunk.end());
+    }
+
+    chunks.erase(std::remove_if(chunks.begin(), chunks.end(),
+                                [](const std::shared_ptr<Chunk> &c) { return c->empty(); }),
+                 chunks.end());
+    count -= removed;
+    return removed;
+}
+
+/**
+ * @brief Замінює термін новою версією з тією ж назвою та посиланнями.
+ *
+ * Зворотний індекс зберігає назви, тому він не змінюється; індекс слів
+ * оновлюється за старим і новим визначенням.
+ * @param oldTerm Поточна версія.
+ * @param newTerm Нова версія.
+ * @return true, якщо заміна виконана.
+ */
+bool TermSnapshot::Replace(const TermPtr &oldTerm, const TermPtr &newTerm) {
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        const auto &chunk = *chunks[i];
+        auto pos = std::find(chunk.begin(), chunk.end(), oldTerm);
+        if (pos == chunk.end()) continue;
+
+        size_t offset = static_cast<size_t>(pos - chunk.begin());
+        MutableChunk(i)[offset] = newTerm;
+        uint64_t sequence = SequenceOf(oldTerm.get());
+        MutableShard(termSequences[ShardOf(oldTerm.get())]).erase(oldTerm.get());
+        MutableShard(termSequences[ShardOf(newTerm.get())])[newTerm.get()] = sequence;
+
+        std::string folded = Utils::FoldUTF8(oldTerm->GetName());
+        auto &bucket = MutableShard(byName[ShardOf(folded)])[folded];
+        std::replace(bucket.begin(), bucket.end(), oldTerm, newTerm);
+
+        if (wordIndex) UpdateWords(oldTerm, newTerm);
+        if (oldTerm->IsPrimitive() && !newTerm->IsPrimitive()) primitiveCount--;
+        if (!oldTerm->IsPrimitive() && newTerm->IsPrimitive()) primitiveCount++;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Будує знімок заново (після завантаження або сортування).
+ * @param ordered Терміни у потрібному порядку.
+ * @param sequences Бажані номери або порожній список.
+ */
+void TermSnapshot::Rebuild(const std::vector<TermPtr> &ordered, const std::vector<uint64_t> &sequences) {
+    chunks.clear();
+    for (auto &shard : byName) shard = std::make_shared<NameMap>();
+    for (auto &shard : referencedBy) shard = std::make_shared<RefMap>();
+    for (auto &shard : byWord) shard = std::make_shared<WordMap>();
+    for (auto &shard : termSequences) shard = std::make_shared<SequenceMap>();
+    namePrefixes = std::make_shared<PrefixIndex>();
+    nameTree = BkTree();
+    staleNames = 0;
+    count = 0;
+    primitiveCount = 0;
+    lastSequence = 0;
+
+    for (size_t i = 0; i < ordered.size(); ++i) {
+        Append(ordered[i], i < sequences.size() ? sequences[i] : 0);
+    }
+}
+
+/**
+ * @brief Збільшує номер версії перед публікацією.
+ */
+void TermSnapshot::BumpVersion() {
+    version++;
+}
+
+/**
+ * @brief Вмикає або вимикає індекс слів.
+ * @param enabled true — індекс ведеться.
+ */
+void TermSnapshot::SetWordIndex(bool enabled) {
+    wordIndex = enabled;
+}
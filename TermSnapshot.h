@@ -0,0 +1,351 @@
+/**
+ * @file TermSnapshot.h
+ * @brief Оголошення незмінної версії (знімка) бази термінів.
+ */
+
+#ifndef KURSOVA_TERMSNAPSHOT_H
+#define KURSOVA_TERMSNAPSHOT_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "TermBase.h"
+#include "PrefixIndex.h"
+#include "BkTree.h"
+
+/**
+ * @class TermSnapshot
+ * @brief Знімок бази термінів разом з індексами.
+ *
+ * Опублікований знімок ніколи не змінюється, тому його можна читати з будь-якої
+ * кількості потоків без блокувань. Запис відбувається так: письменник копіює
+ * поточний знімок (копіюються лише вказівники), змінює копію і атомарно
+ * публікує її в TermManager.
+ *
+ * Для дешевого копіювання дані розбито на частини зі спільним володінням:
+ * - терміни лежать у блоках (chunks) фіксованого розміру;
+ * - індекси розбито на сегменти (shards) за хешем ключа;
+ * - відсортовані назви для пошуку за префіксом — на блоки (PrefixIndex);
+ * - BK-дерево назв для нечіткого пошуку — на вузли (BkTree).
+ * Під час зміни копіюється лише той блок або сегмент, який змінюється
+ * (copy-on-write), решта залишається спільною зі старою версією.
+ * Старі версії звільняються автоматично, коли їх відпускає останній читач.
+ *
+ * Порядкові номери термінів (SequenceOf) зростають у порядку бази і, як
+ * і решта знімка, після публікації не змінюються: Append дає новому
+ * терміну номер, більший за всі попередні, Replace передає номер новій
+ * версії, а Rebuild перенумеровує лише ті терміни, що порушують зростання.
+ */
+class TermSnapshot {
+public:
+    /** @brief Вказівник на незмінний термін. */
+    using TermPtr = std::shared_ptr<const TermBase>;
+
+    /** @brief Блок термінів, що зберігає порядок бази. */
+    using Chunk = std::vector<TermPtr>;
+
+    /** @brief Максимальна кількість термінів в одному блоці. */
+    static constexpr size_t kChunkSize = 512;
+
+    /** @brief Кількість сегментів у кожному індексі. */
+    static constexpr size_t kIndexShards = 1024;
+
+    /**
+     * @brief Скільки термінів може мати одне слово в індексі слів.
+     *
+     * Слово, що трапляється частіше (службові слова), перестає індексуватися:
+     * його список лише сповільнював би кожну зміну, а запит за ним однаково
+     * повертає значну частину бази.
+     */
+    static constexpr size_t kMaxWordPostings = 4096;
+
+    /**
+     * @brief Створює порожній знімок.
+     */
+    TermSnapshot();
+
+    // ---------------------------------------------------------
+    //                    ЧИТАННЯ
+    // ---------------------------------------------------------
+
+    /**
+     * @brief Кількість термінів у знімку.
+     */
+    size_t Size() const;
+
+    /**
+     * @brief Перевіряє, чи знімок порожній.
+     */
+    bool Empty() const;
+
+    /**
+     * @brief Номер версії (збільшується з кожною публікацією).
+     */
+    uint64_t GetVersion() const;
+
+    /**
+     * @brief Обходить усі терміни у порядку бази.
+     * @param fn Функція, що викликається для кожного терміна.
+     */
+    void ForEach(const std::function<void(const TermPtr &)> &fn) const;
+
+    /**
+     * @brief Повертає блоки термінів (для поділу роботи між потоками).
+     */
+    const std::vector<std::shared_ptr<Chunk>> &GetChunks() const;
+
+    /**
+     * @brief Повертає копію списку термінів у порядку бази.
+     */
+    std::vector<TermPtr> ToVector() const;
+
+    /**
+     * @brief Шукає перший термін із заданою назвою.
+     * @param foldedName Назва у нижньому регістрі (Utils::FoldUTF8).
+     * @return Вказівник на термін або nullptr.
+     */
+    TermPtr FindByName(const std::string &foldedName) const;
+
+    /**
+     * @brief Повертає всі терміни із заданою назвою.
+     * @param foldedName Назва у нижньому регістрі.
+     * @return Список у порядку додавання або nullptr.
+     */
+    const std::vector<TermPtr> *FindAllByName(const std::string &foldedName) const;
+
+    /**
+     * @brief Перевіряє, чи посилається хоч один термін на задану назву.
+     * @param foldedName Назва у нижньому регістрі.
+     */
+    bool IsReferenced(const std::string &foldedName) const;
+
+    /**
+     * @brief Повертає назви термінів, що посилаються на задану назву.
+     * @param foldedName Назва у нижньому регістрі.
+     * @return Назви у нижньому регістрі або nullptr.
+     */
+    const std::vector<std::string> *FindReferrers(const std::string &foldedName) const;
+
+    /**
+     * @brief Повертає терміни, у визначенні яких є слово (Utils::SplitWords).
+     * @param foldedWord Слово у нижньому регістрі.
+     * @param complete Куди записати false, якщо слово надто часте і не індексується.
+     * @return Список термінів (див. Resolve) або nullptr.
+     */
+    const std::vector<const TermBase *> *FindByWord(const std::string &foldedWord, bool &complete) const;
+
+    /**
+     * @brief Повертає вказівник-власник для терміна з індексу слів.
+     * @param term Термін цього знімка.
+     * @return Вказівник або nullptr, якщо терміна в знімку немає.
+     */
+    TermPtr Resolve(const TermBase *term) const;
+
+    /**
+     * @brief Повертає назви, що починаються з префікса, в алфавітному порядку.
+     * @param foldedPrefix Префікс у нижньому регістрі.
+     * @param limit Максимальна кількість назв.
+     * @return Назви у нижньому регістрі (див. FindByName).
+     */
+    std::vector<std::string> CompleteName(const std::string &foldedPrefix, size_t limit) const;
+
+    /**
+     * @brief Повертає кількість різних назв, що починаються з префікса.
+     * @param foldedPrefix Префікс у нижньому регістрі.
+     */
+    size_t CountNamePrefix(const std::string &foldedPrefix) const;
+
+    /**
+     * @brief Повертає назви на відстані редагування не більше maxDistance.
+     * @param foldedName Назва у нижньому регістрі.
+     * @param maxDistance Найбільша відстань Левенштейна (у кодових точках).
+     * @param visited Якщо не nullptr — кількість порівняних назв.
+     * @return Назви у нижньому регістрі з відстанями.
+     */
+    std::vector<BkTree::Match> FindSimilarNames(const std::string &foldedName, uint32_t maxDistance,
+                                                size_t *visited = nullptr) const;
+
+    /**
+     * @brief Кількість первинних термінів.
+     */
+    size_t PrimitiveCount() const;
+
+    /**
+     * @brief Порядковий номер терміна в цьому знімку.
+     *
+     * Номери зростають у порядку бази, між ними можуть бути пропуски.
+     * Файли шардів зберігають номери, щоб після завантаження відновити
+     * спільний порядок.
+     * @param term Термін цього знімка.
+     * @return Номер або 0, якщо терміна в знімку немає.
+     */
+    uint64_t SequenceOf(const TermBase *term) const;
+
+    // ---------------------------------------------------------
+    //          ЗМІНА (тільки для неопублікованої копії)
+    // ---------------------------------------------------------
+
+    /**
+     * @brief Додає термін у кінець бази.
+     *
+     * Номер 0 або не більший за останній замінюється наступним.
+     * @param term Вказівник на термін.
+     * @param sequence Бажаний порядковий номер (наприклад, прочитаний з шарду).
+     */
+    void Append(const TermPtr &term, uint64_t sequence = 0);
+
+    /**
+     * @brief Видаляє всі терміни із заданою назвою.
+     * @param foldedName Назва у нижньому регістрі.
+     * @return Кількість видалених термінів.
+     */
+    size_t RemoveByName(const std::string &foldedName);
+
+    /**
+     * @brief Замінює термін його новою версією (та сама назва і посилання).
+     * @param oldTerm Поточна версія терміна.
+     * @param newTerm Нова версія терміна.
+     * @return true, якщо стару версію знайдено.
+     */
+    bool Replace(const TermPtr &oldTerm, const TermPtr &newTerm);
+
+    /**
+     * @brief Повністю перебудовує знімок із заданого списку.
+     *
+     * Номери, що вже зростають у порядку списку, зберігаються (завантаження
+     * шардів, сортування); решта термінів отримує нові (див. Append).
+     * @param ordered Терміни у потрібному порядку.
+     * @param sequences Бажані номери, паралельно до ordered (порожній — усі нові).
+     */
+    void Rebuild(const std::vector<TermPtr> &ordered, const std::vector<uint64_t> &sequences = {});
+
+    /**
+     * @brief Позначає знімок як наступну версію перед публікацією.
+     */
+    void BumpVersion();
+
+    /**
+     * @brief Вмикає або вимикає індекс слів визначень.
+     *
+     * Без індексу FindByWord завжди повідомляє про неповну відповідь, і
+     * запит переходить на перебір. Викликати перед Rebuild; копії знімка
+     * успадковують налаштування.
+     */
+    void SetWordIndex(bool enabled);
+
+private:
+    /** @brief Індекс назв: назва -> терміни з цією назвою (у порядку додавання). */
+    using NameMap = std::unordered_map<std::string, std::vector<TermPtr>>;
+
+    /** @brief Зворотний індекс: назва -> назви термінів, що на неї посилаються. */
+    using RefMap = std::unordered_map<std::string, std::vector<std::string>>;
+
+    /**
+     * @brief Терміни з одним словом у визначенні.
+     *
+     * Зберігаються звичайні вказівники: терміном володіють блоки того ж
+     * знімка, а копія сегмента при записі не чіпає лічильників посилань.
+     */
+    struct WordPosting {
+        std::vector<const TermBase *> terms;
+        /** @brief Слово перевищило kMaxWordPostings і більше не індексується. */
+        bool saturated = false;
+    };
+
+    /** @brief Індекс слів визначень: слово -> терміни. */
+    using WordMap = std::unordered_map<std::string, WordPosting>;
+
+    /** @brief Порядкові номери: термін -> номер (див. SequenceOf). */
+    using SequenceMap = std::unordered_map<const TermBase *, uint64_t>;
+
+    /**
+     * @brief Повертає номер сегмента для ключа.
+     */
+    static size_t ShardOf(const std::string &key);
+
+    /**
+     * @brief Повертає номер сегмента для терміна (за адресою).
+     */
+    static size_t ShardOf(const TermBase *term);
+
+    /**
+     * @brief Повертає сегмент, придатний для зміни (копіює його, якщо він спільний).
+     */
+    template <typename Map>
+    static Map &MutableShard(std::shared_ptr<Map> &shard);
+
+    /**
+     * @brief Повертає блок, придатний для зміни (копіює його, якщо він спільний).
+     */
+    Chunk &MutableChunk(size_t index);
+
+    /**
+     * @brief Додає термін до індексів.
+     */
+    void IndexTerm(const TermPtr &term);
+
+    /**
+     * @brief Прибирає термін з індексу посилань.
+     */
+    void UnindexReferences(const TermPtr &term, const std::string &foldedName);
+
+    /**
+     * @brief Слова визначення терміна (Utils::SplitWords).
+     *
+     * Визначення читається через TermBase::ReadDefinition, тож індексування
+     * не лишає в кеші розкодованих чи прочитаних з файлу копій.
+     */
+    static std::vector<std::string> DefinitionWords(const TermBase &term);
+
+    /**
+     * @brief Додає термін до індексу слів.
+     * @param words Слова визначення (Utils::SplitWords).
+     */
+    void IndexWords(const TermPtr &term, const std::vector<std::string> &words);
+
+    /**
+     * @brief Прибирає термін з індексу слів.
+     * @param words Слова визначення (Utils::SplitWords).
+     */
+    void UnindexWords(const TermPtr &term, const std::vector<std::string> &words);
+
+    /**
+     * @brief Оновлює індекс слів при заміні версії терміна.
+     */
+    void UpdateWords(const TermPtr &oldTerm, const TermPtr &newTerm);
+
+    /**
+     * @brief Будує nameTree заново з наявних назв.
+     */
+    void RebuildNameTree();
+
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    std::array<std::shared_ptr<NameMap>, kIndexShards> byName;
+    std::array<std::shared_ptr<RefMap>, kIndexShards> referencedBy;
+    std::array<std::shared_ptr<WordMap>, kIndexShards> byWord;
+    std::array<std::shared_ptr<SequenceMap>, kIndexShards> termSequences;
+    /**
+     * @brief Різні назви у нижньому регістрі, відсортовані для пошуку за префіксом.
+     *
+     * Спільний між версіями, доки не змінюється набір назв: редагування
+     * визначень не копіює навіть каталог його блоків.
+     */
+    std::shared_ptr<PrefixIndex> namePrefixes;
+    /** @brief Назви для нечіткого пошуку; видалені лишаються в дереві до перебудови. */
+    BkTree nameTree;
+    /** @brief Скільки назв видалено з бази з часу побудови nameTree. */
+    size_t staleNames = 0;
+    size_t count = 0;
+    size_t primitiveCount = 0;
+    uint64_t version = 0;
+    /** @brief Найбільший порядковий номер, виданий у цьому знімку. */
+    uint64_t lastSequence = 0;
+    /** @brief Чи ведеться індекс слів (див. SetWordIndex). */
+    bool wordIndex = true;
+};
+
+#endif //KURSOVA_TERMSNAPSHOT_H
@@ -31,7 +31,8 @@ User::User(const std::string &username,
  * @param other Об'єкт, з якого копіюються дані.
  */
 User::User(const User &other)
-        : username(other.username), password(other.password), role(other.role) {}
+        : username(other.username), password(other.password), role(other.role),
+          permissions(other.permissions) {}
 
 /**
  * @brief Конструктор переміщення.
@@ -40,7 +41,8 @@ User::User(const User &other)
 User::User(User &&other) noexcept
         : username(std::move(other.username)),
           password(std::move(other.password)),
-          role(std::move(other.role)) {}
+          role(std::move(other.role)),
+          permissions(other.permissions) {}
 
 /**
  * @brief Деструктор.
@@ -58,6 +60,7 @@ User &User::operator=(const User &other) {
         username = other.username;
         password = other.password;
         role = other.role;
+        permissions = other.permissions;
     }
     return *this;
 }
@@ -72,6 +75,7 @@ User &User::operator=(User &&other) noexcept {
         username = std::move(other.username);
         password = std::move(other.password);
         role = std::move(other.role);
+        permissions = other.permissions;
     }
     return *this;
 }
@@ -100,6 +104,23 @@ const std::string &User::GetRole() const {
     return role;
 }
 
+/**
+ * @brief Отримує маску прав.
+ * @return Маска прав.
+ */
+uint32_t User::GetPermissions() const {
+    return permissions;
+}
+
+/**
+ * @brief Перевіряє наявність прав одним побітовим AND.
+ * @param required Потрібні права.
+ * @return true, якщо всі права є.
+ */
+bool User::HasPermission(uint32_t required) const {
+    return (permissions & required) == required;
+}
+
 /**
  * @brief Встановлює новий логін.
  * @param value Новий логін.
@@ -122,4 +143,12 @@ void User::SetPassword(const std::string &value) {
  */
 void User::SetRole(const std::string &value) {
     role = value;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Встановлює маску прав.
+ * @param value Нова маска.
+ */
+void User::SetPermissions(uint32_t value) {
+    permissions = value;
+}
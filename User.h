@@ -6,6 +6,7 @@
 #ifndef KURSOVA_USER_H
 #define KURSOVA_USER_H
 
+#include <cstdint>
 #include <string>
 
 /**
@@ -13,9 +14,9 @@
  * @brief Клас для представлення користувача системи.
  *
  * Зберігає облікові дані (логін, пароль) та роль користувача в системі.
- * Підтримуються дві ролі:
- * - "admin": має повний доступ (додавання, редагування, видалення термінів та користувачів).
- * - "user": має обмежений доступ (тільки перегляд та пошук).
+ * Роль — назва з файлу ролей (див. RoleManager); під час завантаження
+ * вона компілюється у маску прав, і перевірки доступу виконуються
+ * одним побітовим AND (HasPermission).
  */
 class User {
 private:
@@ -26,17 +27,23 @@ private:
     std::string username;
 
     /**
-     * @brief Пароль користувача.
-     * Зберігається у відкритому вигляді (для навчальних цілей).
+     * @brief Запис пароля користувача.
+     * Зберігається не сам пароль, а його хеш PBKDF2-HMAC-SHA256 з сіллю
+     * у форматі "pbkdf2-sha256$ітерації$сіль$хеш" (див. UserManager).
      */
     std::string password;
 
     /**
      * @brief Роль користувача.
-     * Визначає рівень доступу ("admin" або "user").
+     * Визначає рівень доступу ("admin", "user" або роль з файлу ролей).
      */
     std::string role;
 
+    /**
+     * @brief Маска прав, скомпільована з ролі (див. Permission).
+     */
+    uint32_t permissions = 0;
+
 public:
     /**
      * @brief Конструктор за замовчуванням.
@@ -46,7 +53,7 @@ public:
     /**
      * @brief Параметризований конструктор.
      * @param username Логін.
-     * @param password Пароль.
+     * @param password Запис пароля (хеш).
      * @param role Роль доступу.
      */
     User(const std::string &username,
@@ -91,7 +98,7 @@ public:
     const std::string &GetUsername() const;
 
     /**
-     * @brief Отримує пароль користувача.
+     * @brief Отримує запис пароля (хеш із сіллю).
      * @return Константне посилання на рядок.
      */
     const std::string &GetPassword() const;
@@ -102,6 +109,19 @@ public:
      */
     const std::string &GetRole() const;
 
+    /**
+     * @brief Отримує маску прав.
+     * @return Маска (біти Permission).
+     */
+    uint32_t GetPermissions() const;
+
+    /**
+     * @brief Перевіряє наявність усіх потрібних прав.
+     * @param required Маска потрібних прав.
+     * @return true, якщо всі біти required встановлено.
+     */
+    bool HasPermission(uint32_t required) const;
+
     /**
      * @brief Встановлює новий логін.
      * @param value Нове значення логіна.
@@ -109,16 +129,23 @@ public:
     void SetUsername(const std::string &value);
 
     /**
-     * @brief Встановлює новий пароль.
-     * @param value Нове значення пароля.
+     * @brief Встановлює новий запис пароля.
+     * @param value Хеш пароля (див. UserManager).
      */
     void SetPassword(const std::string &value);
 
     /**
      * @brief Встановлює нову роль.
      * @param value Нова роль ("admin" або "user").
+     * @note Маску прав треба оновити окремо (SetPermissions).
      */
     void SetRole(const std::string &value);
+
+    /**
+     * @brief Встановлює маску прав.
+     * @param value Маска, отримана з RoleManager::Compile.
+     */
+    void SetPermissions(uint32_t value);
 };
 
 #endif //KURSOVA_USER_H
\ No newline at end of file
@@ -8,9 +8,13 @@
 
 #include "UserManager.h"
 #include "Utils.h"
+#include "AtomicFile.h"
+#include "Metrics.h"
 #include <fstream>
 #include <iostream>
 #include <algorithm>
+#include <thread>
+#include <unordered_set>
 
 // -------------------------------------------------------------
 //                     CONSTRUCTOR
@@ -19,9 +23,176 @@
 /**
  * @brief Конструктор.
  * @param filePath Шлях до файлу з даними користувачів (наприклад, "users.txt").
+ * @param rolesPath Шлях до файлу ролей (наприклад, "roles.txt").
  */
-UserManager::UserManager(const std::string &filePath)
-        : filePath(filePath) {}
+UserManager::UserManager(const std::string &filePath, const std::string &rolesPath)
+        : cacheSecret(Crypto::RandomBytes(32)), roles(rolesPath), filePath(filePath) {}
+
+// -------------------------------------------------------------
+//                     PASSWORD HASHING
+// -------------------------------------------------------------
+
+/**
+ * @brief Калібрує вартість PBKDF2 під бажану затримку.
+ *
+ * Робить пробне хешування з kMinIterations ітерацій і пропорційно
+ * масштабує кількість ітерацій.
+ * @param targetMillis Бажана тривалість однієї перевірки, мс.
+ * @return Обрана кількість ітерацій.
+ */
+uint32_t UserManager::CalibrateCost(double targetMillis) {
+    auto start = std::chrono::steady_clock::now();
+    Crypto::Pbkdf2Sha256("calibration", "calibration-salt", kMinIterations);
+    double elapsed = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+
+    double scaled = elapsed > 0 ? kMinIterations * (targetMillis / elapsed) : kDefaultIterations;
+    hashIterations = std::max<uint32_t>(kMinIterations, static_cast<uint32_t>(scaled));
+
+    double perLogin = elapsed * hashIterations / kMinIterations;
+    std::cout << "[INFO] Вартість хешування паролів: " << hashIterations << " ітерацій (~"
+              << static_cast<int>(perLogin) << " мс, ~"
+              << static_cast<int>(perLogin > 0 ? 1000.0 / perLogin : 0) << " входів/с на ядро)" << std::endl;
+    return hashIterations;
+}
+
+/**
+ * @brief Поточна вартість хешування.
+ */
+uint32_t UserManager::GetHashIterations() const {
+    return hashIterations;
+}
+
+/**
+ * @brief Змінює час життя кешу підтверджених входів.
+ * @param ttl Тривалість (0 вимикає кеш).
+ */
+void UserManager::SetVerificationCacheTtl(std::chrono::seconds ttl) {
+    std::lock_guard<std::mutex> lock(verifiedMutex);
+    verifiedTtl = ttl;
+    verified.clear();
+}
+
+/**
+ * @brief Вимірює швидкість перевірок пароля на кількох потоках.
+ */
+double UserManager::MeasureLoginRate(uint32_t iterations, size_t threads, std::chrono::milliseconds duration) {
+    const std::string password = "benchmark";
+    const std::string record = HashPassword(password, iterations);
+    threads = std::max<size_t>(1, threads);
+
+    std::vector<size_t> counts(threads, 0);
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + duration;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            while (counts[t] < 2 || std::chrono::steady_clock::now() < deadline) {
+                if (VerifyPassword(record, password)) counts[t]++;
+                else return;
+            }
+        });
+    }
+    for (auto &worker : workers) worker.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t total = 0;
+    for (size_t count : counts) total += count;
+    return seconds > 0 ? static_cast<double>(total) / seconds : 0.0;
+}
+
+/**
+ * @brief Хешує пароль з новою випадковою сіллю (16 байтів) за поточною вартістю.
+ * @param password Пароль.
+ * @return Запис "pbkdf2-sha256$ітерації$сіль$хеш".
+ */
+std::string UserManager::HashPassword(const std::string &password) const {
+    return HashPassword(password, hashIterations);
+}
+
+/**
+ * @brief Хешує пароль з новою випадковою сіллю (16 байтів).
+ * @param password Пароль.
+ * @param iterations Кількість ітерацій PBKDF2.
+ * @return Запис "pbkdf2-sha256$ітерації$сіль$хеш".
+ */
+std::string UserManager::HashPassword(const std::string &password, uint32_t iterations) {
+    std::string salt = Crypto::RandomBytes(16);
+    Crypto::Digest hash = Crypto::Pbkdf2Sha256(password, salt, iterations);
+
+    return "pbkdf2-sha256$" + std::to_string(iterations) + "$" +
+           Crypto::ToHex(reinterpret_cast<const uint8_t *>(salt.data()), salt.size()) + "$" +
+           Crypto::ToHex(hash.data(), hash.size());
+}
+
+/**
+ * @brief Хешування — найдорожча частина, тож записи розподіляються між ядрами.
+ * @param passwords Паролі; на виході — записи "pbkdf2-sha256$...".
+ */
+void UserManager::HashPasswords(std::vector<std::string> &passwords) const {
+    size_t threads = std::min<size_t>(passwords.size(),
+                                      std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            for (size_t i = t; i < passwords.size(); i += threads) {
+                passwords[i] = HashPassword(passwords[i]);
+            }
+        });
+    }
+    for (auto &th : pool) th.join();
+}
+
+/**
+ * @brief Перевіряє пароль: повторює PBKDF2 з сіллю і вартістю із запису.
+ * @param record Запис пароля.
+ * @param password Введений пароль.
+ * @return true, якщо хеші збігаються.
+ */
+bool UserManager::VerifyPassword(const std::string &record, const std::string &password) {
+    auto parts = Utils::Split(record, '$');
+    if (parts.size() != 4 || parts[0] != "pbkdf2-sha256") return false;
+
+    uint32_t iterations = 0;
+    try {
+        iterations = static_cast<uint32_t>(std::stoul(parts[1]));
+    } catch (const std::exception &) {
+        return false;
+    }
+
+    std::string salt, expected;
+    if (iterations == 0 || !Crypto::FromHex(parts[2], salt) ||
+        !Crypto::FromHex(parts[3], expected) || expected.size() != 32) {
+        return false;
+    }
+
+    Crypto::Digest actual = Crypto::Pbkdf2Sha256(password, salt, iterations);
+    return Crypto::ConstantTimeEquals(actual.data(),
+                                      reinterpret_cast<const uint8_t *>(expected.data()),
+                                      actual.size());
+}
+
+/**
+ * @brief Перевіряє, чи запис уже є хешем.
+ */
+bool UserManager::IsHashed(const std::string &record) {
+    return record.rfind("pbkdf2-sha256$", 0) == 0;
+}
+
+/**
+ * @brief Доказ успішного входу для кешу.
+ *
+ * Включає запис пароля, тому після зміни пароля старий доказ автоматично
+ * перестає збігатися.
+ */
+Crypto::Digest UserManager::LoginProof(const User &user, const std::string &password) const {
+    std::string message = user.GetUsername();
+    message.push_back('\0');
+    message += password;
+    message.push_back('\0');
+    message += user.GetPassword();
+    return Crypto::HmacSha256(cacheSecret, message);
+}
 
 // -------------------------------------------------------------
 //                     LOAD
@@ -31,17 +202,34 @@ UserManager::UserManager(const std::string &filePath)
  * @brief Завантажує список користувачів з файлу.
  *
  * Формат файлу: логін:пароль:роль
+ * Спершу завантажуються ролі, щоб кожен запис отримав маску прав.
  * Якщо файл не знайдено, виводиться повідомлення, але помилка не кидається
- * (файл буде створено пізніше при збереженні).
+ * (файл буде створено пізніше при збереженні). Паролі старого формату
+ * (відкриті) збираються і хешуються разом через HashPasswords: по одному
+ * тисячі облікових записів переводилися б хвилинами.
  */
 void UserManager::Load() {
+    roles.Load();
+    roles.EnsureDefaultRoles();
+
     users.clear();
+    removed.clear();
+    index.clear();
+    tombstones = 0;
+    {
+        std::lock_guard<std::mutex> lock(verifiedMutex);
+        verified.clear();
+    }
     std::ifstream in(filePath);
     if (!in.is_open()) {
         std::cout << "[INFO] Файл користувачів не знайдено, буде створено новий." << std::endl;
         return;
     }
 
+    std::vector<User> loaded;
+    // Позиції записів з відкритим паролем у loaded
+    std::vector<size_t> plain;
+    std::unordered_set<std::string> seen;
     try {
         std::string line;
         while (std::getline(in, line)) {
@@ -56,11 +244,40 @@ void UserManager::Load() {
             std::string username = Utils::Trim(parts[0]);
             std::string password = Utils::Trim(parts[1]);
             std::string role = Utils::Trim(parts[2]);
-            users.emplace_back(username, password, role);
+            // Дублікати логінів у файлі ігноруються (перший запис має пріоритет)
+            if (!seen.insert(username).second) {
+                continue;
+            }
+            // Старий формат із відкритим паролем — замінюємо хешем після читання
+            if (!IsHashed(password)) plain.push_back(loaded.size());
+            loaded.emplace_back(username, password, role);
         }
     } catch (const std::exception &ex) {
         std::cerr << "[ERROR] Помилка читання користувачів: " << ex.what() << std::endl;
     }
+
+    std::vector<std::string> records;
+    records.reserve(plain.size());
+    for (size_t i : plain) records.push_back(loaded[i].GetPassword());
+    HashPasswords(records);
+
+    users.reserve(loaded.size());
+    removed.reserve(loaded.size());
+    index.reserve(loaded.size());
+    size_t next = 0;
+    for (size_t i = 0; i < loaded.size(); ++i) {
+        const User &u = loaded[i];
+        if (next < plain.size() && plain[next] == i) {
+            Append(User(u.GetUsername(), records[next++], u.GetRole()));
+        } else {
+            Append(u);
+        }
+    }
+
+    if (!plain.empty()) {
+        std::cout << "[INFO] Паролі у відкритому вигляді замінено на хеші." << std::endl;
+        Save();
+    }
 }
 
 // -------------------------------------------------------------
@@ -70,22 +287,21 @@ void UserManager::Load() {
 /**
  * @brief Зберігає поточний список користувачів у файл.
  *
- * Перезаписує файл повністю. Дані зберігаються у форматі:
+ * Перезаписує файл повністю і атомарно (див. AtomicFile): після збою
+ * лишається або старий, або новий список. Дані зберігаються у форматі:
  * username:password:role
  */
 void UserManager::Save() const {
-    std::ofstream out(filePath);
-    if (!out.is_open()) {
-        std::cerr << "[ERROR] Не вдалося відкрити users.txt для запису." << std::endl;
-        return;
+    std::string data;
+    for (size_t i = 0; i < users.size(); ++i) {
+        if (removed[i]) continue;
+        const auto &u = users[i];
+        data += u.GetUsername() + ":" + u.GetPassword() + ":" + u.GetRole() + "\n";
     }
 
-    try {
-        for (const auto &u : users) {
-            out << u.GetUsername() << ":" << u.GetPassword() << ":" << u.GetRole() << "\n";
-        }
-    } catch (const std::exception &ex) {
-        std::cerr << "[ERROR] Помилка запису users.txt: " << ex.what() << std::endl;
+    std::string error;
+    if (!AtomicFile::WriteAll(filePath, data, error)) {
+        std::cerr << "[ERROR] Не вдалося записати users.txt: " << error << std::endl;
     }
 }
 
@@ -101,16 +317,9 @@ void UserManager::Save() const {
  * Це гарантує, що в систему завжди можна увійти.
  */
 void UserManager::EnsureDefaultAdmin() {
-    bool hasAdmin = false;
-    for (const auto &u : users) {
-        if (u.GetUsername() == "admin") {
-            hasAdmin = true;
-            break;
-        }
-    }
-    if (!hasAdmin) {
+    if (!FindUser("admin")) {
         std::cout << "[INFO] Створено адміністратора за замовчуванням: admin/admin" << std::endl;
-        users.emplace_back("admin", "admin", "admin");
+        Append(User("admin", HashPassword("admin"), "admin"));
         Save();
     }
 }
@@ -129,13 +338,88 @@ void UserManager::EnsureDefaultAdmin() {
 bool UserManager::Authenticate(const std::string &login,
                                const std::string &password,
                                User &outUser) const {
-    for (const auto &u : users) {
-        if (u.GetUsername() == login && u.GetPassword() == password) {
-            outUser = u;
-            return true;
+    const User *user = Authenticate(login, password);
+    if (!user) return false;
+    outUser = *user;
+    return true;
+}
+
+/**
+ * @brief Перевіряє логін і пароль через індекс, без копіювання User.
+ * @param login Введений логін.
+ * @param password Введений пароль.
+ * @return Вказівник на користувача або nullptr.
+ */
+const User *UserManager::Authenticate(const std::string &login,
+                                      const std::string &password) const {
+    Metrics::Timer timer(Metrics::Op::Authenticate);
+    const User *user = FindUser(login);
+    if (!user) return nullptr;
+
+    auto now = std::chrono::steady_clock::now();
+    Crypto::Digest proof = LoginProof(*user, password);
+
+    // Швидкий шлях: цей пароль нещодавно вже перевірено повністю
+    {
+        std::lock_guard<std::mutex> lock(verifiedMutex);
+        auto it = verified.find(login);
+        if (it != verified.end()) {
+            if (it->second.expires > now &&
+                Crypto::ConstantTimeEquals(it->second.proof.data(), proof.data(), proof.size())) {
+                return user;
+            }
+            if (it->second.expires <= now) verified.erase(it);
         }
     }
-    return false;
+
+    if (!VerifyPassword(user->GetPassword(), password)) return nullptr;
+
+    std::lock_guard<std::mutex> lock(verifiedMutex);
+    if (verifiedTtl.count() > 0) {
+        verified[login] = VerifiedLogin{proof, now + verifiedTtl};
+    }
+    return user;
+}
+
+/**
+ * @brief Шукає користувача за логіном через хеш-індекс.
+ * @param username Логін.
+ * @return Вказівник на користувача або nullptr.
+ */
+const User *UserManager::FindUser(const std::string &username) const {
+    auto it = index.find(username);
+    if (it == index.end()) return nullptr;
+    return &users[it->second];
+}
+
+// -------------------------------------------------------------
+//                     SESSIONS
+// -------------------------------------------------------------
+
+/**
+ * @brief Перевіряє пароль один раз і видає токен.
+ * @param login Логін.
+ * @param password Пароль.
+ * @return Токен або "".
+ */
+std::string UserManager::OpenSession(const std::string &login, const std::string &password) {
+    const User *user = Authenticate(login, password);
+    if (!user) return "";
+    return sessions.Open(user->GetUsername(), user->GetPermissions());
+}
+
+/**
+ * @brief Перевірка токена (лише таблиця сесій).
+ */
+bool UserManager::ValidateSession(const std::string &token, Session &out) const {
+    return sessions.Validate(token, out);
+}
+
+/**
+ * @brief Закриває сесію.
+ */
+bool UserManager::CloseSession(const std::string &token) {
+    return sessions.Close(token);
 }
 
 // -------------------------------------------------------------
@@ -146,24 +430,57 @@ bool UserManager::Authenticate(const std::string &login,
  * @brief Додає нового користувача.
  * @param username Логін.
  * @param password Пароль.
- * @param role Роль ("user" або "admin").
- * @return true, якщо користувача успішно додано; false, якщо такий логін вже існує.
+ * @param role Роль (з файлу ролей).
+ * @return true, якщо користувача успішно додано; false, якщо логін вже існує або роль невідома.
  */
 bool UserManager::AddUser(const std::string &username,
                           const std::string &password,
                           const std::string &role) {
-    // Перевірка на унікальність логіна
-    auto it = std::find_if(users.begin(), users.end(),
-                           [&username](const User &u) {
-                               return u.GetUsername() == username;
-                           });
-    if (it != users.end()) {
+    // Перевірка на унікальність логіна та існування ролі
+    if (index.count(username) || !roles.HasRole(role)) {
         return false;
     }
-    users.emplace_back(username, password, role);
+    Append(User(username, HashPassword(password), role));
     return true;
 }
 
+/**
+ * @brief Пакетне додавання користувачів.
+ *
+ * Перевірка унікальності кожного запису — O(1) через індекс, а файл
+ * перезаписується лише один раз наприкінці.
+ * @param batch Нові користувачі.
+ * @return Кількість доданих.
+ */
+size_t UserManager::AddUsers(const std::vector<User> &batch) {
+    // Спочатку відбираємо унікальні записи (O(1) на запис)
+    std::vector<const User *> accepted;
+    std::unordered_map<std::string, bool> seen;
+    seen.reserve(batch.size());
+    for (const auto &u : batch) {
+        if (u.GetUsername().empty() || index.count(u.GetUsername())) continue;
+        if (!roles.HasRole(u.GetRole())) continue;
+        if (!seen.emplace(u.GetUsername(), true).second) continue;
+        accepted.push_back(&u);
+    }
+    if (accepted.empty()) return 0;
+
+    std::vector<std::string> records;
+    records.reserve(accepted.size());
+    for (const auto *u : accepted) records.push_back(u->GetPassword());
+    HashPasswords(records);
+
+    users.reserve(users.size() + accepted.size());
+    removed.reserve(removed.size() + accepted.size());
+    index.reserve(index.size() + accepted.size());
+    for (size_t i = 0; i < accepted.size(); ++i) {
+        Append(User(accepted[i]->GetUsername(), records[i], accepted[i]->GetRole()));
+    }
+
+    Save();
+    return accepted.size();
+}
+
 // -------------------------------------------------------------
 //                     REMOVE USER
 // -------------------------------------------------------------
@@ -180,13 +497,62 @@ bool UserManager::RemoveUser(const std::string &username) {
         std::cout << "Видалення адміністратора заборонено." << std::endl;
         return false;
     }
-    auto it = std::remove_if(users.begin(), users.end(),
-                             [&username](const User &u) {
-                                 return u.GetUsername() == username;
-                             });
-    bool removed = it != users.end();
-    users.erase(it, users.end());
-    return removed;
+    auto it = index.find(username);
+    if (it == index.end()) {
+        return false;
+    }
+
+    // Позначаємо запис видаленим замість зсуву всього вектора
+    removed[it->second] = true;
+    index.erase(it);
+    tombstones++;
+    {
+        std::lock_guard<std::mutex> lock(verifiedMutex);
+        verified.erase(username);
+    }
+    sessions.CloseAllFor(username);
+
+    if (tombstones > 64 && tombstones * 2 > users.size()) {
+        Compact();
+    }
+    return true;
+}
+
+// -------------------------------------------------------------
+//                     STORAGE HELPERS
+// -------------------------------------------------------------
+
+/**
+ * @brief Додає запис у вектор та індекс.
+ * @param user Новий користувач.
+ */
+void UserManager::Append(const User &user) {
+    index[user.GetUsername()] = users.size();
+    users.push_back(user);
+    users.back().SetPermissions(roles.Compile(user.GetRole()));
+    removed.push_back(false);
+}
+
+/**
+ * @brief Прибирає видалені записи і перебудовує індекс.
+ *
+ * Виконується рідко (коли видалених записів більше половини),
+ * тому середня вартість видалення залишається O(1).
+ */
+void UserManager::Compact() {
+    std::vector<User> live;
+    live.reserve(users.size() - tombstones);
+    for (size_t i = 0; i < users.size(); ++i) {
+        if (!removed[i]) live.push_back(std::move(users[i]));
+    }
+
+    users = std::move(live);
+    removed.assign(users.size(), false);
+    index.clear();
+    for (size_t i = 0; i < users.size(); ++i) {
+        index[users[i].GetUsername()] = i;
+    }
+    tombstones = 0;
 }
 
 // -------------------------------------------------------------
@@ -194,9 +560,22 @@ bool UserManager::RemoveUser(const std::string &username) {
 // -------------------------------------------------------------
 
 /**
- * @brief Отримує список усіх користувачів.
- * @return Константне посилання на вектор користувачів.
+ * @brief Отримує список усіх користувачів (без видалених записів).
+ * @return Вказівники на користувачів у порядку реєстрації.
+ */
+std::vector<const User *> UserManager::GetUsers() const {
+    std::vector<const User *> result;
+    result.reserve(users.size() - tombstones);
+    for (size_t i = 0; i < users.size(); ++i) {
+        if (!removed[i]) result.push_back(&users[i]);
+    }
+    return result;
+}
+
+/**
+ * @brief Доступ до ролей.
+ * @return Константне посилання на менеджер ролей.
  */
-const std::vector<User> &UserManager::GetUsers() const {
-    return users;
+const RoleManager &UserManager::GetRoles() const {
+    return roles;
 }
\ No newline at end of file
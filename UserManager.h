@@ -8,7 +8,14 @@
 
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
 #include "User.h"
+#include "Crypto.h"
+#include "SessionTable.h"
+#include "RoleManager.h"
 
 /**
  * @class UserManager
@@ -19,6 +26,18 @@
  * - Автентифікацію (перевірку логіна та пароля).
  * - Адміністрування (додавання нових користувачів, видалення існуючих).
  * - Забезпечення наявності хоча б одного адміністратора в системі.
+ *
+ * Пошук користувача за логіном виконується через хеш-індекс (O(1)).
+ * Видалення не зсуває вектор: запис лише позначається як видалений
+ * (tombstone), а вектор ущільнюється, коли таких записів стає забагато.
+ *
+ * Паролі зберігаються як PBKDF2-HMAC-SHA256 з випадковою сіллю. Кількість
+ * ітерацій підбирається під час запуску (CalibrateCost) під бажану затримку.
+ * Успішні входи короткий час кешуються, щоб повторна перевірка того самого
+ * пароля (пакетна обробка, серверна сесія) не платила повну вартість KDF.
+ *
+ * Для скриптів і серверних клієнтів є сесії: OpenSession перевіряє пароль
+ * один раз і видає токен, а ValidateSession далі перевіряє лише токен.
  */
 class UserManager {
 private:
@@ -27,21 +46,180 @@ private:
      */
     std::vector<User> users;
 
+    /**
+     * @brief Позначки видалених записів (паралельно до users).
+     */
+    std::vector<bool> removed;
+
+    /**
+     * @brief Індекс: логін -> позиція у векторі users.
+     */
+    std::unordered_map<std::string, size_t> index;
+
+    /**
+     * @brief Кількість видалених, але ще не прибраних записів.
+     */
+    size_t tombstones = 0;
+
+    /**
+     * @brief Поточна вартість хешування (кількість ітерацій PBKDF2) для нових паролів.
+     */
+    uint32_t hashIterations = kDefaultIterations;
+
+    /**
+     * @brief Запис кешу підтверджених входів.
+     */
+    struct VerifiedLogin {
+        /** @brief HMAC від (логін, пароль, запис пароля) на секретному ключі процесу. */
+        Crypto::Digest proof;
+        /** @brief Момент, після якого запис недійсний. */
+        std::chrono::steady_clock::time_point expires;
+    };
+
+    /**
+     * @brief Кеш підтверджених входів (логін -> доказ).
+     * Сам пароль не зберігається.
+     */
+    mutable std::unordered_map<std::string, VerifiedLogin> verified;
+
+    /**
+     * @brief Захищає кеш, бо Authenticate може викликатись з кількох потоків.
+     */
+    mutable std::mutex verifiedMutex;
+
+    /**
+     * @brief Час життя запису кешу.
+     */
+    std::chrono::seconds verifiedTtl{300};
+
+    /**
+     * @brief Випадковий ключ процесу для доказів у кеші.
+     */
+    std::string cacheSecret;
+
+    /**
+     * @brief Ролі та їхні маски прав (roles.txt).
+     */
+    RoleManager roles;
+
+    /**
+     * @brief Таблиця відкритих сесій.
+     */
+    SessionTable sessions;
+
     /**
      * @brief Шлях до файлу з обліковими даними.
      */
     std::string filePath;
 
+    /**
+     * @brief Додає запис у кінець вектора та індексу (без перевірки унікальності).
+     * Маска прав компілюється з ролі тут, один раз.
+     */
+    void Append(const User &user);
+
+    /**
+     * @brief Прибирає видалені записи та перебудовує індекс.
+     * Викликається, коли видалені записи займають більше половини вектора.
+     */
+    void Compact();
+
+    /**
+     * @brief Створює запис пароля з новою сіллю та поточною вартістю.
+     * @param password Пароль у відкритому вигляді.
+     * @return Рядок "pbkdf2-sha256$ітерації$сіль$хеш".
+     */
+    std::string HashPassword(const std::string &password) const;
+
+    /**
+     * @brief Створює запис пароля з новою сіллю і заданою вартістю.
+     * @param password Пароль у відкритому вигляді.
+     * @param iterations Кількість ітерацій PBKDF2.
+     * @return Рядок "pbkdf2-sha256$ітерації$сіль$хеш".
+     */
+    static std::string HashPassword(const std::string &password, uint32_t iterations);
+
+    /**
+     * @brief Хешує паролі паралельно на всіх ядрах за поточною вартістю.
+     * @param passwords Паролі у відкритому вигляді; замінюються їхніми записами.
+     */
+    void HashPasswords(std::vector<std::string> &passwords) const;
+
+    /**
+     * @brief Перевіряє пароль за записом (повне обчислення PBKDF2).
+     * @param record Запис пароля.
+     * @param password Введений пароль.
+     * @return true, якщо пароль правильний.
+     */
+    static bool VerifyPassword(const std::string &record, const std::string &password);
+
+    /**
+     * @brief Перевіряє, чи є рядок записом хешу (а не старим відкритим паролем).
+     */
+    static bool IsHashed(const std::string &record);
+
+    /**
+     * @brief Обчислює доказ для кешу підтверджених входів.
+     */
+    Crypto::Digest LoginProof(const User &user, const std::string &password) const;
+
 public:
+    /**
+     * @brief Вартість хешування до калібрування.
+     */
+    static constexpr uint32_t kDefaultIterations = 100000;
+
+    /**
+     * @brief Мінімальна допустима вартість хешування.
+     */
+    static constexpr uint32_t kMinIterations = 10000;
+
     /**
      * @brief Конструктор.
      * @param filePath Шлях до файлу користувачів.
+     * @param rolesPath Шлях до файлу ролей.
+     */
+    explicit UserManager(const std::string &filePath,
+                         const std::string &rolesPath = "roles.txt");
+
+    /**
+     * @brief Підбирає кількість ітерацій PBKDF2 під бажану затримку перевірки.
+     *
+     * Вимірює швидкість хешування на цій машині і встановлює вартість,
+     * за якої одна перевірка пароля триває приблизно targetMillis.
+     * @param targetMillis Бажана тривалість однієї перевірки, мс.
+     * @return Обрана кількість ітерацій.
+     */
+    uint32_t CalibrateCost(double targetMillis);
+
+    /**
+     * @brief Поточна вартість хешування для нових паролів.
+     */
+    uint32_t GetHashIterations() const;
+
+    /**
+     * @brief Вимірює, скільки перевірок пароля за секунду витримує машина.
+     *
+     * threads потоків перевіряють один запис заданої вартості повним
+     * обчисленням PBKDF2 (без кешу входів), доки не мине duration, але
+     * щонайменше двічі кожен.
+     * @param iterations Кількість ітерацій PBKDF2.
+     * @param threads Кількість потоків.
+     * @param duration Тривалість виміру.
+     * @return Перевірок за секунду на всіх потоках разом.
+     */
+    static double MeasureLoginRate(uint32_t iterations, size_t threads, std::chrono::milliseconds duration);
+
+    /**
+     * @brief Задає час життя кешу підтверджених входів (0 — вимкнути кеш).
+     * @param ttl Тривалість.
      */
-    explicit UserManager(const std::string &filePath);
+    void SetVerificationCacheTtl(std::chrono::seconds ttl);
 
     /**
-     * @brief Завантажує дані користувачів із файлу.
-     * Парсить формат "логін:пароль:роль".
+     * @brief Завантажує ролі та дані користувачів із файлів.
+     * Парсить формат "логін:хеш:роль"; роль одразу компілюється у маску прав. Старі записи з відкритим паролем
+     * одразу хешуються і файл перезаписується.
      */
     void Load();
 
@@ -68,20 +246,71 @@ public:
                       const std::string &password,
                       User &outUser) const;
 
+    /**
+     * @brief Виконує вхід без копіювання даних користувача.
+     * @param login Введений логін.
+     * @param password Введений пароль.
+     * @return Вказівник на користувача або nullptr. Дійсний до наступної зміни списку.
+     */
+    const User *Authenticate(const std::string &login,
+                             const std::string &password) const;
+
+    /**
+     * @brief Шукає користувача за логіном.
+     * @param username Логін.
+     * @return Вказівник на користувача або nullptr. Дійсний до наступної зміни списку.
+     */
+    const User *FindUser(const std::string &username) const;
+
+    /**
+     * @brief Виконує вхід і відкриває сесію.
+     * @param login Введений логін.
+     * @param password Введений пароль.
+     * @return Токен сесії або порожній рядок (невірні дані чи таблиця переповнена).
+     */
+    std::string OpenSession(const std::string &login, const std::string &password);
+
+    /**
+     * @brief Перевіряє токен сесії без звернення до списку користувачів.
+     * @param token Токен.
+     * @param out Логін і маска прав власника сесії.
+     * @return true, якщо сесія дійсна.
+     */
+    bool ValidateSession(const std::string &token, Session &out) const;
+
+    /**
+     * @brief Закриває сесію (вихід).
+     * @param token Токен.
+     * @return true, якщо сесію знайдено.
+     */
+    bool CloseSession(const std::string &token);
+
     /**
      * @brief Реєструє нового користувача.
      * @param username Бажаний логін.
-     * @param password Бажаний пароль.
-     * @param role Роль ("user" або "admin").
-     * @return true, якщо користувача успішно додано (логін унікальний).
+     * @param password Бажаний пароль (буде збережено лише його хеш).
+     * @param role Роль (має існувати у файлі ролей).
+     * @return true, якщо користувача успішно додано (логін унікальний, роль відома).
      */
     bool AddUser(const std::string &username,
                  const std::string &password,
                  const std::string &role);
 
+    /**
+     * @brief Пакетно реєструє користувачів і зберігає файл один раз.
+     *
+     * Записи з логіном, що вже існує (або повторюється в пакеті), та з
+     * невідомою роллю пропускаються.
+     * Паролі хешуються паралельно на всіх ядрах.
+     * @param batch Список нових користувачів (пароль у відкритому вигляді).
+     * @return Кількість доданих користувачів.
+     */
+    size_t AddUsers(const std::vector<User> &batch);
+
     /**
      * @brief Видаляє користувача із системи.
      * @note Не дозволяє видалити користувача з логіном "admin".
+     * Усі сесії користувача закриваються.
      * @param username Логін користувача, якого треба видалити.
      * @return true, якщо видалення успішне.
      */
@@ -90,9 +319,14 @@ public:
     /**
      * @brief Отримує список усіх користувачів.
      * Використовується для виводу таблиці користувачів в меню адміністратора.
-     * @return Константне посилання на вектор користувачів.
+     * @return Вказівники на користувачів (без видалених) у порядку реєстрації.
+     */
+    std::vector<const User *> GetUsers() const;
+
+    /**
+     * @brief Доступ до ролей (для виводу та перевірки назв ролей).
      */
-    const std::vector<User> &GetUsers() const;
+    const RoleManager &GetRoles() const;
 };
 
 #endif //KURSOVA_USERMANAGER_H
\ No newline at end of file
@@ -8,7 +8,10 @@
  */
 
 #include "Utils.h"
+#include "Simd.h"
 #include <algorithm>
+#include <cctype>
+#include <cstdint>
 #include <locale>
 #include <codecvt>
 
@@ -61,6 +64,230 @@ namespace Utils {
         return conv.to_bytes(ws);
     }
 
+    // -----------------------------------------------------------
+    //  UTF-8 Fold (без локалі)
+    // -----------------------------------------------------------
+
+    /**
+     * @brief Перевіряє, чи починається з позиції i велика кирилична літера.
+     *
+     * U+0400–U+043F кодуються як 0xD0 0x80–0xBF (великі — 0x80–0xAF),
+     * "Ґ" (U+0490) — як 0xD2 0x90.
+     */
+    static bool IsCyrillicUpper(const char *data, size_t size, size_t i) {
+        if (i + 1 >= size) return false;
+        auto lead = static_cast<unsigned char>(data[i]);
+        auto next = static_cast<unsigned char>(data[i + 1]);
+        return (lead == 0xD0 && next >= 0x80 && next <= 0xAF) ||
+               (lead == 0xD2 && next == 0x90);
+    }
+
+    /**
+     * @brief Зводить велику кириличну літеру, що починається з at, до малої.
+     *
+     * Довжина літери в UTF-8 не змінюється, тому заміна робиться на місці.
+     * @param at Перший байт літери, для якої IsCyrillicUpper повернула true.
+     */
+    static void LowerCyrillicAt(char *at) {
+        auto next = static_cast<unsigned char>(at[1]);
+        if (static_cast<unsigned char>(at[0]) == 0xD2) {
+            // Ґ -> ґ
+            at[1] = static_cast<char>(0x91);
+        } else if (next <= 0x8F) {
+            // Ѐ..Џ (Є, І, Ї) -> ѐ..џ
+            at[0] = static_cast<char>(0xD1);
+            at[1] = static_cast<char>(next + 0x10);
+        } else if (next <= 0x9F) {
+            // А..П -> а..п
+            at[1] = static_cast<char>(next + 0x20);
+        } else {
+            // Р..Я -> р..я
+            at[0] = static_cast<char>(0xD1);
+            at[1] = static_cast<char>(next - 0x20);
+        }
+    }
+
+    /**
+     * @brief Приводить рядок до нижнього регістру (латиниця та кирилиця).
+     *
+     * Працює напряму з байтами UTF-8 і не залежить від системної локалі,
+     * тому значно швидша за ToLowerUTF8. Інші алфавіти (Latin-1, грецька)
+     * лишаються як є — див. Utils.h.
+     * @param s Вхідний рядок.
+     * @return Рядок у нижньому регістрі.
+     */
+    std::string FoldUTF8(const std::string &s) {
+        std::string res;
+        res.reserve(s.size());
+        FoldTo(res, s);
+        return res;
+    }
+
+    /**
+     * @brief Дописує рядок у нижньому регістрі в кінець res.
+     * @param res Буфер викликача (наприклад, локальний буфер потоку).
+     * @param s Вхідний рядок.
+     */
+    void FoldTo(std::string &res, const std::string &s) {
+        FoldTo(res, s.data(), s.size());
+    }
+
+    /**
+     * @brief Копіює текст у кінець res і зводить регістр на місці.
+     *
+     * Велика літера займає стільки ж байтів, скільки мала, тож довжина не
+     * змінюється і рядок не росте по одному символу.
+     * @param res Буфер викликача.
+     * @param data Початок тексту.
+     * @param size Довжина тексту.
+     */
+    void FoldTo(std::string &res, const char *data, size_t size) {
+        const size_t base = res.size();
+        res.append(data, size);
+        char *out = &res[0] + base;
+        for (size_t i = 0; i < size; ++i) {
+            auto c = static_cast<unsigned char>(out[i]);
+            if (c >= 'A' && c <= 'Z') {
+                out[i] = static_cast<char>(c + ('a' - 'A'));
+            } else if (IsCyrillicUpper(data, size, i)) {
+                LowerCyrillicAt(out + i);
+                ++i;
+            }
+        }
+    }
+
+    /**
+     * @brief Зводить великі кириличні літери на місці.
+     *
+     * Від літери до літери текст проглядає Simd::FindCyrillicUpper, тож
+     * малі літери й латиниця пропускаються цілими векторами.
+     * @param data Початок тексту.
+     * @param size Довжина тексту.
+     */
+    void FoldCyrillicInPlace(char *data, size_t size) {
+        size_t i = Simd::FindCyrillicUpper(data, size);
+        while (i < size) {
+            LowerCyrillicAt(data + i);
+            i += 2;
+            i += Simd::FindCyrillicUpper(data + i, size - i);
+        }
+    }
+
+    /**
+     * @brief Повертає тіньову копію для пошуку лише тоді, коли вона потрібна.
+     * @param s Вхідний рядок.
+     * @return FoldUTF8(s) або порожній рядок.
+     */
+    std::string FoldShadow(const std::string &s) {
+        return HasCyrillicUpper(s.data(), s.size()) ? FoldUTF8(s) : "";
+    }
+
+    /**
+     * @brief Шукає першу велику кириличну літеру.
+     * @param data Початок тексту (UTF-8).
+     * @param size Довжина тексту.
+     * @return true, якщо така літера є.
+     */
+    bool HasCyrillicUpper(const char *data, size_t size) {
+        return Simd::FindCyrillicUpper(data, size) != size;
+    }
+
+    // -----------------------------------------------------------
+    //  Words
+    // -----------------------------------------------------------
+
+    /**
+     * @brief Перевіряє, чи належить символ UTF-8 з позиції i слову.
+     * @param s Рядок.
+     * @param i Позиція першого байта символу.
+     * @param length Куди записати довжину символу в байтах.
+     */
+    static bool IsWordChar(const std::string &s, size_t i, size_t &length) {
+        auto c = static_cast<unsigned char>(s[i]);
+        if (c < 0x80) {
+            length = 1;
+            return std::isalnum(c) || c == '\'' || c == '_';
+        }
+
+        length = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 1;
+        if (i + length > s.size()) {
+            length = s.size() - i;
+            return false;
+        }
+
+        uint32_t cp = 0;
+        if (length == 2) cp = ((c & 0x1Fu) << 6) | (s[i + 1] & 0x3Fu);
+        else if (length == 3) cp = ((c & 0x0Fu) << 12) | ((s[i + 1] & 0x3Fu) << 6) | (s[i + 2] & 0x3Fu);
+        else if (length == 4) return true;
+
+        // Апострофи U+2019 і U+02BC — частина українських слів
+        if (cp == 0x2019 || cp == 0x02BC) return true;
+        if (cp >= 0x00A0 && cp <= 0x00BF) return false;
+        if (cp >= 0x2000 && cp <= 0x206F) return false;
+        return length > 1;
+    }
+
+    /**
+     * @brief Виділяє унікальні слова тексту в нижньому регістрі.
+     * @param s Вхідний рядок.
+     * @return Слова у порядку першої появи.
+     */
+    std::vector<std::string> SplitWords(const std::string &s) {
+        std::vector<std::string> words;
+        std::string folded = FoldUTF8(s);
+
+        size_t start = std::string::npos;
+        for (size_t i = 0; i <= folded.size();) {
+            size_t length = 1;
+            bool inWord = i < folded.size() && IsWordChar(folded, i, length);
+            if (inWord && start == std::string::npos) start = i;
+            if (!inWord && start != std::string::npos) {
+                std::string word = folded.substr(start, i - start);
+                if (std::find(words.begin(), words.end(), word) == words.end()) {
+                    words.push_back(std::move(word));
+                }
+                start = std::string::npos;
+            }
+            i += length;
+        }
+        return words;
+    }
+
+    /**
+     * @brief Декодує UTF-8 у кодові точки.
+     *
+     * Перевіряється лише структура послідовності (провідний байт і байти
+     * продовження); цього достатньо для порівняння назв посимвольно.
+     * @param s Вхідний рядок.
+     * @return Кодові точки; некоректні байти — U+FFFD.
+     */
+    std::u32string DecodeUTF8(const std::string &s) {
+        std::u32string out;
+        out.reserve(s.size());
+
+        for (size_t i = 0; i < s.size();) {
+            auto c = static_cast<unsigned char>(s[i]);
+            size_t length = c < 0x80 ? 1 : c < 0xC2 ? 0 : c < 0xE0 ? 2 : c < 0xF0 ? 3 : c < 0xF5 ? 4 : 0;
+            uint32_t cp = length == 4 ? (c & 0x07u) : length == 3 ? (c & 0x0Fu) : length == 2 ? (c & 0x1Fu) : c;
+
+            bool valid = length > 0 && i + length <= s.size();
+            for (size_t k = 1; valid && k < length; ++k) {
+                auto next = static_cast<unsigned char>(s[i + k]);
+                valid = (next & 0xC0u) == 0x80u;
+                cp = (cp << 6) | (next & 0x3Fu);
+            }
+
+            if (valid) {
+                out.push_back(cp);
+                i += length;
+            } else {
+                out.push_back(0xFFFD);
+                i++;
+            }
+        }
+        return out;
+    }
+
     // -----------------------------------------------------------
     //  Trim
     // -----------------------------------------------------------
@@ -97,6 +324,10 @@ namespace Utils {
      * Враховує механізм екранування: якщо перед роздільником стоїть '\',
      * він вважається частиною тексту, а не роздільником.
      *
+     * Замість посимвольного копіювання шукає наступний роздільник або '\'
+     * векторною функцією Simd::FindEither і дописує весь фрагмент між ними
+     * одним викликом append.
+     *
      * @param s Вхідний рядок.
      * @param delim Символ-роздільник.
      * @return Вектор рядків.
@@ -104,25 +335,26 @@ namespace Utils {
     std::vector<std::string> Split(const std::string &s, char delim) {
         std::vector<std::string> result;
         std::string current;
-        bool escaped = false; // Прапорець стану екранування
-
-        for (char ch : s) {
-            if (escaped) {
-                // Якщо попередній символ був '\', то поточний додаємо як звичайний символ
-                current.push_back(ch);
-                escaped = false;
-            } else if (ch == '\\') {
-                // Знайшли екрануючий символ, встановлюємо прапорець
-                escaped = true;
-                // Додаємо сам слеш, щоб Unescape міг його потім обробити
-                current.push_back(ch);
-            } else if (ch == delim) {
+        const char *data = s.data();
+        size_t n = s.size();
+        size_t i = 0;
+
+        while (i < n) {
+            size_t hit = i + Simd::FindEither(data + i, n - i, delim, '\\');
+            // Звичайні символи до роздільника або слеша копіюємо одним блоком
+            current.append(data + i, hit - i);
+            if (hit == n) break;
+
+            if (data[hit] == '\\') {
+                // Екранування: залишаємо слеш (для Unescape) і наступний символ як текст
+                current.push_back('\\');
+                if (hit + 1 < n) current.push_back(data[hit + 1]);
+                i = hit + 2;
+            } else {
                 // Знайшли роздільник (не екранований) -> завершуємо поточну частину
                 result.push_back(current);
                 current.clear();
-            } else {
-                // Звичайний символ
-                current.push_back(ch);
+                i = hit + 1;
             }
         }
 
@@ -131,6 +363,23 @@ namespace Utils {
         return result;
     }
 
+    /**
+     * @brief Пропускає екрановані символи і зупиняється на першому вільному роздільнику.
+     * @param data Початок тексту.
+     * @param size Довжина тексту.
+     * @param delim Роздільник.
+     * @return Позиція роздільника або size.
+     */
+    size_t FindUnescaped(const char *data, size_t size, char delim) {
+        size_t i = 0;
+        while (i < size) {
+            size_t hit = i + Simd::FindEither(data + i, size - i, delim, '\\');
+            if (hit == size || data[hit] == delim) return hit;
+            i = hit + 2;
+        }
+        return size;
+    }
+
     // -----------------------------------------------------------
     //  Join
     // -----------------------------------------------------------
@@ -164,14 +413,28 @@ namespace Utils {
     std::string Escape(const std::string &s) {
         std::string res;
         res.reserve(s.size() + 5); // Резервуємо трохи більше пам'яті для оптимізації
+        EscapeTo(res, s);
+        return res;
+    }
 
-        for (char ch : s) {
+    /**
+     * @brief Дописує екранований рядок у буфер.
+     *
+     * Фрагменти без спецсимволів копіюються блоками.
+     * @param out Буфер викликача.
+     * @param s Вхідний рядок.
+     */
+    void EscapeTo(std::string &out, const std::string &s) {
+        size_t start = 0;
+        for (size_t i = 0; i < s.size(); ++i) {
+            char ch = s[i];
             if (ch == ';' || ch == ',' || ch == '\\') {
-                res.push_back('\\');
+                out.append(s, start, i - start);
+                out.push_back('\\');
+                start = i;
             }
-            res.push_back(ch);
         }
-        return res;
+        out.append(s, start, std::string::npos);
     }
 
     // -----------------------------------------------------------
@@ -181,29 +444,37 @@ namespace Utils {
     /**
      * @brief Відновлює початковий вигляд екранованого рядка.
      *
-     * Замінює "\;" на ";", "\," на "," тощо.
+     * Замінює "\;" на ";", "\," на "," тощо. Фрагменти між слешами
+     * копіюються блоками (пошук слеша — Simd::FindEither).
      * @param s Екранований рядок з файлу.
      * @return Оригінальний текст.
      */
     std::string Unescape(const std::string &s) {
         std::string res;
-        res.reserve(s.size());
+        UnescapeTo(res, s.data(), s.size());
+        return res;
+    }
 
-        bool esc = false;
-        for (char ch : s) {
-            if (esc) {
-                // Якщо був прапорець escape, просто додаємо символ (пропускаючи слеш)
-                res.push_back(ch);
-                esc = false;
-            } else if (ch == '\\') {
-                // Знайшли слеш, вмикаємо режим escape, але сам слеш не пишемо
-                esc = true;
-            } else {
-                // Звичайний символ
-                res.push_back(ch);
-            }
+    /**
+     * @brief Розекрановує фрагмент прямо в буфер викликача.
+     * @param out Буфер викликача.
+     * @param data Екранований текст.
+     * @param size Довжина тексту.
+     */
+    void UnescapeTo(std::string &out, const char *data, size_t size) {
+        out.reserve(out.size() + size);
+        size_t i = 0;
+
+        while (i < size) {
+            // Шукаємо наступний слеш; усе до нього копіюємо одним блоком
+            size_t hit = i + Simd::FindEither(data + i, size - i, '\\', '\\');
+            out.append(data + i, hit - i);
+            if (hit == size) break;
+
+            // Сам слеш пропускаємо, наступний символ додаємо як є
+            if (hit + 1 < size) out.push_back(data[hit + 1]);
+            i = hit + 2;
         }
-        return res;
     }
 
-}
\ No newline at end of file
+}
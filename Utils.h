@@ -37,6 +37,79 @@ namespace Utils {
      */
     std::string ToLowerUTF8(const std::string &s);
 
+    /**
+     * @brief Швидко приводить рядок до нижнього регістру без використання локалі.
+     * @details Обробляє лише ASCII A–Z і кирилицю U+0400–U+042F (включно з "Є", "І",
+     * "Ї") та "Ґ". Решта символів копіюється без змін, тож, на відміну від
+     * ToLowerUTF8, літери Latin-1 ("É"), грецькі та інші великі літери не
+     * зводяться: пошук за назвою, індекси, сортування і пошук у визначеннях для
+     * них чутливі до регістру.
+     * @param s Вхідний рядок (UTF-8).
+     * @return Рядок у нижньому регістрі.
+     */
+    std::string FoldUTF8(const std::string &s);
+
+    /**
+     * @brief Те саме, що FoldUTF8, але дописує результат у кінець out.
+     * @param out Буфер викликача.
+     * @param s Вхідний рядок (UTF-8).
+     */
+    void FoldTo(std::string &out, const std::string &s);
+
+    /**
+     * @brief Те саме для тексту, заданого початком і довжиною (наприклад, поля у відображеному файлі).
+     * @param out Буфер викликача.
+     * @param data Початок тексту (UTF-8).
+     * @param size Довжина тексту.
+     */
+    void FoldTo(std::string &out, const char *data, size_t size);
+
+    /**
+     * @brief Зводить на місці лише великі кириличні літери.
+     * @details Для буферів, які викликач може змінювати (розкодоване чи розекрановане
+     * визначення): без копії та без окремої перевірки HasCyrillicUpper. Латиниця
+     * лишається як є — її зводить Simd::FindFolded під час пошуку.
+     * @param data Початок тексту (UTF-8).
+     * @param size Довжина тексту.
+     */
+    void FoldCyrillicInPlace(char *data, size_t size);
+
+    /**
+     * @brief Будує "тіньову" копію тексту для пошуку, якщо вона потрібна.
+     * @details Латиниця приводиться до нижнього регістру прямо під час пошуку
+     * (Simd::FindFolded), тому копія потрібна лише тоді, коли в тексті є великі
+     * кириличні літери.
+     * @param s Вхідний рядок (UTF-8).
+     * @return FoldUTF8(s) або порожній рядок, якщо копія не потрібна.
+     */
+    std::string FoldShadow(const std::string &s);
+
+    /**
+     * @brief Чи є в тексті великі кириличні літери (тобто чи потрібна тіньова копія).
+     * @param data Початок тексту (UTF-8).
+     * @param size Довжина тексту.
+     * @return true, якщо Simd::FindFolded без FoldTo пропустить збіг.
+     */
+    bool HasCyrillicUpper(const char *data, size_t size);
+
+    /**
+     * @brief Розбиває текст на слова для індексу слів і запитів def:.
+     * @details Слова приводяться до нижнього регістру (FoldUTF8) і не повторюються.
+     * Роздільники — пробіли, ASCII-пунктуація (зокрема '-'), типографські знаки
+     * U+00A0–U+00BF і U+2000–U+206F. Апострофи (', ’, ʼ) належать слову.
+     * @param s Вхідний рядок (UTF-8).
+     * @return Слова у порядку першої появи.
+     */
+    std::vector<std::string> SplitWords(const std::string &s);
+
+    /**
+     * @brief Розкладає рядок UTF-8 на кодові точки.
+     * @details Некоректний байт стає символом U+FFFD, решта рядка декодується далі.
+     * @param s Вхідний рядок (UTF-8).
+     * @return Кодові точки.
+     */
+    std::u32string DecodeUTF8(const std::string &s);
+
     /**
      * @brief Видаляє пробіли з початку та кінця рядка.
      * @param s Вхідний рядок.
@@ -54,6 +127,15 @@ namespace Utils {
      */
     std::vector<std::string> Split(const std::string &s, char delim);
 
+    /**
+     * @brief Шукає перший неекранований роздільник (за тими ж правилами, що й Split).
+     * @param data Початок тексту.
+     * @param size Довжина тексту.
+     * @param delim Символ-роздільник.
+     * @return Позиція роздільника або size, якщо його немає.
+     */
+    size_t FindUnescaped(const char *data, size_t size, char delim);
+
     /**
      * @brief Об'єднує вектор рядків в один рядок.
      * @param parts Вектор частин.
@@ -70,6 +152,13 @@ namespace Utils {
      */
     std::string Escape(const std::string &s);
 
+    /**
+     * @brief Дописує екранований рядок у кінець out (без проміжних рядків).
+     * @param out Буфер викликача.
+     * @param s Вхідний рядок.
+     */
+    void EscapeTo(std::string &out, const std::string &s);
+
     /**
      * @brief Прибирає екранування (відновлює початковий рядок).
      * @param s Екранований рядок з файлу.
@@ -77,6 +166,14 @@ namespace Utils {
      */
     std::string Unescape(const std::string &s);
 
+    /**
+     * @brief Дописує розекранований фрагмент у кінець out (без проміжних рядків).
+     * @param out Буфер викликача.
+     * @param data Екранований текст (наприклад, поле у відображеному файлі).
+     * @param size Довжина тексту.
+     */
+    void UnescapeTo(std::string &out, const char *data, size_t size);
+
 }
 
 #endif //KURSOVA_UTILS_H
\ No newline at end of file
@@ -6,10 +6,22 @@
  * обробку вводу користувача та виклики менеджерів (TermManager, UserManager).
  */
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <limits>
 #include <memory>
+#include <fstream>
+#include <cstdlib>
+#include <cstring>
+#include <csignal>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iterator>
+#include <random>
+#include <thread>
+#include <vector>
 
 #ifdef _WIN32
 #include <windows.h> // Для налаштування кодування консолі у Windows
@@ -20,11 +32,33 @@
 #include "Term.h"
 #include "PrimitiveTerm.h"
 #include "Utils.h"
+#include "BatchRunner.h"
+#include "QueryServer.h"
+#include "HttpServer.h"
+#include "LoadClient.h"
+#include "IoRing.h"
+#include "ShardStore.h"
+#include "Metrics.h"
+#include "Simd.h"
+#include "Crypto.h"
 
 // ----------------------------------------------------------
 // СЛУЖБОВІ ФУНКЦІЇ
 // ----------------------------------------------------------
 
+/** @brief Файл бази термінів. */
+static const char *kTermsFile = "terms.csv";
+
+/** @brief Каталог бази термінів, розбитої на шарди (див. --shard). */
+static const char *kTermsDirectory = "terms.d";
+
+/**
+ * @brief Шлях до бази: каталог шардів, якщо він є, інакше terms.csv.
+ */
+static std::string TermsPath() {
+    return ShardStore::IsDirectory(kTermsDirectory) ? kTermsDirectory : kTermsFile;
+}
+
 /**
  * @brief Зупиняє виконання програми до натискання клавіші Enter.
  *
@@ -79,7 +113,8 @@ void ShowHelp() {
 
     << "Усі дані зберігаються у форматі CSV/TXT:\n"
     << " • terms.csv — база термінів (назва;визначення;посилання)\n"
-    << " • users.txt — список користувачів із ролями (admin/user)\n\n"
+    << " • users.txt — список користувачів із ролями (admin/user), паролі зберігаються як хеші\n"
+    << " • roles.txt — ролі та їхні права (admin, user, editor, auditor; можна додавати свої)\n\n"
 
     << "=============================== ПРАВИЛА ВВЕДЕННЯ ===============================\n"
     << "1. Назва терміна і визначення не можуть бути порожніми.\n"
@@ -87,8 +122,10 @@ void ShowHelp() {
     << "3. Пошук нечутливий до регістру — 'клас' і 'КЛАС' сприймаються однаково.\n"
     << "4. Посилання для складних термінів вводяться через кому: Клас,Об'єкт,Метод.\n"
     << "5. Термін не може мати визначення, ідентичне своїй назві.\n"
-    << "6. Додавання, редагування та видалення термінів доступні тільки адміністраторам.\n"
-    << "7. Для коректного збереження змін завершуйте роботу через пункт меню '0'.\n\n"
+    << "6. Додавання, редагування та видалення термінів залежать від прав ролі\n"
+    << "   (за замовчуванням — admin та editor).\n"
+    << "7. Зміни записуються у файл у фоні (не пізніше ніж за секунду); щоб нічого\n"
+    << "   не втратити, завершуйте роботу через пункт меню '0'.\n\n"
 
     << "=============================== СТАРТОВЕ МЕНЮ ==================================\n"
     << "1. Увійти                   - Вхід у систему за логіном і паролем.\n"
@@ -102,6 +139,9 @@ void ShowHelp() {
     << "1.  Список термінів (коротко)      - Показує лише назви PRIM і TERM.\n"
     << "2.  Список термінів (повний)       - Виводить назву, визначення і посилання.\n"
     << "3.  Пошук за назвою                - Пошук терміна незалежно від регістру.\n"
+    << "                                     Tab або * в кінці назви показує підказки;\n"
+    << "                                     якщо термін не знайдено — схожі назви\n"
+    << "                                     (одруківки до 2 символів) і продовження.\n"
     << "4.  Пошук у визначеннях            - Пошук за фрагментом тексту визначення.\n"
     << "5.  [ADMIN] Додати термін          - Додавання PRIM або TERM.\n"
     << "6.  [ADMIN] Редагувати визначення  - Зміна існуючого визначення.\n"
@@ -110,7 +150,12 @@ void ShowHelp() {
     << "9.  [ADMIN] Сортувати за визначенням - Алфавіт за текстом визначення.\n"
     << "10. Первинні терміни (PRIM)        - Показує лише первинні поняття.\n"
     << "11. Складні терміни (TERM)         - Показує терміни з посиланнями.\n"
-    << "12. Ланцюжок терміна               - Побудова дерева від терміна до основ.\n\n"
+    << "12. Ланцюжок терміна               - Побудова дерева від терміна до основ.\n"
+    << "15. Запит                          - Пошук за умовами, наприклад:\n"
+    << "      type:PRIM AND def:алгоритм NOT name:клас*     refs:Клас OR text:\"дані\"\n"
+    << "      Поля: name: (точна назва або префікс*), def: (слово або префікс*),\n"
+    << "      text: (фрагмент), type: (PRIM/TERM), refs: (посилання).\n"
+    << "      Префікс 'explain ' показує план виконання і кількість рядків.\n\n"
 
     << "--- АДМІНІСТРУВАННЯ (20) ------------------------------------------------------\n"
     << "20. [ADMIN] Користувачі             - Перегляд, додавання, видалення,\n"
@@ -119,7 +164,48 @@ void ShowHelp() {
     << "--- СЕРВІС -------------------------------------------------------------------\n"
     << "13. Допомога                        - Виводить цю інструкцію.\n"
     << "14. Статистика                      - Кількість термінів, PRIM/TERM.\n"
-    << "0.  Вихід                           - Збереження всіх даних і вихід.\n"
+    << "16. Статистика операцій             - Кількість викликів і час (p50/p99)\n"
+    << "                                      завантаження, збереження, пошуків,\n"
+    << "                                      сортувань, ланцюжків і входів; запис у\n"
+    << "                                      файл JSON (*.json) або Prometheus.\n"
+    << "0.  Вихід                           - Збереження всіх даних і вихід.\n\n"
+
+    << "============================== ПАКЕТНИЙ РЕЖИМ =================================\n"
+    << "Kursova --batch <файл|->  - виконує команди зі скрипта (або stdin) без меню:\n"
+    << "  login;логін;пароль   find;назва   search;фрагмент   chain;назва   stats\n"
+    << "  complete;префікс[;кількість]   suggest;назва[;кількість]   query;[explain ]запит\n"
+    << "  add;PRIM;назва;визначення   add;TERM;назва;визначення;пос1,пос2\n"
+    << "  edit;назва;визначення   remove;назва   export;шлях   checkpoint\n"
+    << "Результати: рядки '<номер>\\tOK|ROW|ERR\\t<команда>\\t...'. Для query;explain\n"
+    << "рядки ROW мають поле 'plan' (рядок плану) або 'term' (назва). Зміни зберігаються\n"
+    << "на checkpoint і наприкінці скрипта.\n\n"
+
+    << "============================== СЕРВЕР ЗАПИТІВ =================================\n"
+    << "Kursova --serve <сокет>   - тримає базу в пам'яті й відповідає на команди читання\n"
+    << "  find/complete/suggest/search/chain/stats/query через Unix-сокет (формат вище).\n"
+    << "Kursova --http <порт>     - JSON API на http://127.0.0.1:<порт>/ (keep-alive):\n"
+    << "  /terms/<назва>   /search?q=<фрагмент>   /chain/<назва>   /stats\n"
+    << "  /complete?q=<префікс>[&limit=N]   /query?q=<запит>[&explain=1]\n"
+    << "Kursova --load <сокет> [з'єднань] [запитів] [глибина] - генератор навантаження:\n"
+    << "  пропускна здатність і затримки p50/p99 (--load-http <порт> ... — для HTTP).\n"
+    << "Kursova --shard [шардів]  - переносить terms.csv у каталог terms.d (16 шардів):\n"
+    << "  шарди читаються паралельно, а збереження переписує лише змінені.\n"
+    << "Kursova --io-bench [файл] [повторів] - час завантаження і збереження бази через\n"
+    << "  POSIX та io_uring. KURSOVA_IO=uring вмикає io_uring для всіх режимів.\n"
+    << "Kursova --bench-split [рядків] [повторів] [зерно] - звіряє розбір рядків CSV\n"
+    << "  (Split/Unescape) з посимвольним еталоном на випадкових даних і міряє МБ/с.\n"
+    << "KursovaBench [файл] [повторів] - окрема програма: виділення пам'яті на збережений\n"
+    << "  термін, окремо для SerializeTo і для всього запису файлу (0 для SerializeTo — норма).\n"
+    << "Kursova --bench-login [мс на вимір] - входів/с на одному потоці й на всіх ядрах\n"
+    << "  для кількох вартостей PBKDF2 і для підібраної під ~50 мс на вхід.\n"
+    << "KURSOVA_LAZY=1 - визначення читаються з файлу лише при першому зверненні:\n"
+    << "  старт швидший і потребує менше пам'яті, пошук за словами переглядає базу.\n"
+    << "KURSOVA_MEMORY_MB=N - не більше N МБ прочитаних визначень (вмикає KURSOVA_LAZY):\n"
+    << "  давно не використані знову читаються з файлу; стан кешу - у статистиці.\n"
+    << "KURSOVA_COMPRESS=1 - визначення зберігаються в пам'яті стисненими таблицею\n"
+    << "  символів, навченою на базі; розкодовані копії - до KURSOVA_MEMORY_MB (4 МБ).\n"
+    << "KURSOVA_METRICS=<файл> - при завершенні будь-якого режиму записує статистику\n"
+    << "  операцій у файл (*.json — JSON, інакше текстовий формат Prometheus).\n"
     << "===============================================================================\n";
 
     Pause();
@@ -131,12 +217,14 @@ void ShowHelp() {
 // ----------------------------------------------------------
 
 /**
- * @brief Обробляє меню керування користувачами (тільки для Admin).
+ * @brief Обробляє меню керування користувачами.
  *
- * Дозволяє переглядати, додавати та видаляти користувачів.
+ * Дозволяє переглядати (право view_users), додавати та видаляти
+ * (право manage_users) користувачів.
+ * @param currentUser Поточний користувач (для перевірки прав).
  * @param userManager Посилання на менеджер користувачів.
  */
-void HandleAdminUserMenu(UserManager &userManager) {
+void HandleAdminUserMenu(const User &currentUser, UserManager &userManager) {
     while (true) {
         Banner("МЕНЮ АДМІНА — КОРИСТУВАЧІ");
         std::cout
@@ -144,6 +232,7 @@ void HandleAdminUserMenu(UserManager &userManager) {
             << "2. Додати користувача\n"
             << "3. Додати адміністратора\n"
             << "4. Видалити користувача\n"
+            << "5. Додати користувача з іншою роллю\n"
             << "0. Назад\n"
             << "Ваш вибір: ";
 
@@ -158,11 +247,17 @@ void HandleAdminUserMenu(UserManager &userManager) {
 
         if (choice == 0) return;
 
+        if (choice >= 2 && choice <= 5 && !currentUser.HasPermission(PermManageUsers)) {
+            std::cout << "Недостатньо прав.\n";
+            Pause();
+            continue;
+        }
+
         if (choice == 1) {
             Banner("СПИСОК КОРИСТУВАЧІВ");
-            for (auto &u : userManager.GetUsers()) {
-                std::cout << "- " << u.GetUsername()
-                          << "  (роль: " << u.GetRole() << ")\n";
+            for (const User *u : userManager.GetUsers()) {
+                std::cout << "- " << u->GetUsername()
+                          << "  (роль: " << u->GetRole() << ")\n";
             }
             Pause();
         }
@@ -213,6 +308,35 @@ void HandleAdminUserMenu(UserManager &userManager) {
             }
             Pause();
         }
+        else if (choice == 5) {
+            const RoleManager &roles = userManager.GetRoles();
+            std::cout << "Доступні ролі:\n";
+            for (const auto &name : roles.GetRoleNames()) {
+                std::cout << "- " << name << "  (" << RoleManager::Describe(roles.Compile(name)) << ")\n";
+            }
+
+            std::string login, pass, role;
+            std::cout << "Логін нового користувача: ";
+            std::getline(std::cin, login);
+            login = Utils::Trim(login);
+
+            std::cout << "Пароль: ";
+            std::getline(std::cin, pass);
+
+            std::cout << "Роль: ";
+            std::getline(std::cin, role);
+            role = Utils::Trim(role);
+
+            if (!roles.HasRole(role)) {
+                std::cout << "Невідома роль.\n";
+            } else if (userManager.AddUser(login, pass, role)) {
+                std::cout << "Користувача додано.\n";
+                userManager.Save();
+            } else {
+                std::cout << "Такий користувач вже існує.\n";
+            }
+            Pause();
+        }
         else {
             std::cout << "Невідомий пункт.\n";
             Pause();
@@ -224,6 +348,55 @@ void HandleAdminUserMenu(UserManager &userManager) {
 // ДОДАВАННЯ ТЕРМІНА
 // ----------------------------------------------------------
 
+/**
+ * @brief Пошук терміна за назвою з підказками.
+ *
+ * Якщо назва закінчується на Tab або '*', показує до 10 назв, що
+ * починаються з введеного тексту. Якщо термін не знайдено, спершу
+ * пропонує схожі назви (можлива одруківка), потім продовження введеного.
+ * Підказку можна вибрати за номером.
+ * @param termManager Посилання на менеджер термінів.
+ */
+void HandleFindByName(const TermManager &termManager) {
+    std::string name;
+    std::cout << "Назва (Tab або * в кінці — підказки): ";
+    std::getline(std::cin, name);
+
+    bool wantSuggestions = !name.empty() && (name.back() == '\t' || name.back() == '*');
+    if (wantSuggestions) name.pop_back();
+
+    auto t = wantSuggestions ? nullptr : termManager.FindByName(name);
+    if (!t) {
+        std::vector<std::string> names;
+        if (!wantSuggestions) names = termManager.SuggestNames(name, TermManager::kDefaultCompletions);
+        for (auto &completion : termManager.CompleteName(name, TermManager::kDefaultCompletions)) {
+            if (names.size() == TermManager::kDefaultCompletions) break;
+            if (std::find(names.begin(), names.end(), completion) == names.end()) {
+                names.push_back(std::move(completion));
+            }
+        }
+        if (names.empty()) {
+            std::cout << "Не знайдено.\n";
+            return;
+        }
+
+        std::cout << (wantSuggestions ? "Підказки:\n" : "Не знайдено. Можливо, ви мали на увазі:\n");
+        for (size_t i = 0; i < names.size(); ++i) {
+            std::cout << "  " << (i + 1) << ". " << names[i] << "\n";
+        }
+        std::cout << "Номер (Enter — назад): ";
+
+        std::string line;
+        std::getline(std::cin, line);
+        size_t pick = std::strtoul(line.c_str(), nullptr, 10);
+        if (pick == 0 || pick > names.size()) return;
+        t = termManager.FindByName(names[pick - 1]);
+        if (!t) return;
+        std::cout << t->GetName() << ": ";
+    }
+    std::cout << t->GetDefinition() << "\n";
+}
+
 /**
  * @brief Інтерфейс додавання нового терміна.
  *
@@ -262,7 +435,7 @@ void HandleAddTerm(TermManager &termManager) {
 
     if (t == 1) {
         termManager.AddTerm(std::make_shared<PrimitiveTerm>(name, def));
-        termManager.Save();
+        termManager.ScheduleSave();
         std::cout << "Додано первинний термін.\n";
     }
     else if (t == 2) {
@@ -280,17 +453,89 @@ void HandleAddTerm(TermManager &termManager) {
         }
 
         termManager.AddTerm(std::make_shared<Term>(name, def, refs));
-        termManager.Save();
+        termManager.ScheduleSave();
         std::cout << "Додано складний термін.\n";
     }
 
     Pause();
 }
 
+// ----------------------------------------------------------
+// СТАТИСТИКА ОПЕРАЦІЙ
+// ----------------------------------------------------------
+
+/**
+ * @brief Показує лічильники операцій і за бажанням записує їх у файл.
+ *
+ * Лічильники збираються з усіх потоків (див. Metrics), тож сюди
+ * потрапляють і фонові збереження.
+ */
+void HandleMetrics() {
+    Banner("СТАТИСТИКА ОПЕРАЦІЙ");
+    std::cout << Metrics::Describe(Metrics::Collect());
+
+    std::string path;
+    std::cout << "\nФайл для запису (*.json або Prometheus, Enter — не записувати): ";
+    std::getline(std::cin, path);
+    path = Utils::Trim(path);
+    if (path.empty()) return;
+
+    std::string error;
+    if (Metrics::Dump(path, error)) {
+        std::cout << "Записано у " << path << ".\n";
+    } else {
+        std::cout << "Не вдалося записати: " << error << "\n";
+    }
+}
+
+/**
+ * @struct MetricsDumpOnExit
+ * @brief Записує статистику операцій у файл при виході з main (KURSOVA_METRICS).
+ *
+ * Створюється раніше за менеджери, тож враховує й збереження з їхніх деструкторів.
+ */
+struct MetricsDumpOnExit {
+    /** @brief Шлях до файлу (nullptr — не записувати). */
+    const char *path;
+
+    /**
+     * @brief Записує файл, якщо шлях задано.
+     */
+    ~MetricsDumpOnExit() {
+        if (!path || !*path) return;
+        std::string error;
+        if (!Metrics::Dump(path, error)) {
+            std::cerr << "[ERROR] Не вдалося записати статистику операцій: " << error << std::endl;
+        }
+    }
+};
+
 // ----------------------------------------------------------
 // ГОЛОВНЕ МЕНЮ
 // ----------------------------------------------------------
 
+/**
+ * @brief Права, потрібні для пункту головного меню.
+ *
+ * Кожна операція оголошує своє право тут, а не перевіряє роль сама.
+ * @param choice Номер пункту меню.
+ * @return Маска потрібних прав (0 — доступно всім).
+ */
+uint32_t RequiredPermission(int choice) {
+    switch (choice) {
+        case 1: case 2: case 3: case 4:
+        case 10: case 11: case 12: case 14: case 15: case 16:
+            return PermViewTerms;
+        case 5:  return PermAddTerm;
+        case 6:  return PermEditTerm;
+        case 7:  return PermRemoveTerm;
+        case 8: case 9:
+            return PermSortTerms;
+        case 20: return PermViewUsers;
+        default: return 0;
+    }
+}
+
 /**
  * @brief Відображає головне меню програми після авторизації.
  *
@@ -316,9 +561,11 @@ void ShowMainMenu(const User &currentUser, TermManager &termManager, UserManager
             << "11. Складні терміни\n"
             << "12. Ланцюжок терміна\n"
             << "13. Допомога\n"
-            << "14. Статистика\n";
+            << "14. Статистика\n"
+            << "15. Запит (name:, def:, text:, type:, refs:, AND/OR/NOT)\n"
+            << "16. Статистика операцій\n";
 
-        if (currentUser.GetRole() == "admin")
+        if (currentUser.HasPermission(PermViewUsers))
             std::cout << "20. Керування користувачами\n";
 
         std::cout << "0. Вихід\n"
@@ -335,6 +582,13 @@ void ShowMainMenu(const User &currentUser, TermManager &termManager, UserManager
 
         if (choice == 0) return;
 
+        // Перевірка прав — один побітовий AND із заздалегідь скомпільованою маскою
+        if (!currentUser.HasPermission(RequiredPermission(choice))) {
+            std::cout << "Недостатньо прав.\n";
+            Pause();
+            continue;
+        }
+
         switch (choice) {
             case 1:
                 termManager.PrintAllShort();
@@ -346,16 +600,10 @@ void ShowMainMenu(const User &currentUser, TermManager &termManager, UserManager
                 Pause();
                 break;
 
-            case 3: {
-                std::string name;
-                std::cout << "Назва: ";
-                std::getline(std::cin, name);
-                auto t = termManager.FindByName(name);
-                if (!t) std::cout << "Не знайдено.\n";
-                else std::cout << t->GetDefinition() << "\n";
+            case 3:
+                HandleFindByName(termManager);
                 Pause();
                 break;
-            }
 
             case 4: {
                 std::string s;
@@ -367,19 +615,10 @@ void ShowMainMenu(const User &currentUser, TermManager &termManager, UserManager
             }
 
             case 5:
-                if (currentUser.GetRole() != "admin") {
-                    std::cout << "Недостатньо прав.\n";
-                    Pause();
-                } else HandleAddTerm(termManager);
+                HandleAddTerm(termManager);
                 break;
 
             case 6: {
-                if (currentUser.GetRole() != "admin") {
-                    std::cout << "Недостатньо прав.\n";
-                    Pause();
-                    break;
-                }
-
                 std::string name, def;
                 std::cout << "Назва: ";
                 std::getline(std::cin, name);
@@ -387,7 +626,7 @@ void ShowMainMenu(const User &currentUser, TermManager &termManager, UserManager
                 std::getline(std::cin, def);
 
                 if (termManager.EditDefinition(name, def)) {
-                    termManager.Save();
+                    termManager.ScheduleSave();
                     std::cout << "Оновлено.\n";
                 } else std::cout << "Не знайдено.\n";
 
@@ -396,18 +635,12 @@ void ShowMainMenu(const User &currentUser, TermManager &termManager, UserManager
             }
 
             case 7: {
-                if (currentUser.GetRole() != "admin") {
-                    std::cout << "Недостатньо прав.\n";
-                    Pause();
-                    break;
-                }
-
                 std::string name;
                 std::cout << "Назва: ";
                 std::getline(std::cin, name);
 
                 if (termManager.RemoveTerm(name)) {
-                    termManager.Save();
+                    termManager.ScheduleSave();
                     std::cout << "Видалено.\n";
                 } else std::cout << "Не знайдено.\n";
 
@@ -416,27 +649,17 @@ void ShowMainMenu(const User &currentUser, TermManager &termManager, UserManager
             }
 
             case 8:
-                if (currentUser.GetRole() != "admin") {
-                    std::cout << "Недостатньо прав.\n";
-                    Pause();
-                } else {
-                    termManager.SortByName();
-                    termManager.Save();
-                    std::cout << "Відсортовано.\n";
-                    Pause();
-                }
+                termManager.SortByName();
+                termManager.ScheduleSave();
+                std::cout << "Відсортовано.\n";
+                Pause();
                 break;
 
             case 9:
-                if (currentUser.GetRole() != "admin") {
-                    std::cout << "Недостатньо прав.\n";
-                    Pause();
-                } else {
-                    termManager.SortByDefinition();
-                    termManager.Save();
-                    std::cout << "Відсортовано.\n";
-                    Pause();
-                }
+                termManager.SortByDefinition();
+                termManager.ScheduleSave();
+                std::cout << "Відсортовано.\n";
+                Pause();
                 break;
 
             case 10:
@@ -467,13 +690,22 @@ void ShowMainMenu(const User &currentUser, TermManager &termManager, UserManager
                 Pause();
                 break;
 
+            case 15: {
+                std::string query;
+                std::cout << "Запит (\"explain ...\" — показати план): ";
+                std::getline(std::cin, query);
+                termManager.PrintQuery(query);
+                Pause();
+                break;
+            }
+
+            case 16:
+                HandleMetrics();
+                Pause();
+                break;
+
             case 20:
-                if (currentUser.GetRole() == "admin")
-                    HandleAdminUserMenu(userManager);
-                else {
-                    std::cout << "Недостатньо прав.\n";
-                    Pause();
-                }
+                HandleAdminUserMenu(currentUser, userManager);
                 break;
 
             default:
@@ -484,6 +716,444 @@ void ShowMainMenu(const User &currentUser, TermManager &termManager, UserManager
     }
 }
 
+// ----------------------------------------------------------
+// ПАКЕТНИЙ РЕЖИМ
+// ----------------------------------------------------------
+
+/**
+ * @brief Підбирає вартість хешування паролів і завантажує користувачів.
+ *
+ * Калібрування йде до Load, тож відкриті паролі зі старого users.txt
+ * хешуються вже з підібраною вартістю, а не з kDefaultIterations.
+ * @param userManager Менеджер користувачів.
+ */
+void LoadUsers(UserManager &userManager) {
+    // Підбір вартості хешування паролів під ~50 мс на перевірку
+    userManager.CalibrateCost(50.0);
+    userManager.Load();
+    userManager.EnsureDefaultAdmin(); // Створення адміна, якщо база порожня
+}
+
+/**
+ * @brief Виконує скрипт команд без інтерактивного меню.
+ *
+ * Результати йдуть у stdout, а вся службова інформація менеджерів
+ * ([INFO], [DEBUG] тощо) перенаправляється в stderr, щоб вивід
+ * залишався машинно-читабельним. Облікові дані можна передати
+ * через змінні середовища KURSOVA_USER / KURSOVA_PASSWORD
+ * або командою login у самому скрипті.
+ *
+ * @param scriptPath Шлях до скрипта або "-" для stdin.
+ * @param termManager Менеджер термінів.
+ * @param userManager Менеджер користувачів.
+ * @return Код завершення: 0 — успіх, 1 — були помилки, 2 — скрипт не відкрито.
+ */
+int RunBatch(const std::string &scriptPath, TermManager &termManager, UserManager &userManager) {
+    std::ostream results(std::cout.rdbuf());
+    std::cout.rdbuf(std::cerr.rdbuf());
+
+    LoadUsers(userManager);
+    termManager.Load();
+
+    BatchRunner runner(termManager, userManager);
+
+    const char *envUser = std::getenv("KURSOVA_USER");
+    const char *envPassword = std::getenv("KURSOVA_PASSWORD");
+    if (envUser && envPassword && !runner.Login(envUser, envPassword)) {
+        std::cerr << "[ERROR] Невірний логін або пароль у KURSOVA_USER/KURSOVA_PASSWORD." << std::endl;
+    }
+
+    size_t failures;
+    if (scriptPath == "-") {
+        failures = runner.Run(std::cin, results);
+    } else {
+        std::ifstream script(scriptPath);
+        if (!script.is_open()) {
+            std::cerr << "[ERROR] Не вдалося відкрити скрипт: " << scriptPath << std::endl;
+            return 2;
+        }
+        failures = runner.Run(script, results);
+    }
+
+    AtomicFile::Stats save = termManager.GetLastSave();
+    if (save.bytes > 0) {
+        std::cerr << "[INFO] Збереження бази: " << save.Describe() << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// СЕРВЕР ЗАПИТІВ
+// ----------------------------------------------------------
+
+/** @brief Сервер, який зупиняють SIGINT/SIGTERM. */
+static SocketServer *activeServer = nullptr;
+
+/**
+ * @brief Обробник сигналів завершення: будить цикл сервера.
+ */
+extern "C" void StopServerOnSignal(int) {
+    if (activeServer) activeServer->Stop();
+}
+
+/**
+ * @brief Завантажує базу один раз і обслуговує запити сервером.
+ *
+ * Зупинка — SIGINT або SIGTERM (у тому числі під час завантаження).
+ * @param server Сервер запитів (Unix-сокет або HTTP).
+ * @param termManager Менеджер термінів.
+ * @return Код завершення: 0 — штатна зупинка, 1 — сервер не запустився.
+ */
+int RunServer(SocketServer &server, TermManager &termManager) {
+    activeServer = &server;
+    std::signal(SIGINT, StopServerOnSignal);
+    std::signal(SIGTERM, StopServerOnSignal);
+
+    termManager.Load();
+    bool ok = server.Run();
+
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    activeServer = nullptr;
+    return ok ? 0 : 1;
+}
+
+/**
+ * @brief Запускає генератор навантаження проти сервера запитів.
+ * @param argc Кількість аргументів.
+ * @param argv Аргументи: --load <сокет>|--load-http <порт> [з'єднань] [запитів] [глибина].
+ * @param http Чи навантажувати HTTP API.
+ * @return Код завершення: 0 — успіх, 1 — помилка.
+ */
+int RunLoad(int argc, char *argv[], bool http) {
+    LoadClient::Options options;
+    options.http = http;
+    if (argc >= 4) options.connections = std::strtoul(argv[3], nullptr, 10);
+    if (argc >= 5) options.requests = std::strtoul(argv[4], nullptr, 10);
+    if (argc >= 6) options.depth = std::strtoul(argv[5], nullptr, 10);
+
+    LoadClient client(argv[2], TermsPath());
+    return client.Run(options) ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// БАЗА З ШАРДІВ
+// ----------------------------------------------------------
+
+/**
+ * @brief Переносить terms.csv у каталог шардів terms.d.
+ *
+ * Після успіху програма працює з terms.d (див. TermsPath), а terms.csv
+ * лишається як резервна копія.
+ * @param argc Кількість аргументів.
+ * @param argv Аргументи: --shard [шардів].
+ * @return Код завершення: 0 — успіх, 1 — помилка.
+ */
+int RunShard(int argc, char *argv[]) {
+    size_t shards = argc >= 3 ? std::strtoul(argv[2], nullptr, 10) : ShardStore::kDefaultShards;
+    if (shards == 0 || shards > 4096) {
+        std::cerr << "[ERROR] Некоректна кількість шардів: " << argv[2] << std::endl;
+        return 1;
+    }
+    if (ShardStore::IsDirectory(kTermsDirectory)) {
+        std::cerr << "[ERROR] Каталог " << kTermsDirectory << " уже існує." << std::endl;
+        return 1;
+    }
+
+    std::ostream report(std::cout.rdbuf());
+    std::cout.rdbuf(std::cerr.rdbuf());
+
+    TermManager source(kTermsFile);
+    source.Load();
+    if (!source.ExportShards(kTermsDirectory, shards)) return 1;
+
+    report << "Термінів: " << source.Snapshot()->Size() << ", шардів: " << shards
+           << " у " << kTermsDirectory << " (" << source.GetLastSave().Describe() << ")\n";
+    return 0;
+}
+
+// ----------------------------------------------------------
+// ПОРІВНЯННЯ ВВОДУ-ВИВОДУ
+// ----------------------------------------------------------
+
+/**
+ * @brief Читає файл цілком (для порівняння результатів).
+ */
+static std::string ReadWholeFile(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+/**
+ * @brief Порівнює POSIX та io_uring на завантаженні й збереженні бази.
+ *
+ * Для кожного способу база кілька разів завантажується з файлу і
+ * експортується в "<файл>.iobench.<спосіб>"; друкується найкращий і
+ * середній час. Наприкінці перевіряється, що обидва способи записали
+ * однакові байти. Вихідний файл не змінюється.
+ * @param argc Кількість аргументів.
+ * @param argv Аргументи: --io-bench [файл] [повторів].
+ * @return Код завершення: 0 — успіх, 1 — помилка запису або розбіжність.
+ */
+int RunIoBench(int argc, char *argv[]) {
+    std::string source = argc >= 3 ? argv[2] : "terms.csv";
+    unsigned long repeats = argc >= 4 ? std::strtoul(argv[3], nullptr, 10) : 5;
+    if (repeats == 0) repeats = 1;
+
+    std::ostream report(std::cout.rdbuf());
+    std::cout.rdbuf(std::cerr.rdbuf());
+
+    std::vector<IoBackend> backends{IoBackend::Posix};
+    if (IoRing::Supported()) {
+        backends.push_back(IoBackend::Uring);
+    } else {
+        std::cerr << "[WARN] io_uring недоступний, вимірюється лише POSIX." << std::endl;
+    }
+
+    report << std::fixed << std::setprecision(1)
+           << "Файл: " << source << ", повторів: " << repeats << "\n"
+           // setw рахує байти, а не літери, тому заголовок вирівняно вручну
+           << "Спосіб        Load min     Load сер.     Запис min    Запис сер.        МБ/с\n";
+
+    int code = 0;
+    std::vector<std::string> outputs;
+    for (IoBackend backend : backends) {
+        bool uring = backend == IoBackend::Uring;
+        std::string target = source + ".iobench." + (uring ? "uring" : "posix");
+        outputs.push_back(target);
+
+        TermManager manager(source);
+        manager.SetIoBackend(backend);
+
+        double loadMin = 0, loadSum = 0, writeMin = 0, writeSum = 0, throughput = 0;
+        for (unsigned long i = 0; i < repeats; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            manager.Load();
+            double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            if (!manager.Export(target)) {
+                code = 1;
+                break;
+            }
+            AtomicFile::Stats save = manager.GetLastSave();
+            double writeMs = save.writeMs + save.fileSyncMs + save.renameMs;
+
+            loadMin = i == 0 ? loadMs : std::min(loadMin, loadMs);
+            writeMin = i == 0 ? writeMs : std::min(writeMin, writeMs);
+            loadSum += loadMs;
+            writeSum += writeMs;
+            throughput = std::max(throughput, save.Throughput());
+        }
+
+        report << std::left << std::setw(8) << (uring ? "uring" : "posix") << std::right
+               << std::setw(11) << loadMin << " мс" << std::setw(11) << loadSum / repeats << " мс"
+               << std::setw(11) << writeMin << " мс" << std::setw(11) << writeSum / repeats << " мс"
+               << std::setw(12) << throughput << "\n";
+    }
+
+    if (code == 0 && outputs.size() == 2) {
+        bool same = ReadWholeFile(outputs[0]) == ReadWholeFile(outputs[1]);
+        report << "Результати POSIX та io_uring " << (same ? "однакові" : "РІЗНІ") << "\n";
+        if (!same) code = 1;
+    }
+    for (const auto &path : outputs) std::remove(path.c_str());
+    return code;
+}
+
+/**
+ * @brief Посимвольний Split без SIMD — еталон для --bench-split.
+ */
+static std::vector<std::string> ReferenceSplit(const std::string &s, char delim) {
+    std::vector<std::string> result(1);
+    for (size_t i = 0; i < s.size(); ++i) {
+        if (s[i] == '\\') {
+            result.back().push_back('\\');
+            if (i + 1 < s.size()) result.back().push_back(s[++i]);
+        } else if (s[i] == delim) {
+            result.emplace_back();
+        } else {
+            result.back().push_back(s[i]);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Посимвольний пошук неекранованого роздільника — еталон для --bench-split.
+ */
+static size_t ReferenceFindUnescaped(const std::string &s, char delim) {
+    for (size_t i = 0; i < s.size(); ++i) {
+        if (s[i] == '\\') ++i;
+        else if (s[i] == delim) return i;
+    }
+    return s.size();
+}
+
+/**
+ * @brief Посимвольний Unescape без SIMD — еталон для --bench-split.
+ */
+static std::string ReferenceUnescape(const std::string &s) {
+    std::string out;
+    for (size_t i = 0; i < s.size(); ++i) {
+        if (s[i] != '\\') out.push_back(s[i]);
+        else if (i + 1 < s.size()) out.push_back(s[++i]);
+    }
+    return out;
+}
+
+/**
+ * @brief Випадковий рядок, густо насичений роздільниками, слешами і байтами UTF-8.
+ *
+ * Довжини до 1000 байтів, щоб потрапляти і в векторний цикл, і в хвости Simd::FindEither.
+ */
+static std::string RandomCsvText(std::mt19937 &random) {
+    static const char kSpecial[] = {';', ',', '\\', ' ', 'a', 'z'};
+    std::uniform_int_distribution<int> pick(0, 99);
+    size_t length = pick(random) < 80 ? static_cast<size_t>(pick(random)) : static_cast<size_t>(pick(random)) * 10;
+    std::string text;
+    for (size_t i = 0; i < length; ++i) {
+        int roll = pick(random);
+        if (roll < 30) text.push_back(kSpecial[roll % sizeof(kSpecial)]);
+        else if (roll < 50) text.push_back(static_cast<char>(0x80 + pick(random)));
+        else text.push_back(static_cast<char>('a' + roll % 26));
+    }
+    return text;
+}
+
+/**
+ * @brief Час одного проходу fn по всіх рядках, найкращий з repeats, у мс.
+ */
+template <typename Fn>
+static double BestPassMs(const std::vector<std::string> &lines, unsigned long repeats, Fn fn) {
+    double best = 0;
+    for (unsigned long r = 0; r < repeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        for (const auto &line : lines) fn(line);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        best = r == 0 ? ms : std::min(best, ms);
+    }
+    return best;
+}
+
+/**
+ * @brief Перевіряє Utils::Split, FindUnescaped і Unescape на випадкових рядках і міряє їх швидкість.
+ *
+ * Спершу кожна функція порівнюється з посимвольним еталоном на випадкових
+ * рядках (а Unescape(Escape(x)) — з x), потім вимірюється пропускна
+ * здатність на рядках у форматі terms.csv проти того самого еталона.
+ * @param argc Кількість аргументів.
+ * @param argv Аргументи: --bench-split [рядків] [повторів] [зерно].
+ * @return Код завершення: 0 — успіх, 1 — знайдено розбіжність.
+ */
+int RunSplitBench(int argc, char *argv[]) {
+    unsigned long count = argc >= 3 ? std::strtoul(argv[2], nullptr, 10) : 200000;
+    unsigned long repeats = argc >= 4 ? std::strtoul(argv[3], nullptr, 10) : 5;
+    unsigned long seed = argc >= 5 ? std::strtoul(argv[4], nullptr, 10) : 1;
+    if (count == 0) count = 1;
+    if (repeats == 0) repeats = 1;
+
+    std::mt19937 random(static_cast<std::mt19937::result_type>(seed));
+    size_t mismatches = 0;
+    for (unsigned long i = 0; i < count; ++i) {
+        std::string text = RandomCsvText(random);
+        const char *failed = nullptr;
+        if (Utils::Split(text, ';') != ReferenceSplit(text, ';')) failed = "Split";
+        else if (Utils::FindUnescaped(text.data(), text.size(), ',') != ReferenceFindUnescaped(text, ','))
+            failed = "FindUnescaped";
+        else if (Utils::Unescape(text) != ReferenceUnescape(text)) failed = "Unescape";
+        else if (Utils::Unescape(Utils::Escape(text)) != text) failed = "Escape/Unescape";
+        if (!failed) continue;
+        if (++mismatches <= 5) {
+            std::cout << "РОЗБІЖНІСТЬ " << failed << " на рядку " << i << ", hex: "
+                      << Crypto::ToHex(reinterpret_cast<const uint8_t *>(text.data()), text.size()) << "\n";
+        }
+    }
+    std::cout << "Випадкових рядків: " << count << " (зерно " << seed << "), розбіжностей: " << mismatches << "\n";
+
+    std::vector<std::string> lines;
+    lines.reserve(count);
+    size_t bytes = 0;
+    for (unsigned long i = 0; i < count; ++i) {
+        std::string definition = "Визначення терміна " + std::to_string(i) + ": опис; з крапкою з комою, комою";
+        if (i % 7 == 0) definition += " і слешем \\ у тексті";
+        lines.push_back("TERM;Термін" + std::to_string(i) + ";" + Utils::Escape(definition) +
+                        ";Клас,Об\\,єкт,Метод" + std::to_string(i % 100));
+        bytes += lines.back().size();
+    }
+
+    size_t sink = 0;
+    struct Row {
+        const char *name;
+        double fastMs;
+        double referenceMs;
+    };
+    const Row rows[] = {
+            {"Split",
+             BestPassMs(lines, repeats, [&](const std::string &l) { sink += Utils::Split(l, ';').size(); }),
+             BestPassMs(lines, repeats, [&](const std::string &l) { sink += ReferenceSplit(l, ';').size(); })},
+            {"FindUnescaped",
+             BestPassMs(lines, repeats, [&](const std::string &l) { sink += Utils::FindUnescaped(l.data(), l.size(), ','); }),
+             BestPassMs(lines, repeats, [&](const std::string &l) { sink += ReferenceFindUnescaped(l, ','); })},
+            {"Unescape",
+             BestPassMs(lines, repeats, [&](const std::string &l) { sink += Utils::Unescape(l).size(); }),
+             BestPassMs(lines, repeats, [&](const std::string &l) { sink += ReferenceUnescape(l).size(); })},
+    };
+
+    const double megabytes = static_cast<double>(bytes) / 1e6;
+    std::cout << std::fixed << std::setprecision(1)
+              << "Рядків terms.csv: " << count << " (" << megabytes << " МБ), повторів: " << repeats
+              << ", ядро: " << Simd::ActiveIsa() << "\n"
+              // setw рахує байти, а не літери, тому заголовок вирівняно вручну
+              << "Функція         Utils, МБ/с  Еталон, МБ/с  Прискорення\n";
+    for (const auto &row : rows) {
+        std::cout << std::left << std::setw(14) << row.name << std::right
+                  << std::setw(13) << megabytes / (row.fastMs / 1e3)
+                  << std::setw(14) << megabytes / (row.referenceMs / 1e3)
+                  << std::setw(12) << row.referenceMs / row.fastMs << "x\n";
+    }
+    // Сума не дає компілятору викинути виміряні виклики
+    if (sink == 0) std::cout << "\n";
+    return mismatches == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Скільки входів за секунду дає кожна вартість хешування паролів.
+ *
+ * Спершу вартість калібрується, як під час звичайного запуску (~50 мс на
+ * перевірку), потім для кількох кількостей ітерацій PBKDF2 разом з
+ * підібраною вимірюється швидкість перевірок на одному потоці та на всіх
+ * ядрах. Файл користувачів не змінюється.
+ * @param argc Кількість аргументів.
+ * @param argv Аргументи: --bench-login [мс на вимір].
+ * @param userManager Менеджер, чия вартість калібрується.
+ * @return Код завершення (0 — успіх).
+ */
+int RunLoginBench(int argc, char *argv[], UserManager &userManager) {
+    unsigned long millis = argc >= 3 ? std::strtoul(argv[2], nullptr, 10) : 500;
+    if (millis == 0) millis = 1;
+    const auto duration = std::chrono::milliseconds(millis);
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+
+    uint32_t calibrated = userManager.CalibrateCost(50.0);
+    std::vector<uint32_t> sweep{UserManager::kMinIterations, 25000, 50000, 100000, 200000, calibrated};
+    std::sort(sweep.begin(), sweep.end());
+    sweep.erase(std::unique(sweep.begin(), sweep.end()), sweep.end());
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "Ядер: " << cores << ", вимір: " << millis << " мс на точку, * — підібрано калібруванням\n"
+              // setw рахує байти, а не літери, тому заголовок вирівняно вручну
+              << "Ітерацій    мс/вхід   Входів/с (1 потік)   Входів/с (усі ядра)\n";
+    for (uint32_t iterations : sweep) {
+        double single = UserManager::MeasureLoginRate(iterations, 1, duration);
+        double all = cores > 1 ? UserManager::MeasureLoginRate(iterations, cores, duration) : single;
+        std::cout << std::setw(8) << iterations << (iterations == calibrated ? "*" : " ")
+                  << std::setw(11) << (single > 0 ? 1000.0 / single : 0.0)
+                  << std::setw(21) << single
+                  << std::setw(22) << all << "\n";
+    }
+    return 0;
+}
+
 // ----------------------------------------------------------
 // ГОЛОВНИЙ ВХІД
 // ----------------------------------------------------------
@@ -493,21 +1163,96 @@ void ShowMainMenu(const User &currentUser, TermManager &termManager, UserManager
  *
  * Ініціалізує менеджери, налаштовує консоль (Windows CP65001),
  * завантажує дані та запускає цикл авторизації.
+ * З аргументом "--batch <файл|->" виконує скрипт команд (див. BatchRunner),
+ * з "--serve <сокет>" запускає сервер запитів, з "--http <порт>" — JSON API,
+ * з "--load <сокет> ..." або "--load-http <порт> ..." — генератор навантаження,
+ * з "--io-bench [файл] [повторів]" — порівняння POSIX та io_uring,
+ * з "--bench-split [рядків] [повторів] [зерно]" — перевірка і швидкість Utils::Split/Unescape,
+ * з "--bench-login [мс на вимір]" — входів за секунду для різної вартості хешування паролів,
+ * з "--shard [шардів]" — перенесення terms.csv у каталог шардів.
+ * Якщо каталог terms.d існує, база читається і зберігається в ньому.
+ * Змінна середовища KURSOVA_IO=uring вмикає io_uring для файлу бази.
+ * KURSOVA_LAZY=1 вмикає відкладене читання визначень, KURSOVA_MEMORY_MB=N —
+ * ще й бюджет пам'яті під них, KURSOVA_COMPRESS=1 — стиснення визначень у пам'яті.
+ * KURSOVA_METRICS=<файл> — запис статистики операцій при завершенні.
  * @return Код завершення (0 - успіх).
  */
-int main() {
+int main(int argc, char *argv[]) {
     // Встановлення кодування UTF-8 для коректного відображення кирилиці (Windows)
 #ifdef _WIN32
     SetConsoleOutputCP(65001);
     SetConsoleCP(65001);
 #endif
 
+    MetricsDumpOnExit metricsDump{std::getenv("KURSOVA_METRICS")};
     UserManager userManager("users.txt");
-    TermManager termManager("terms.csv");
+    TermManager termManager(TermsPath());
+
+    const char *envIo = std::getenv("KURSOVA_IO");
+    if (envIo && std::strcmp(envIo, "uring") == 0) {
+        if (IoRing::Supported()) {
+            termManager.SetIoBackend(IoBackend::Uring);
+        } else {
+            std::cerr << "[WARN] io_uring недоступний, використовується POSIX." << std::endl;
+        }
+    }
+
+    const char *envLazy = std::getenv("KURSOVA_LAZY");
+    if (envLazy && std::strcmp(envLazy, "1") == 0) termManager.SetLazyDefinitions(true);
+    const char *envMemory = std::getenv("KURSOVA_MEMORY_MB");
+    if (envMemory) {
+        unsigned long megabytes = std::strtoul(envMemory, nullptr, 10);
+        if (megabytes == 0) {
+            std::cerr << "[WARN] Некоректний KURSOVA_MEMORY_MB: " << envMemory << std::endl;
+        } else {
+            termManager.SetLazyDefinitions(true);
+            termManager.SetMemoryBudget(static_cast<size_t>(megabytes) * 1000000);
+        }
+    }
+    const char *envCompress = std::getenv("KURSOVA_COMPRESS");
+    if (envCompress && std::strcmp(envCompress, "1") == 0) {
+        termManager.SetCompressedDefinitions(true);
+        // Розкодовані копії з GetDefinition теж займають пам'ять: без бюджету вони б накопичувались
+        if (termManager.GetMemoryBudget() == 0) termManager.SetMemoryBudget(4 * 1000000);
+    }
+
+    if (argc >= 2 && std::strcmp(argv[1], "--shard") == 0) {
+        return RunShard(argc, argv);
+    }
+    if (argc >= 2 && std::strcmp(argv[1], "--io-bench") == 0) {
+        return RunIoBench(argc, argv);
+    }
+    if (argc >= 2 && std::strcmp(argv[1], "--bench-split") == 0) {
+        return RunSplitBench(argc, argv);
+    }
+    if (argc >= 2 && std::strcmp(argv[1], "--bench-login") == 0) {
+        return RunLoginBench(argc, argv, userManager);
+    }
+    if (argc >= 2 && std::strcmp(argv[1], "--batch") == 0) {
+        return RunBatch(argc >= 3 ? argv[2] : "-", termManager, userManager);
+    }
+    if (argc >= 3 && std::strcmp(argv[1], "--serve") == 0) {
+        QueryServer server(termManager, argv[2]);
+        return RunServer(server, termManager);
+    }
+    if (argc >= 3 && std::strcmp(argv[1], "--http") == 0) {
+        unsigned long port = std::strtoul(argv[2], nullptr, 10);
+        if (port == 0 || port > 65535) {
+            std::cerr << "[ERROR] Некоректний порт: " << argv[2] << std::endl;
+            return 1;
+        }
+        HttpServer server(termManager, static_cast<uint16_t>(port));
+        return RunServer(server, termManager);
+    }
+    if (argc >= 3 && std::strcmp(argv[1], "--load") == 0) {
+        return RunLoad(argc, argv, false);
+    }
+    if (argc >= 3 && std::strcmp(argv[1], "--load-http") == 0) {
+        return RunLoad(argc, argv, true);
+    }
 
     // Завантаження даних з файлів
-    userManager.Load();
-    userManager.EnsureDefaultAdmin(); // Створення адміна, якщо база порожня
+    LoadUsers(userManager);
     termManager.Load();
 
     while (true) {
@@ -587,7 +1332,10 @@ int main() {
 
                 // Зберігаємо зміни при виході з головного меню
                 userManager.Save();
-                termManager.Save();
+                if (!termManager.Flush()) {
+                    std::cerr << "[ERROR] Зміни бази термінів не збережено." << std::endl;
+                    return 1;
+                }
                 return 0;
             } else {
                 std::cout << "Невірний логін або пароль.\n";